@@ -0,0 +1,38 @@
+# Writes a header defining APP_BUILD_ID, which changes whenever the sources being built do.
+# Run on every build by the build_id target in CMakeLists.txt, expects SOURCE_DIR and OUTPUT.
+# The header is only rewritten when the id changes, so an unchanged tree rebuilds nothing.
+
+execute_process(COMMAND git rev-parse HEAD
+                WORKING_DIRECTORY ${SOURCE_DIR}
+                RESULT_VARIABLE GIT_RESULT
+                OUTPUT_VARIABLE GIT_REVISION
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET)
+
+if(GIT_RESULT EQUAL 0)
+    # Uncommitted and untracked changes count as well
+    execute_process(COMMAND git diff HEAD
+                    WORKING_DIRECTORY ${SOURCE_DIR}
+                    OUTPUT_VARIABLE GIT_CHANGES
+                    ERROR_QUIET)
+    execute_process(COMMAND git status --porcelain
+                    WORKING_DIRECTORY ${SOURCE_DIR}
+                    OUTPUT_VARIABLE GIT_STATUS
+                    ERROR_QUIET)
+    string(SHA1 CHANGES_HASH "${GIT_CHANGES}${GIT_STATUS}")
+    set(BUILD_ID "${GIT_REVISION}-${CHANGES_HASH}")
+else()
+    # Not a checkout, so every build counts as a new one
+    string(TIMESTAMP BUILD_ID "%Y-%m-%dT%H:%M:%S" UTC)
+endif()
+
+set(CONTENT "// Generated by contrib/build_id.cmake, do not edit\n#define APP_BUILD_ID \"${BUILD_ID}\"\n")
+
+set(PREVIOUS "")
+if(EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} PREVIOUS)
+endif()
+
+if(NOT PREVIOUS STREQUAL CONTENT)
+    file(WRITE ${OUTPUT} "${CONTENT}")
+endif()
@@ -45,6 +45,7 @@
                     pkgs.libGL
                     pkgs.qt5.qtbase
                     pkgs.qt5.qtcharts
+                    pkgs.qt5.qtserialport
 
                     pkgs.assimp
                     pkgs.boost172
@@ -0,0 +1,101 @@
+#ifndef TOOLPATHEXPORTER_H
+#define TOOLPATHEXPORTER_H
+
+// Qt
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QSharedPointer>
+
+// Local
+#include "external_files/toolpath_format.h"
+
+namespace ORNL
+{
+    class GlobalLayer;
+    class Path;
+    class SegmentBase;
+    class SettingsBase;
+
+    /*!
+     * \class ToolpathExporter
+     * \brief Writes toolpaths to the columnar binary toolpath format (see toolpath_format.h).
+     *
+     * Segments are gathered into one array per column and written a chunk at a
+     * time, so a job is written with a handful of large writes rather than one
+     * formatted write per value. Segment settings are only looked up again when
+     * a segment does not share its settings base with the previous one.
+     */
+    class ToolpathExporter
+    {
+        public:
+            //! \brief Constructor
+            //! \param filename: file to write
+            //! \param compress: whether chunks are stored with zlib compression
+            //! \param chunk_size: number of segments per chunk
+            ToolpathExporter(QString filename, bool compress = false, int chunk_size = ToolpathFormat::kDefaultChunkSize);
+
+            //! \brief Destructor. Closes the file if it is still open.
+            ~ToolpathExporter();
+
+            //! \brief Opens the file and writes the header
+            //! \return whether the file could be opened
+            bool open();
+
+            //! \brief Writes any buffered segments and closes the file
+            void close();
+
+            //! \brief Appends every segment of a global layer, in the order gcode is written
+            //! \param layer: layer to append
+            //! \param layer_index: index written to the layer column
+            void appendLayer(QSharedPointer<GlobalLayer> layer, int layer_index);
+
+            //! \brief Appends every segment of a path
+            //! \param path: path to append
+            //! \param layer_index: index written to the layer column
+            //! \param tool: index written to the tool column
+            void appendPath(Path& path, int layer_index, int tool);
+
+            //! \brief Appends a single segment
+            //! \param segment: segment to append
+            //! \param layer_index: index written to the layer column
+            //! \param tool: index written to the tool column
+            void appendSegment(const QSharedPointer<SegmentBase>& segment, int layer_index, int tool);
+
+            //! \brief Number of segments written so far
+            qint64 segmentCount() const;
+
+        private:
+            //! \brief Writes buffered segments as one chunk
+            void flushChunk();
+
+            //! \brief Writes a column array, compressed if requested
+            void writeColumn(const char* data, int bytes);
+
+            //! \brief Output file
+            QFile m_file;
+
+            //! \brief Chunk options
+            bool m_compress;
+            int m_chunk_size;
+
+            //! \brief Buffered columns of the current chunk
+            ToolpathColumns m_columns;
+
+            //! \brief Running time stamp in seconds
+            double m_time = 0.0;
+
+            //! \brief Segments written so far
+            qint64 m_segment_count = 0;
+
+            //! \brief Values read from the last settings base, reused while consecutive segments share it
+            SettingsBase* m_cached_sb = nullptr;
+            float m_cached_width = 0.0f;
+            float m_cached_height = 0.0f;
+            float m_cached_speed = 0.0f;
+            quint16 m_cached_region = 0;
+            float m_cached_normal[3] = {0.0f, 0.0f, 1.0f};
+    };
+}
+
+#endif // TOOLPATHEXPORTER_H
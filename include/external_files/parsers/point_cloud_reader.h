@@ -0,0 +1,60 @@
+#ifndef POINTCLOUDREADER_H
+#define POINTCLOUDREADER_H
+
+// Qt
+#include <QFile>
+#include <QString>
+
+// Local
+#include "geometry/point_cloud.h"
+#include "exceptions/exceptions.h"
+
+namespace ORNL
+{
+    /*!
+     * \class PointCloudReader
+     * \brief Reads scanned surfaces from .matrix and .xyz text files.
+     *
+     * The file is memory mapped when possible and cut into chunks at line
+     * breaks. Chunks are parsed in parallel and joined in file order, with
+     * scaling applied while parsing.
+     */
+    class PointCloudReader
+    {
+        public:
+            //! \brief Constructor
+            //! \param filename: file to read
+            PointCloudReader(QString filename);
+
+            //! \brief Reads a .matrix file: one row of comma separated heights per
+            //! line, sampled every 12 mm starting 5 mm from the origin. Empty or
+            //! unreadable entries are kept as missing samples and blank lines are
+            //! skipped.
+            //! \param scale: factor applied to every coordinate
+            //! \throws IOException if the file cannot be opened
+            HeightMap readMatrix(double scale = 1.0);
+
+            //! \brief Reads a .xyz file: whitespace separated x, y and z per line.
+            //! Further values on a line (such as normals), lines with fewer than
+            //! three values and lines starting with '#' are ignored.
+            //! \param scale: factor applied to every coordinate
+            //! \throws IOException if the file cannot be opened
+            PointCloud readXYZ(double scale = 1.0);
+
+        private:
+            //! \brief Maps or reads the whole file
+            //! \param contents: holds the file if it could not be mapped
+            //! \param size: set to the file size
+            //! \return pointer to the file contents
+            const char* load(QFile& file, QByteArray& contents, qint64& size);
+
+            //! \brief Splits the file into chunks that start at the beginning of a line
+            //! \return chunk boundaries, the last entry is size
+            static QVector<qint64> chunkBounds(const char* data, qint64 size);
+
+            //! \brief Filename
+            QString m_filename;
+    };
+}
+
+#endif // POINTCLOUDREADER_H
@@ -0,0 +1,50 @@
+#ifndef TOOLPATHREADER_H
+#define TOOLPATHREADER_H
+
+// Qt
+#include <QString>
+
+// Local
+#include "external_files/toolpath_format.h"
+#include "exceptions/exceptions.h"
+
+namespace ORNL
+{
+    /*!
+     * \class ToolpathReader
+     * \brief Reads files written by ToolpathExporter back into columns.
+     *
+     * The file is memory mapped when possible and each stored column is copied
+     * (or decompressed) straight into its array. Columns missing from the file
+     * are left filled with zeros, columns unknown to this reader are skipped.
+     */
+    class ToolpathReader
+    {
+        public:
+            //! \brief Constructor
+            //! \param filename: file to read
+            ToolpathReader(QString filename);
+
+            //! \brief Reads the whole file
+            //! \throws IOException if the file cannot be opened
+            //! \throws InvalidParseException if the file is not a valid toolpath file
+            //! \return per-segment columns
+            ToolpathColumns read();
+
+            //! \brief Format version of the last file read
+            quint16 version() const;
+
+            //! \brief Whether the last file read used chunk compression
+            bool isCompressed() const;
+
+        private:
+            //! \brief Name of file to read
+            QString m_filename;
+
+            //! \brief Header values of the last file read
+            quint16 m_version = 0;
+            quint16 m_flags = 0;
+    };
+}
+
+#endif // TOOLPATHREADER_H
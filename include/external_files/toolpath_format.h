@@ -0,0 +1,107 @@
+#ifndef TOOLPATHFORMAT_H
+#define TOOLPATHFORMAT_H
+
+// Qt
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+namespace ORNL
+{
+    /*!
+     * \brief Layout of the columnar binary toolpath format (*.s2tp).
+     *
+     * All values are little endian.
+     *
+     *  header: char[4] "S2TP", uint16 version, uint16 flags, uint32 column count,
+     *          then per column: uint8 type, uint8 name length, name
+     *  chunks: uint32 segment count, then per column in header order:
+     *          uint32 stored byte count, column bytes
+     *
+     * When kCompressed is set, each stored column is a qCompress block: the
+     * uncompressed size as a big endian uint32 followed by a zlib stream.
+     *
+     * Chunks follow the header until the end of the file. Positions, widths and
+     * heights are in microns, speeds in microns per second and time stamps are
+     * the cumulative time in seconds at the end of each segment. Readers locate
+     * columns by name and skip columns they do not know, so columns can be added
+     * without bumping the version.
+     */
+    namespace ToolpathFormat
+    {
+        static constexpr char kMagic[4] = {'S', '2', 'T', 'P'};
+        static constexpr quint16 kVersion = 1;
+        static constexpr int kDefaultChunkSize = 1 << 16;
+        static const QString kFileSuffix = ".s2tp";
+
+        //! \brief Header flags
+        enum Flags : quint16
+        {
+            kCompressed = 1 << 0
+        };
+
+        //! \brief Column element types
+        enum class ColumnType : quint8
+        {
+            kFloat32 = 0,
+            kFloat64 = 1,
+            kUInt8   = 2,
+            kUInt16  = 3,
+            kUInt32  = 4
+        };
+
+        //! \brief Size in bytes of a column element, or 0 for an unknown type
+        int elementSize(ColumnType type);
+
+        //! \brief Converts column elements between host and file byte order in place. Does nothing on little endian hosts.
+        //! \param data: column elements
+        //! \param count: number of elements
+        //! \param type: element type
+        void convertByteOrder(char* data, int count, ColumnType type);
+    }
+
+    /*!
+     * \struct ToolpathColumns
+     * \brief Per-segment toolpath data stored one array per column.
+     */
+    struct ToolpathColumns
+    {
+        QVector<float> start_x, start_y, start_z;
+        QVector<float> end_x, end_y, end_z;
+        QVector<float> width, height, speed;
+        QVector<quint16> region_type;
+        QVector<quint8> printing;
+        QVector<quint16> tool;
+        QVector<quint32> layer;
+        QVector<double> time;
+        QVector<float> normal_x, normal_y, normal_z;
+
+        //! \brief Description of a column for reading and writing
+        struct Column
+        {
+            const char* name;
+            ToolpathFormat::ColumnType type;
+        };
+
+        //! \brief Columns written by the current version, in file order
+        static const QVector<Column>& layout();
+
+        //! \brief Raw storage of a column in layout order
+        char* columnData(int column);
+        const char* columnData(int column) const;
+
+        //! \brief Resizes every column
+        void resize(int size);
+
+        //! \brief Reserves space in every column
+        void reserve(int size);
+
+        //! \brief Number of segments
+        int size() const { return start_x.size(); }
+
+        //! \brief Empties every column
+        void clear();
+    };
+}
+
+#endif // TOOLPATHFORMAT_H
@@ -0,0 +1,111 @@
+#ifndef GCODETEXTINDEX_H
+#define GCODETEXTINDEX_H
+
+// Qt
+#include <QByteArray>
+#include <QColor>
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+namespace ORNL
+{
+    /*!
+     * \class GcodeTextIndex
+     * \brief Program file mapped into memory with an offset per line and a one
+     * byte color index per line.
+     *
+     * The file is not read into memory, views materialize only the lines they
+     * show from the mapping. A program costs nine bytes per line of memory and
+     * any line is reached in constant time. Copies share the mapping, which is
+     * released with the last of them.
+     *
+     * \note The file stays open while an index of it exists, so it should not
+     * be rewritten in that time.
+     */
+    class GcodeTextIndex
+    {
+    public:
+        //! \brief Constructor, creates an empty index
+        GcodeTextIndex();
+
+        //! \brief Maps a program file and indexes its lines. Colors set before
+        //! are kept for the lines of the file, other lines start uncolored.
+        //! \param file_name: program file, lines separated by '\n'
+        //! \param skipped_lines: lines at the start of the file that are left out
+        //! \return false if the file could not be opened
+        bool load(const QString& file_name, int skipped_lines = 0);
+
+        //! \brief Number of lines
+        int lineCount() const;
+
+        //! \brief Whether there are no lines
+        bool isEmpty() const;
+
+        //! \brief Text of a line without its line break
+        //! \param line: zero based line number
+        QString line(int line) const;
+
+        //! \brief Longest line in bytes, close to its length in characters for g-code
+        int maxLineLength() const;
+
+        //! \brief The whole text
+        QString text() const;
+
+        //! \brief Assigns a color to a line. At most 255 distinct colors are kept,
+        //! further ones leave the line uncolored. Before a file is loaded any line
+        //! may be colored.
+        //! \param line: zero based line number
+        //! \param color: color to draw the line in
+        void setLineColor(int line, const QColor& color);
+
+        //! \brief Removes the color of a line
+        void clearLineColor(int line);
+
+        //! \brief Index of a line's color in palette(), zero if it has none
+        int lineColorIndex(int line) const;
+
+        //! \brief Colors in use. Entry zero stands for uncolored lines and is invalid.
+        const QVector<QColor>& palette() const;
+
+        //! \brief Copy holding only the line colors, so it does not keep the file open
+        GcodeTextIndex colorsOnly() const;
+
+        //! \brief Finds the lines containing a string, ignoring case
+        //! \param needle: string to search for
+        //! \return matching line numbers in ascending order
+        QVector<int> findLines(const QString& needle) const;
+
+    private:
+        //! \struct Source
+        //! \brief Open program file and its contents
+        struct Source
+        {
+            QFile file;
+
+            //! \brief contents when the file cannot be mapped
+            QByteArray contents;
+
+            const char* data = nullptr;
+            qint64 size = 0;
+        };
+
+        //! \brief Program file, shared by copies
+        QSharedPointer<Source> m_source;
+
+        //! \brief Start of each line in the file, with a final entry one past the end
+        QVector<qint64> m_line_offsets;
+
+        //! \brief Palette index of each line
+        QVector<quint8> m_line_colors;
+
+        //! \brief Colors referenced by m_line_colors
+        QVector<QColor> m_palette;
+
+        //! \brief Longest line in bytes
+        int m_max_line_length;
+    };
+}  // namespace ORNL
+
+#endif  // GCODETEXTINDEX_H
@@ -0,0 +1,59 @@
+#ifndef CONTOUR_HIERARCHY_H
+#define CONTOUR_HIERARCHY_H
+
+// Qt
+#include <QVector>
+
+// Local
+#include "clipper.hpp"
+
+namespace ORNL
+{
+    /*!
+     * \class ContourHierarchy
+     *
+     * \brief Nesting tree of a set of contours, where a contour is the child
+     * of the innermost contour enclosing its first point.
+     *
+     * Contour 0 is the root and encloses all other contours by definition.
+     * Parents are found by visiting contours from the largest area down and
+     * looking up each first point in a grid of the bounding boxes seen so far,
+     * newest (smallest) first, so a point-in-polygon test is only run against
+     * contours whose box holds the point. Children are listed in the order an
+     * insertion of contours 1, 2, 3... one at a time would leave them, which
+     * is the order path optimizers have always walked them in.
+     *
+     * Points on a contour's border count as outside it. The result matches
+     * the insertion order for contours that do not cross each other.
+     */
+    class ContourHierarchy
+    {
+    public:
+        //! \brief Builds the tree
+        //! \param contours: contour outlines, contour 0 is the root
+        //! \param can_enclose: whether each contour may have children, such as
+        //!        false for open polylines. Empty means every contour may.
+        ContourHierarchy(const QVector<ClipperLib2::Path>& contours, const QVector<bool>& can_enclose = QVector<bool>());
+
+        //! \brief Parent of a contour, -1 for the root
+        int parent(int contour) const;
+
+        //! \brief Children of a contour in insertion order
+        const QVector<int>& children(int contour) const;
+
+    private:
+        //! \brief Finds the innermost enclosing contour of every contour
+        void findParents(const QVector<ClipperLib2::Path>& contours, const QVector<bool>& can_enclose);
+
+        //! \brief Orders children the way inserting contours in index order would
+        void orderChildren();
+
+        //! \brief Parent of each contour
+        QVector<int> m_parents;
+
+        //! \brief Children of each contour
+        QVector<QVector<int>> m_children;
+    };
+}
+
+#endif // CONTOUR_HIERARCHY_H
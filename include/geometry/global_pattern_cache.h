@@ -0,0 +1,104 @@
+#ifndef GLOBAL_PATTERN_CACHE_H
+#define GLOBAL_PATTERN_CACHE_H
+
+// C++
+#include <functional>
+
+// Qt
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QVector>
+
+// Local
+#include "geometry/polyline.h"
+
+namespace ORNL
+{
+    /*!
+     * \class GlobalPattern
+     * \brief Rows of an infill pattern generated over the whole printer area.
+     *
+     * Points are stored in flat coordinate arrays with an offset per row. Rows
+     * are kept in generation order, which advances along one axis, so the rows
+     * overlapping a box are found by binary search over the per-row extent
+     * along that axis.
+     */
+    class GlobalPattern
+    {
+    public:
+        //! \brief Flattens generated rows
+        //! \param rows: pattern rows in generation order
+        GlobalPattern(const QVector<Polyline>& rows);
+
+        //! \brief Returns the parts of every row that overlap a box, in row order.
+        //! Stretches of a row entirely outside the box are dropped, which leaves
+        //! clipping against geometry inside the box unchanged.
+        //! \param min: lower corner of the box
+        //! \param max: upper corner of the box
+        QVector<Polyline> rowsOverlapping(const Point& min, const Point& max) const;
+
+        //! \brief Number of rows
+        int rowCount() const;
+
+    private:
+        //! \brief Flat point coordinates, row after row
+        QVector<float> m_x, m_y, m_z;
+
+        //! \brief Offset of each row's first point, size is rows + 1
+        QVector<int> m_row_offsets;
+
+        //! \brief Extent of each row along m_axis
+        QVector<float> m_row_min, m_row_max;
+
+        //! \brief Axis along which row extents never decrease: 0 for x, 1 for y, -1 if neither
+        int m_axis = -1;
+    };
+
+    /*!
+     * \class GlobalPatternCache
+     * \brief Shared cache of patterns generated over the printer area.
+     *
+     * Infill based on the printer area generates the same rows on every layer
+     * that shares a pattern, spacing and angle, so they are generated once and
+     * shared. Patterns are immutable after insertion and safe to read from any
+     * thread.
+     */
+    class GlobalPatternCache
+    {
+    public:
+        //! \brief Identifies a generated pattern. Bounds are given in the pattern's
+        //! rotated frame, so they also capture its angle.
+        struct Key
+        {
+            int pattern;
+            double spacing;
+            double bead_width;
+            double min_x, min_y, max_x, max_y;
+
+            bool operator==(const Key& rhs) const;
+        };
+
+        //! \brief Returns the cached pattern for key, generating it on first use
+        //! \param key: pattern identity
+        //! \param generate: produces the pattern rows if the pattern is not cached yet
+        static QSharedPointer<const GlobalPattern> Get(const Key& key, const std::function<QVector<Polyline>()>& generate);
+
+        //! \brief Drops every cached pattern
+        //! \note SessionManager calls this when a slice starts with inputs that differ from the last one
+        static void Clear();
+
+    private:
+        //! \brief Patterns held at most. A build only uses a handful, the bound
+        //! only matters for a slice with many distinct infill settings.
+        static constexpr int kMaxPatterns = 64;
+
+        static QHash<Key, QSharedPointer<const GlobalPattern>> m_patterns;
+        static QReadWriteLock m_lock;
+    };
+
+    //! \brief Hash for GlobalPatternCache::Key
+    uint qHash(const GlobalPatternCache::Key& key, uint seed = 0);
+}
+
+#endif // GLOBAL_PATTERN_CACHE_H
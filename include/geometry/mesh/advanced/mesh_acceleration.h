@@ -0,0 +1,120 @@
+#ifndef MESH_ACCELERATION_H
+#define MESH_ACCELERATION_H
+
+#ifndef __CUDACC__
+
+// Qt
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+
+// CGAL
+#include <CGAL/Polygon_mesh_slicer.h>
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+
+// Local
+#include "geometry/mesh/advanced/mesh_types.h"
+
+namespace ORNL
+{
+    /*!
+     * \class MeshAcceleration
+     *
+     * \brief Lazily built CGAL search structures for one mesh: the plane
+     * slicer with its edge tree, the face tree used for segment queries and
+     * the axis aligned bounds.
+     *
+     * Each structure is built on first use and kept until clear() is called,
+     * which the owning mesh does whenever its CGAL representation changes.
+     * Structures are handed out as shared pointers to const, so queries from
+     * several threads can run at once and a clear() does not pull a
+     * structure out from under a query that is still using it.
+     *
+     * The structures reference the mesh they were built from, so copies
+     * start out empty instead of sharing them.
+     */
+    template <class TriangleMesh, class FaceTree>
+    class MeshAcceleration
+    {
+    public:
+        //! \brief CGAL slicer over the mesh
+        typedef CGAL::Polygon_mesh_slicer<TriangleMesh, MeshTypes::Kernel> Slicer;
+
+        //! \brief Default constructor
+        MeshAcceleration() {}
+
+        //! \brief Copy constructor, the copy starts out empty
+        MeshAcceleration(const MeshAcceleration&) {}
+
+        //! \brief Assignment, drops anything built for the old mesh
+        MeshAcceleration& operator=(const MeshAcceleration&)
+        {
+            clear();
+            return *this;
+        }
+
+        //! \brief Drops every structure, call after the mesh changes
+        void clear()
+        {
+            QMutexLocker locker(&m_mutex);
+            m_slicer.reset();
+            m_face_tree.reset();
+            m_has_bbox = false;
+        }
+
+        //! \brief Plane slicer over the mesh
+        //! \param mesh: the mesh this belongs to
+        QSharedPointer<const Slicer> slicer(const TriangleMesh& mesh)
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_slicer.isNull())
+                m_slicer = QSharedPointer<const Slicer>(new Slicer(mesh));
+            return m_slicer;
+        }
+
+        //! \brief Tree over the faces of the mesh
+        //! \param mesh: the mesh this belongs to
+        QSharedPointer<const FaceTree> faceTree(const TriangleMesh& mesh)
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_face_tree.isNull())
+            {
+                QSharedPointer<FaceTree> tree(new FaceTree(CGAL::faces(mesh).first, CGAL::faces(mesh).second, mesh));
+                tree->build();
+                m_face_tree = tree;
+            }
+            return m_face_tree;
+        }
+
+        //! \brief Axis aligned bounds of the mesh
+        //! \param mesh: the mesh this belongs to
+        CGAL::Bbox_3 bbox(const TriangleMesh& mesh)
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_has_bbox)
+            {
+                m_bbox = CGAL::Polygon_mesh_processing::bbox(mesh);
+                m_has_bbox = true;
+            }
+            return m_bbox;
+        }
+
+    private:
+        //! \brief guards building and dropping structures
+        QMutex m_mutex;
+
+        //! \brief plane slicer, null until first used
+        QSharedPointer<const Slicer> m_slicer;
+
+        //! \brief face tree, null until first used
+        QSharedPointer<const FaceTree> m_face_tree;
+
+        //! \brief cached bounds
+        CGAL::Bbox_3 m_bbox;
+        bool m_has_bbox = false;
+    };
+}
+
+#endif // __CUDACC__
+
+#endif // MESH_ACCELERATION_H
@@ -3,6 +3,7 @@
 
 #include "geometry/mesh/mesh_base.h"
 #include "geometry/mesh/advanced/mesh_types.h"
+#include "geometry/mesh/advanced/mesh_acceleration.h"
 #include "geometry/polygon.h"
 #include "geometry/polyline.h"
 #include "geometry/segments/line.h"
@@ -222,6 +223,9 @@ namespace ORNL
 
         //! \brief the original CGAL representation of this mesh
         MeshTypes::Polyhedron m_original_representation;
+
+        //! \brief search structures over m_representation, cleared whenever it changes
+        MeshAcceleration<MeshTypes::Polyhedron, MeshTypes::Polyhedron_AABB_Tree> m_acceleration;
     };
 }
 
@@ -3,6 +3,8 @@
 
 #include "geometry/mesh/mesh_base.h"
 #include "geometry/mesh/advanced/mesh_types.h"
+#include "geometry/mesh/advanced/mesh_acceleration.h"
+#include "geometry/point_cloud.h"
 #include <CGAL/Polyhedron_incremental_builder_3.h>
 #include <CGAL/Surface_mesh_shortest_path.h>
 #include <boost/foreach.hpp>
@@ -110,10 +112,17 @@ namespace ORNL
         //! \return a pair of vertices and faces
         static std::pair<QVector<MeshVertex>, QVector<MeshFace>> VerticesAndFacesFromSurfaceMesh(MeshTypes::SurfaceMesh &sm);
 
-        //! \brief Builds and returns a surface mesh from a point cloud
+        //! \brief Builds and returns a surface mesh from a point cloud. Clouds sampled on a
+        //!        regular grid, such as .matrix height maps, are triangulated directly; others
+        //!        go through advancing front reconstruction.
         //! \param file_path the file to build the cloud from
+        //! \param max_points unstructured clouds with more points are voxel downsampled to
+        //!        this many before reconstruction, zero reconstructs from every point
         //! \return a pointer to the new mesh if it could be loaded
-        static QSharedPointer<OpenMesh> BuildMeshFromPointCloud(const QString& file_path);
+        static QSharedPointer<OpenMesh> BuildMeshFromPointCloud(const QString& file_path, int max_points = kMaxReconstructionPoints);
+
+        //! \brief Default point budget for reconstructing unstructured clouds
+        static constexpr int kMaxReconstructionPoints = 500000;
 
         void Sandbox();
         std::vector<Traits::Point_3> shortestPath();
@@ -122,15 +131,11 @@ namespace ORNL
         //! \brief converts vertices and faces into polyhedron, used to keep the two in sync
         void convert() override;
 
-        //! \brief loads points from a .matrix file
-        //! \param file_path the file
-        //! \return points in a point cloud
-        static QVector<MeshTypes::Point_3> loadMatrixFile(const QString& file_path);
-
-        //! \brief loads points from a .xyz file
-        //! \param file_path the file
-        //! \return points in a point cloud
-        static QVector<MeshTypes::Point_3> loadXYZFile(const QString& file_path);
+        //! \brief triangulates a height map, two triangles per cell. Cells with one missing
+        //!        corner keep a single triangle and cells with more are left open.
+        //! \param height_map the samples
+        //! \return a surface mesh with upward facing triangles
+        static MeshTypes::SurfaceMesh SurfaceMeshFromHeightMap(const HeightMap& height_map);
 
         //! \struct ConstructPointCloud
         //! \brief A trait used to build a point cloud mesh
@@ -165,6 +170,9 @@ namespace ORNL
 
         //! \brief the original CGAL representation of this mesh
         MeshTypes::SurfaceMesh m_original_representation;
+
+        //! \brief search structures over m_representation, cleared whenever it changes
+        MeshAcceleration<MeshTypes::SurfaceMesh, MeshTypes::SurfaceMesh_AABB_Tree> m_acceleration;
     };
 }
 
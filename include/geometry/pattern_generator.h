@@ -100,6 +100,42 @@ namespace ORNL {
              * \param infill_rotation: infill rotation in addition to necessary sector rotation
              */
             static QVector<Polyline> GenerateRadialHatch(PolygonList geometry, Point center, Distance lineSpacing, Angle sector_rotation, Angle infill_rotation);
+
+        private:
+            //! \brief Unclipped row layouts of the lattice patterns
+            enum class RowPattern : int
+            {
+                kLines,
+                kTriangles,
+                kHexagonsAndTriangles,
+                kHoneyComb
+            };
+
+            /*!
+             * \brief Creates the unclipped rows of a pattern in its rotated frame.
+             * \param pattern: row layout
+             * \param lineSpacing: the distance between lines
+             * \param beadWidth: bead width, only used by honeycomb
+             * \param min: Min of the area to cover
+             * \param max: Max of the area to cover
+             */
+            static QVector<Polyline> GenerateRows(RowPattern pattern, Distance lineSpacing, Distance beadWidth, Point min, Point max);
+
+            /*!
+             * \brief Returns the rows of a pattern that can intersect geometry.
+             * With globalBounds, the rows covering the printer area are taken from the
+             * GlobalPatternCache and narrowed to the geometry's bounding box, otherwise
+             * they are generated over min/max directly.
+             * \param pattern: row layout
+             * \param geometry: geometry in the pattern's rotated frame
+             * \param lineSpacing: the distance between lines
+             * \param beadWidth: bead width, only used by honeycomb
+             * \param globalBounds: whether min/max are the printer area
+             * \param min: Min of the area to cover
+             * \param max: Max of the area to cover
+             */
+            static QVector<Polyline> Rows(RowPattern pattern, const PolygonList& geometry, Distance lineSpacing, Distance beadWidth,
+                                          bool globalBounds, Point min, Point max);
     };
 }  // namespace ORNL
 
@@ -0,0 +1,81 @@
+#ifndef POINT_CLOUD_H
+#define POINT_CLOUD_H
+
+// Qt
+#include <QVector>
+
+namespace ORNL
+{
+    /*!
+     * \struct PointCloud
+     * \brief Unordered points stored as flat coordinate columns.
+     */
+    struct PointCloud
+    {
+        QVector<double> x, y, z;
+
+        //! \brief Number of points
+        int size() const;
+
+        //! \brief Whether there are no points
+        bool isEmpty() const;
+
+        //! \brief Appends a point
+        void append(double px, double py, double pz);
+
+        //! \brief Appends every point of another cloud
+        void append(const PointCloud& other);
+
+        //! \brief Replaces the points in each occupied voxel of a uniform grid by
+        //! their centroid. The voxel size starts at the spacing that would leave
+        //! max_points samples on a surface spanning the XY extent and grows until
+        //! at most max_points remain.
+        //! \param max_points: number of points to reduce to, zero keeps every point
+        //! \return the reduced cloud, or a copy if it already has few enough points
+        PointCloud voxelDownsampled(int max_points) const;
+    };
+
+    /*!
+     * \struct HeightMap
+     * \brief Heights sampled on a regular XY grid.
+     *
+     * Samples are stored row-major, rows advance in y and columns in x. Missing
+     * samples hold NaN, so holes in a scan survive into the mesh built from it.
+     */
+    struct HeightMap
+    {
+        int rows = 0;
+        int columns = 0;
+
+        //! \brief Location of the sample in row 0, column 0
+        double origin_x = 0.0, origin_y = 0.0;
+
+        //! \brief Distance between neighbouring columns and rows
+        double spacing_x = 0.0, spacing_y = 0.0;
+
+        //! \brief Sample heights, NaN where a sample is missing
+        QVector<double> heights;
+
+        //! \brief Whether the map has no samples
+        bool isEmpty() const;
+
+        //! \brief Whether the sample at row r, column c is present
+        bool isValid(int r, int c) const;
+
+        //! \brief Height of the sample at row r, column c
+        double height(int r, int c) const;
+
+        //! \brief The present samples as points
+        PointCloud points() const;
+
+        //! \brief Recovers the grid behind a point cloud that was sampled on one,
+        //! as most bed scans and exported height maps are.
+        //! \param cloud: points to arrange
+        //! \param map: set to the grid if one is found
+        //! \return false if the points do not sit on a dense regular grid with at
+        //!         most one point per node
+        static bool FromPoints(const PointCloud& cloud, HeightMap& map);
+    };
+}
+
+#endif // POINT_CLOUD_H
@@ -138,6 +138,12 @@ namespace ORNL
          */
         bool inside(const Point& point, bool border_result = false) const;
 
+        //! \brief Classifies a point against the polygon like ClipperLib2::PointInPolygon,
+        //! without converting the polygon to a path
+        //! \param point: point to classify
+        //! \return 1 inside, 0 outside, -1 on the border
+        int pointInPolygon(const Point& point) const;
+
         //! \brief tests two polygons to see if they overlap
         //! \param p: the second polygon
         //! \return if the polygons overlap
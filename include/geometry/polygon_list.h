@@ -3,6 +3,8 @@
 
 //Qt
 #include <QVector>
+#include <QQuaternion>
+#include <QCryptographicHash>
 
 //Libraries
 #include "clipper.hpp"
@@ -149,6 +151,17 @@ namespace ORNL
 
         PolygonList shift(Point shift);
 
+        //! \brief Rotates and then shifts every point, the same way path segments are transformed
+        //! \param rotation: rotation about the origin
+        //! \param shift: shift applied after the rotation
+        //! \return the moved polygons
+        PolygonList transform(const QQuaternion& rotation, const Point& shift) const;
+
+        //! \brief Adds the x and y of every point, polygon by polygon, to a hash. Like the clipping
+        //!        operations, z is not taken into account.
+        //! \param hash: the hash to add to
+        void addTo(QCryptographicHash& hash) const;
+
         // intersection over union of two polygonlist
         float commonArea(PolygonList cur_layer_outline);
 
@@ -327,11 +340,14 @@ namespace ORNL
         QVector<Polygon> lost_geometry;
 
         //! \brief Finds point inside island furthest from the edges within a given precision
-        Point poleOfInaccessibility(float precision);
+        //! \param precision: search stops once no cell can improve on the best by more than this
+        //! \param record_cells: keep every visited cell for getVisualCells, for debugging
+        Point poleOfInaccessibility(float precision, bool record_cells = false);
 
         //! \brief Returns distance from between point and edge of island
         float distanceTo(Point point);
 
+        //! \brief Cells visited by the last poleOfInaccessibility call that recorded them
         QVector<SearchCell> getVisualCells();
 
     protected:
@@ -434,8 +450,6 @@ namespace ORNL
         using QVector< Polygon >::push_front;
         using QVector< Polygon >::insert;
 
-        std::priority_queue<SearchCell, QVector<SearchCell>, CellComparator> m_cell_queue; // queue of "squares" (two points defining a min and max value)
-
         QVector<SearchCell> visual_cells;
     };  // class PolygonList
 
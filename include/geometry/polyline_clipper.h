@@ -0,0 +1,62 @@
+#ifndef POLYLINE_CLIPPER_H
+#define POLYLINE_CLIPPER_H
+
+// Qt
+#include <QVector>
+
+// Local
+#include "geometry/polygon_list.h"
+#include "geometry/polyline.h"
+#include "geometry/segment_grid.h"
+
+namespace ORNL
+{
+    /*!
+     * \class PolylineClipper
+     *
+     * \brief Clips open polylines against a fixed set of polygons.
+     *
+     * The boundary edges are indexed once in a SegmentGrid, so clipping a
+     * polyline only tests the edges near each of its segments instead of
+     * handing the whole polygon set to Clipper per line. Insideness follows
+     * the non-zero fill rule, like PolygonList::operator&(const Polyline&).
+     * Pieces are returned in order along each polyline and keep its direction.
+     *
+     * The boundary is read-only after construction, so one clipper can serve
+     * several threads; batches are clipped in parallel.
+     */
+    class PolylineClipper
+    {
+    public:
+        //! \brief Prepares the boundary
+        //! \param boundary: polygons to clip against
+        PolylineClipper(const PolygonList& boundary);
+
+        //! \brief Clips a single polyline
+        //! \param polyline: polyline to clip
+        //! \return pieces of polyline inside the boundary
+        QVector<Polyline> clip(const Polyline& polyline) const;
+
+        //! \brief Clips a batch of polylines
+        //! \param polylines: polylines to clip
+        //! \param alternate: if true, every other piece of the result is reversed,
+        //!        starting with the first, so consecutive pieces run in opposite directions
+        //! \return pieces of all polylines inside the boundary, in input order
+        QVector<Polyline> clip(const QVector<Polyline>& polylines, bool alternate = false) const;
+
+    private:
+        //! \brief Winding number of the boundary around the first point of a polyline
+        int startWinding(const Polyline& polyline) const;
+
+        //! \brief Appends the pieces of a polyline inside the boundary to result
+        void clipInto(const Polyline& polyline, QVector<Polyline>& result) const;
+
+        //! \brief Boundary edges
+        SegmentGrid m_edges;
+
+        //! \brief Boundary extent
+        double m_min_x, m_min_y, m_max_x, m_max_y;
+    };
+}
+
+#endif // POLYLINE_CLIPPER_H
@@ -0,0 +1,120 @@
+#ifndef SEGMENT_GRID_H
+#define SEGMENT_GRID_H
+
+// C++
+#include <functional>
+#include <vector>
+
+// Qt
+#include <QVector>
+
+// Local
+#include "geometry/point.h"
+
+namespace ORNL
+{
+    /*!
+     * \class SegmentGrid
+     *
+     * \brief Uniform grid over the XY extent of a fixed set of line segments
+     * for closest-segment queries.
+     *
+     * Segments are bucketed into every cell their XY bounding box overlaps
+     * and stored in a flat cell-ordered index array. The grid is built once
+     * and is read-only afterwards, so a single instance can be queried from
+     * several threads at the same time.
+     *
+     * \note Distances are measured in 3D, binning is done in XY only. This
+     * suits per-layer data, where segments lie in (or close to) one plane.
+     */
+    class SegmentGrid
+    {
+    public:
+        //! \brief Predicate used to filter candidates during nearest queries
+        //! \param index: index of the segment being considered
+        //! \param closest: closest point on that segment to the query point
+        //! \return whether the candidate may be selected
+        using Filter = std::function<bool(int index, const Point& closest)>;
+
+        //! \brief Default constructor, creates an empty grid
+        SegmentGrid();
+
+        //! \brief Builds a grid over the given segments
+        //! \param starts: segment start points
+        //! \param ends: segment end points, same length as starts
+        //! \param cell_size: edge length of a grid cell in microns. If zero, the
+        //!        mean XY segment length is used.
+        SegmentGrid(const QVector<Point>& starts, const QVector<Point>& ends, double cell_size = 0.0);
+
+        //! \brief Builds a grid over the edges of a closed polygon
+        //! \param points: vertices of the polygon, the closing edge is implied
+        //! \param cell_size: see above
+        static SegmentGrid fromClosedPolygon(const QVector<Point>& points, double cell_size = 0.0);
+
+        //! \brief Finds the segment closest to p
+        //! \param p: query point
+        //! \param closest: set to the closest point on the returned segment
+        //! \param distance: set to the distance from p to closest
+        //! \param filter: optional predicate, rejected candidates are skipped
+        //! \return index of the closest segment, or -1 if none is accepted.
+        //!         Ties resolve to the lowest index, which matches a linear
+        //!         scan with a strict less-than comparison.
+        int nearest(const Point& p, Point& closest, float& distance, const Filter& filter = Filter()) const;
+
+        //! \brief Visits every segment whose cells overlap the given XY box
+        //! \param min: lower corner of the box
+        //! \param max: upper corner of the box
+        //! \param visitor: called once per segment index, in ascending order
+        void forEachInBox(const Point& min, const Point& max, const std::function<void(int)>& visitor) const;
+
+        //! \brief Visits every segment whose cells are within radius of p
+        //! \param p: query point
+        //! \param radius: search radius in XY
+        //! \param visitor: called once per segment index, in ascending order
+        void forEachNear(const Point& p, double radius, const std::function<void(int)>& visitor) const;
+
+        //! \brief Number of segments in the grid
+        int size() const;
+
+        //! \brief Whether the grid holds no segments
+        bool isEmpty() const;
+
+        //! \brief Start point of a segment
+        const Point& start(int index) const;
+
+        //! \brief End point of a segment
+        const Point& end(int index) const;
+
+    private:
+        //! \brief Lays out cells and fills the cell index
+        void build(double cell_size);
+
+        //! \brief Column of an x coordinate, clamped to the grid
+        int column(double x) const;
+
+        //! \brief Row of a y coordinate, clamped to the grid
+        int row(double y) const;
+
+        //! \brief Collects unique segment indices in a cell range
+        void collect(int c0, int r0, int c1, int r1, const std::function<void(int)>& visitor) const;
+
+        //! \brief segment end points
+        QVector<Point> m_starts;
+        QVector<Point> m_ends;
+
+        //! \brief grid origin and dimensions
+        double m_min_x = 0.0;
+        double m_min_y = 0.0;
+        double m_cell_size = 1.0;
+        int m_columns = 0;
+        int m_rows = 0;
+
+        //! \brief offsets into m_cell_items for each cell, size is cells + 1
+        std::vector<int> m_cell_offsets;
+
+        //! \brief segment indices, grouped by cell
+        std::vector<int> m_cell_items;
+    };
+}
+
+#endif // SEGMENT_GRID_H
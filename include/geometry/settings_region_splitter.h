@@ -0,0 +1,85 @@
+#ifndef SETTINGS_REGION_SPLITTER_H
+#define SETTINGS_REGION_SPLITTER_H
+
+// Qt
+#include <QVector>
+
+// Local
+#include "geometry/polyline.h"
+#include "geometry/segment_grid.h"
+#include "geometry/settings_polygon.h"
+
+namespace ORNL
+{
+    /*!
+     * \class SettingsRegionSplitter
+     *
+     * \brief Splits the edges of a polyline where it enters or leaves the
+     * settings polygons of a region.
+     *
+     * The settings of the region merged with each settings polygon are built
+     * once and named by a small id: 0 is the region itself, i + 1 is settings
+     * polygon i. A polygon whose merged settings equal those of the region
+     * changes nothing and is left out. Where polygons overlap, the one given
+     * last wins.
+     *
+     * The edges of all polygons are indexed once in a SegmentGrid. Containment
+     * is found for the first point of a polyline and then carried along it by
+     * the crossings of each edge, using the non-zero fill rule.
+     */
+    class SettingsRegionSplitter
+    {
+    public:
+        //! \struct Span
+        //! \brief Part of a polyline edge with a single set of settings
+        struct Span
+        {
+            Point start;
+            Point end;
+
+            //! \brief id of the settings in effect, 0 for the region
+            int id;
+        };
+
+        //! \brief Prepares the settings polygons of a region
+        //! \param sb: settings of the region
+        //! \param settings_polygons: settings polygons of the region
+        SettingsRegionSplitter(const QSharedPointer<SettingsBase>& sb, QVector<SettingsPolygon> settings_polygons);
+
+        //! \brief Whether any settings polygon changes the settings of the region
+        bool isEmpty() const;
+
+        //! \brief Settings for an id
+        //! \param id: id of a span
+        //! \return the region settings merged with the settings polygon, or the region settings for 0
+        const QSharedPointer<SettingsBase>& settings(int id) const;
+
+        //! \brief Splits the first edge_count edges of a polyline. Edge j runs from
+        //!        point j to point j + 1, wrapping around to the first point.
+        //! \param line: polyline to split
+        //! \param edge_count: number of edges to split
+        //! \return spans in order along the polyline, every edge gives at least one
+        QVector<Span> split(const Polyline& line, int edge_count) const;
+
+    private:
+        //! \brief Id of the settings in effect for the given winding numbers
+        int activeId(const QVector<int>& windings) const;
+
+        //! \brief Winding number of each polygon around the first point of a polyline
+        QVector<int> startWindings(const Polyline& line) const;
+
+        //! \brief settings by id
+        QVector<QSharedPointer<SettingsBase>> m_settings;
+
+        //! \brief edges of every polygon that changes settings
+        SegmentGrid m_edges;
+
+        //! \brief id of the polygon each edge belongs to
+        QVector<int> m_edge_ids;
+
+        //! \brief extent of the edges
+        double m_min_x, m_min_y, m_max_x, m_max_y;
+    };
+}
+
+#endif // SETTINGS_REGION_SPLITTER_H
@@ -23,7 +23,12 @@ namespace ORNL {
             //! \param view: View to render to.
             //! \param gcode: GCode segments to visualize.
             //! \param segmentInfoControl: Segment / Bead info display control
-            GCodeObject(BaseView* view, QVector<QVector<QSharedPointer<SegmentBase>>> gcode, QSharedPointer<GCodeInfoControl> segmentInfoControl);
+            //! \param layer_keys: Key of the inputs of each layer, empty if unknown.
+            //! \param previous: Object shown before this one. Layers whose key matches a layer of it take its
+            //!                  geometry instead of building it again.
+            GCodeObject(BaseView* view, QVector<QVector<QSharedPointer<SegmentBase>>> gcode, QSharedPointer<GCodeInfoControl> segmentInfoControl,
+                        const QVector<QByteArray>& layer_keys = QVector<QByteArray>(),
+                        QSharedPointer<GCodeObject> previous = QSharedPointer<GCodeObject>());
 
             //! \brief Hides/Show all segments matching a type.
             //! \param type: Type to hide/show.
@@ -119,6 +124,9 @@ namespace ORNL {
             //! \brief Segment metadata container.
             QVector<QVector<QSharedPointer<SegmentDisplayMeta>>> m_segments;
 
+            //! \brief Key of the inputs of each layer, empty if unknown.
+            QVector<QByteArray> m_layer_keys;
+
             //! \brief Lowest layer shown.
             uint m_low_layer = 0;
             //! \brief Highest layer shown.
@@ -38,6 +38,11 @@ namespace ORNL {
             //! \param gcode: Segments of GCode. Each outer vector is a layer, each inner is a specific segment.
             void addGCode(QVector<QVector<QSharedPointer<SegmentBase>>> gcode);
 
+            //! \brief Sets the keys of the layers passed to the next addGCode. Layers whose key matches a layer
+            //! of the GCode shown before keep its geometry instead of generating it again.
+            //! \param keys: one key per layer, see GCodeLoader::gcodeLoadedLayerKeys
+            void setLayerKeys(QVector<QByteArray> keys);
+
             //! \brief Hides segments of a certain type.
             //! \param type: Type of segment to hide.
             //! \param hidden: If this type should be hidden.
@@ -133,6 +138,10 @@ namespace ORNL {
             QSharedPointer<PrinterObject> m_printer;
             //! \brief Main GCodeObject.
             QSharedPointer<GCodeObject> m_gcode_object;
+            //! \brief GCodeObject shown before the last clear, kept until the next GCode can reuse its layers.
+            QSharedPointer<GCodeObject> m_previous_gcode_object;
+            //! \brief keys of the layers passed to the next addGCode
+            QVector<QByteArray> m_layer_keys;
 
             //! \brief m_meta_model tracks the states of the parts and their transformations
             QSharedPointer<PartMetaModel> m_meta_model;
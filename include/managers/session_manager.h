@@ -6,6 +6,7 @@
 #include <QQueue>
 #include <QStandardPaths>
 #include <QDir>
+#include <QPointer>
 
 // Local
 #include "part/part.h"
@@ -113,6 +114,19 @@ namespace ORNL {
             //! \brief Checks preferences to see if TCP server should be started
             void setupTCPServer();
 
+            //! \brief Hash of everything a slice depends on: models, transforms, settings, and the slicer build
+            QByteArray sliceInputHash();
+
+            //! \brief G-code for the current inputs, if a finished slice or a loaded session produced it
+            //! \param input_hash: set to the hash of the current inputs
+            //! \return g-code, or empty if there is none or it is out of date
+            QByteArray currentToolpath(QByteArray& input_hash);
+
+            //! \brief Keeps g-code read from a session so that slicing the same inputs can skip computation
+            //! \param input_hash: hash of the inputs the g-code was sliced from
+            //! \param compressed: qCompress'd g-code, kept compressed until it is used
+            void setStoredToolpath(const QByteArray& input_hash, const QByteArray& compressed);
+
         public slots:
             //! \brief loads a model into the session
             //! \param filename the path to the file
@@ -268,6 +282,9 @@ namespace ORNL {
             //! \brief Save session history for various dialogs
             void saveHistory();
 
+            //! \brief Blocks until session saves that may read model data have finished
+            void waitForSessionSavers();
+
             //! \brief Singleton pointer.
             static QSharedPointer<SessionManager> m_singleton;
 
@@ -279,6 +296,9 @@ namespace ORNL {
             //! 为了兼容一些外部库，比如 assimp（一个常见的模型加载器）和 zip（用于处理压缩文件的库），这些库期望使用 void* 指针类型来处理数据。
             QMap<QString, model_data> m_models;
 
+            //! \brief Session saves that may still be reading m_models.
+            QVector<QPointer<SessionLoader>> m_session_savers;
+
             //! \brief Current session file.
             QString m_file;
 
@@ -318,6 +338,26 @@ namespace ORNL {
             //! must be accessed sequentially.
             QMutex m_load_mutex;
 
+            //! \brief Whether the output of the current slicer only depends on the hashed inputs
+            bool isToolpathCacheable();
+
+            //! \brief Writes stored g-code to the output file if it was sliced from the current inputs
+            //! \return whether the slice was replaced by stored g-code
+            bool restoreStoredToolpath();
+
+            //! \brief Hash of the inputs of the slice in progress
+            QByteArray m_slice_input_hash;
+
+            //! \brief Hash of the inputs that tempGcodeFile was sliced from, empty while it is being written
+            QByteArray m_output_input_hash;
+
+            //! \brief Compressed g-code from a loaded session and the hash of its inputs
+            QByteArray m_stored_toolpath;
+            QByteArray m_stored_toolpath_hash;
+
+            //! \brief Guards the toolpath hashes and stored g-code, which the session loader reads and writes
+            QMutex m_toolpath_mutex;
+
             //! \brief Save location.
             QDir m_save_dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
 
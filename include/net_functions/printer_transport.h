@@ -0,0 +1,87 @@
+#ifndef PRINTER_TRANSPORT_H
+#define PRINTER_TRANSPORT_H
+
+// Qt
+#include <QObject>
+#include <QByteArray>
+#include <QUrl>
+
+namespace ORNL
+{
+    /*!
+     * \class PrinterTransport
+     * \brief Byte link to a printer's command interpreter. Subclasses provide the
+     * actual channel (serial port, TCP socket or pseudo-terminal) and the base
+     * class splits incoming bytes into response lines.
+     *
+     * \note Transports are not thread safe. Create and use them on the thread that
+     * owns the streaming host.
+     */
+    class PrinterTransport : public QObject
+    {
+        Q_OBJECT
+        public:
+            //! \brief Constructor
+            //! \param parent: Qt parent
+            explicit PrinterTransport(QObject* parent = nullptr);
+
+            //! \brief Destructor
+            virtual ~PrinterTransport();
+
+            //! \brief Creates a transport from a connection url
+            //! \param url: one of
+            //!        tcp://host:port
+            //!        serial://COM3?baud=250000 or serial:///dev/ttyUSB0?baud=250000
+            //!        pty:///dev/pts/4
+            //! \param parent: Qt parent
+            //! \return new transport, or nullptr if the scheme is not recognized
+            static PrinterTransport* Create(const QUrl& url, QObject* parent = nullptr);
+
+            //! \brief Opens the channel. opened() is emitted once bytes can be written.
+            //! \return false if the channel could not be opened. error() is emitted with the reason.
+            virtual bool open() = 0;
+
+            //! \brief Closes the channel
+            virtual void close() = 0;
+
+            //! \brief Whether the channel is open
+            virtual bool isOpen() const = 0;
+
+            //! \brief Queues bytes for sending
+            //! \param data: bytes to send
+            //! \return number of bytes accepted, or -1 on error
+            virtual qint64 write(const QByteArray& data) = 0;
+
+            //! \brief Human readable name of the channel
+            virtual QString description() const = 0;
+
+        signals:
+            //! \brief Emitted once the channel is ready for writing
+            void opened();
+
+            //! \brief Emitted for every complete line received, without the line terminator
+            //! \param line: received line
+            void lineReceived(const QByteArray& line);
+
+            //! \brief Emitted when the channel closes, either locally or from the remote end
+            void closed();
+
+            //! \brief Emitted when the channel fails
+            //! \param msg: description of the failure
+            void error(const QString& msg);
+
+        protected:
+            //! \brief Splits raw bytes into lines and emits lineReceived for each one
+            //! \param bytes: bytes read from the channel
+            void receive(const QByteArray& bytes);
+
+            //! \brief Drops any partially received line
+            void resetReceiveBuffer();
+
+        private:
+            //! \brief bytes received after the last line terminator
+            QByteArray m_partial_line;
+    };
+}
+
+#endif // PRINTER_TRANSPORT_H
@@ -0,0 +1,69 @@
+#ifndef PTY_PRINTER_TRANSPORT_H
+#define PTY_PRINTER_TRANSPORT_H
+
+// Qt
+#include <QSocketNotifier>
+
+// Local
+#include "net_functions/printer_transport.h"
+
+namespace ORNL
+{
+    /*!
+     * \class PtyPrinterTransport
+     * \brief Printer link over a terminal device opened in raw mode, typically the
+     * slave side of a pseudo-terminal created by the simulated printer or a tool
+     * such as socat.
+     *
+     * \note Only available on POSIX systems. On other platforms open() fails.
+     */
+    class PtyPrinterTransport : public PrinterTransport
+    {
+        Q_OBJECT
+        public:
+            //! \brief Constructor
+            //! \param device_path: path of the terminal device, e.g. /dev/pts/4
+            //! \param parent: Qt parent
+            PtyPrinterTransport(const QString& device_path, QObject* parent = nullptr);
+
+            //! \brief Destructor, closes the device
+            ~PtyPrinterTransport();
+
+            //! \brief Opens the device non-blocking in raw mode
+            bool open() override;
+
+            //! \brief Closes the device
+            void close() override;
+
+            //! \brief Whether the device is open
+            bool isOpen() const override;
+
+            //! \brief Writes as much as the device accepts and buffers the rest
+            qint64 write(const QByteArray& data) override;
+
+            //! \brief Returns the device path
+            QString description() const override;
+
+        private:
+            //! \brief Reads everything currently available
+            void readAvailable();
+
+            //! \brief Flushes buffered output
+            void flushPending();
+
+            //! \brief device to open
+            QString m_device_path;
+
+            //! \brief file descriptor, -1 when closed
+            int m_fd;
+
+            //! \brief bytes the device could not take yet
+            QByteArray m_pending;
+
+            //! \brief readiness notifiers for m_fd
+            QSocketNotifier* m_read_notifier;
+            QSocketNotifier* m_write_notifier;
+    };
+}
+
+#endif // PTY_PRINTER_TRANSPORT_H
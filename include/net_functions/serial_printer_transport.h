@@ -0,0 +1,56 @@
+#ifndef SERIAL_PRINTER_TRANSPORT_H
+#define SERIAL_PRINTER_TRANSPORT_H
+
+// Qt
+#include <QIODevice>
+
+// Local
+#include "net_functions/printer_transport.h"
+
+namespace ORNL
+{
+    /*!
+     * \class SerialPrinterTransport
+     * \brief Printer link over a serial port.
+     *
+     * \note Requires the Qt SerialPort module. When the program is built without
+     * it (HAVE_SERIAL_PORT undefined) open() fails with an explanatory error.
+     */
+    class SerialPrinterTransport : public PrinterTransport
+    {
+        Q_OBJECT
+        public:
+            //! \brief Constructor
+            //! \param port_name: system name of the port, e.g. COM3 or /dev/ttyUSB0
+            //! \param baud: baud rate
+            //! \param parent: Qt parent
+            SerialPrinterTransport(const QString& port_name, int baud, QObject* parent = nullptr);
+
+            //! \brief Opens the port at 8N1 without flow control
+            bool open() override;
+
+            //! \brief Closes the port
+            void close() override;
+
+            //! \brief Whether the port is open
+            bool isOpen() const override;
+
+            //! \brief Queues bytes on the port
+            qint64 write(const QByteArray& data) override;
+
+            //! \brief Returns port@baud
+            QString description() const override;
+
+        private:
+            //! \brief port to open
+            QString m_port_name;
+
+            //! \brief baud rate
+            int m_baud;
+
+            //! \brief underlying QSerialPort, held as its QIODevice base so this header does not depend on the module
+            QIODevice* m_port;
+    };
+}
+
+#endif // SERIAL_PRINTER_TRANSPORT_H
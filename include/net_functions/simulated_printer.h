@@ -0,0 +1,137 @@
+#ifndef SIMULATED_PRINTER_H
+#define SIMULATED_PRINTER_H
+
+// Qt
+#include <QObject>
+#include <QThread>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QSocketNotifier>
+#include <QQueue>
+#include <QTimer>
+#include <QElapsedTimer>
+
+namespace ORNL
+{
+    /*!
+     * \class SimulatedPrinter
+     * \brief Local printer endpoint for exercising the streaming host without hardware.
+     *
+     * Behaves like Marlin with ADVANCED_OK: numbered, checksummed lines are
+     * validated and placed in a command queue, moved into a planner buffer as
+     * space allows (answering "ok N P B" at that point), and executed from the
+     * planner at a fixed number of lines per second. Checksum and line number
+     * errors are answered with a resend request. The endpoint is exposed as a
+     * TCP server on the loopback interface or, on POSIX systems, as a
+     * pseudo-terminal.
+     *
+     * \note This object lives on its own thread.
+     */
+    class SimulatedPrinter : public QObject
+    {
+        Q_OBJECT
+        public:
+            //! \brief Constructor
+            SimulatedPrinter();
+
+            //! \brief Destructor
+            ~SimulatedPrinter();
+
+        public slots:
+            //! \brief Starts listening. listening() is emitted with the url to connect to.
+            //! \param transport: "tcp" or "pty"
+            //! \param lines_per_second: rate at which planner blocks are executed
+            //! \param planner_blocks: planner buffer size
+            //! \param queue_lines: command queue size
+            //! \param error_rate: probability that a received line is treated as corrupt, to exercise resends
+            void start(const QString& transport, double lines_per_second, int planner_blocks, int queue_lines, double error_rate);
+
+            //! \brief Stops listening and drops any client
+            void stop();
+
+        signals:
+            //! \brief Emitted once the endpoint accepts connections
+            //! \param url: transport url for PrinterTransport::Create
+            void listening(const QString& url);
+
+            //! \brief Periodic report of simulated machine activity
+            //! \param executed: planner blocks executed so far
+            //! \param underruns: times the planner ran empty while the command queue was also empty
+            void statistics(qint64 executed, int underruns);
+
+            //! \brief Emitted when the endpoint fails to start
+            //! \param msg: description of the failure
+            void error(const QString& msg);
+
+        private:
+            //! \brief Resets machine state for a new client
+            void reset();
+
+            //! \brief Handles bytes received from the client
+            void receive(const QByteArray& bytes);
+
+            //! \brief Parses received lines into the command queue while it has room
+            void parse();
+
+            //! \brief Moves queued commands into the planner, acknowledging each
+            void plan();
+
+            //! \brief Executes planner blocks for the elapsed time
+            void execute();
+
+            //! \brief Sends bytes to the client
+            void reply(const QByteArray& bytes);
+
+            //! \brief Writes as much pending pseudo-terminal output as the terminal accepts
+            void flushPty();
+
+            //! \brief Requests a resend of the line after the last good one and discards pending input
+            void requestResend(const QByteArray& reason);
+
+            //! \brief internal thread
+            QThread m_internal_thread;
+
+            //! \brief tcp endpoint
+            QTcpServer* m_server;
+            QTcpSocket* m_client = nullptr;
+
+            //! \brief pseudo-terminal endpoint
+            int m_pty_master = -1;
+            QSocketNotifier* m_pty_notifier = nullptr;
+            QSocketNotifier* m_pty_write_notifier = nullptr;
+            QByteArray m_pty_pending;
+
+            //! \brief configuration
+            double m_lines_per_second = 1000.0;
+            int m_planner_blocks = 16;
+            int m_queue_lines = 4;
+            double m_error_rate = 0.0;
+
+            //! \brief received bytes not yet parsed
+            QByteArray m_input;
+
+            //! \brief validated commands waiting for planner space, with their line numbers
+            QQueue<QPair<qint64, QByteArray>> m_queue;
+
+            //! \brief blocks in the planner
+            int m_planner_count = 0;
+
+            //! \brief last accepted line number
+            qint64 m_last_line = 0;
+
+            //! \brief whether M112 was received
+            bool m_halted = false;
+
+            //! \brief execution clock
+            QTimer* m_tick_timer;
+            QElapsedTimer m_clock;
+            double m_execution_budget = 0.0;
+
+            //! \brief activity counters
+            qint64 m_executed = 0;
+            int m_underruns = 0;
+            int m_ticks_since_report = 0;
+    };
+}
+
+#endif // SIMULATED_PRINTER_H
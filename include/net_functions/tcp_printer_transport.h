@@ -0,0 +1,54 @@
+#ifndef TCP_PRINTER_TRANSPORT_H
+#define TCP_PRINTER_TRANSPORT_H
+
+// Qt
+#include <QTcpSocket>
+
+// Local
+#include "net_functions/printer_transport.h"
+
+namespace ORNL
+{
+    /*!
+     * \class TcpPrinterTransport
+     * \brief Printer link over a raw TCP socket, as exposed by network serial
+     * bridges and the simulated printer.
+     */
+    class TcpPrinterTransport : public PrinterTransport
+    {
+        Q_OBJECT
+        public:
+            //! \brief Constructor
+            //! \param host: host name or address
+            //! \param port: TCP port
+            //! \param parent: Qt parent
+            TcpPrinterTransport(const QString& host, int port, QObject* parent = nullptr);
+
+            //! \brief Starts connecting. opened() is emitted when the connection is established.
+            bool open() override;
+
+            //! \brief Closes the connection
+            void close() override;
+
+            //! \brief Whether the socket is connected
+            bool isOpen() const override;
+
+            //! \brief Queues bytes on the socket
+            qint64 write(const QByteArray& data) override;
+
+            //! \brief Returns host:port
+            QString description() const override;
+
+        private:
+            //! \brief host to connect to
+            QString m_host;
+
+            //! \brief port to connect to
+            int m_port;
+
+            //! \brief underlying socket
+            QTcpSocket* m_socket;
+    };
+}
+
+#endif // TCP_PRINTER_TRANSPORT_H
@@ -5,6 +5,8 @@
 #include "part/part.h"
 #include "step/global_layer.h"
 
+//#define GLOBAL_LAYER_DEBUG_INFO
+
 namespace ORNL
 {
     /*!
@@ -25,8 +27,39 @@ namespace ORNL
             //! \param build_parts: list of build parts to access steps
             static QList<QSharedPointer<GlobalLayer>> populateSteps(QSharedPointer<SettingsBase> global_sb, QVector<QSharedPointer<Part>> build_parts);
 
-            static void logGlobalLayers(const QList<QSharedPointer<GlobalLayer>>& global_layers);
+            //! \brief Writes the part membership of every global layer to a text file
+            //! \param global_layers: global layers to dump
+            //! \param file_path: file to write, overwritten on each call
+            //! \note diagnostic only; slicers call this when GLOBAL_LAYER_DEBUG_INFO is defined
+            static void logGlobalLayers(const QList<QSharedPointer<GlobalLayer>>& global_layers, const QString& file_path = "global_layers_log.txt");
+
+        private:
+            //! \brief A part's current layer during the by-height merge
+            struct LayerCandidate
+            {
+                //! \brief distance of the layer's mid-plane from the origin along the slicing direction
+                double distance;
+                //! \brief index into the build part list
+                int part_index;
+                //! \brief step pair index within the part
+                int layer_index;
+                //! \brief layer mid-plane
+                Plane plane;
+
+                bool operator>(const LayerCandidate& rhs) const
+                {
+                    if (distance != rhs.distance)
+                        return distance > rhs.distance;
+                    return part_index > rhs.part_index;
+                }
+            };
 
+            //! \brief builds the merge entry for a part's layer
+            //! \param part: part that owns the layer
+            //! \param part_index: index of the part in the build part list
+            //! \param layer_index: step pair index
+            //! \param slicing_plane: global slicing direction
+            static LayerCandidate makeCandidate(const QSharedPointer<Part>& part, int part_index, int layer_index, const QVector3D& slicing_plane);
     };
 }
 
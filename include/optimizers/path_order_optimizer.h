@@ -159,11 +159,6 @@ namespace ORNL {
             //! \return Returns pointer to root node of n-ary tree representing heirarchy
             QSharedPointer<TopologicalNode> computeTopologicalHeirarchy();
 
-            //! \brief Inserts node into n-ary tree to build topological heirarchy
-            //! \param root: Current parent under evaluation
-            //! \param current: Current node to insert
-            void insert(QSharedPointer<TopologicalNode> root, QSharedPointer<TopologicalNode> current);
-
             //! \brief Performs a level order walk of topological heirarchy to create final path ordering
             //! \param root: Root node to begin walk at
             void levelOrder(QSharedPointer<TopologicalNode> root);
@@ -83,6 +83,50 @@ namespace ORNL
             int getSliceCount();
 
         private:
+            //! \struct RegionPart
+            //! \brief A settings or emboss part along with what is kept about it for the whole slice
+            struct RegionPart
+            {
+                //! \brief the part
+                QSharedPointer<Part> part;
+
+                //! \brief settings used to cross-section the part
+                QSharedPointer<SettingsBase> section_settings;
+
+                //! \brief settings carried by the polygons of the part
+                QSharedPointer<SettingsBase> region_settings;
+
+                //! \brief corners of the bounding box, planes that miss all of them are not cross-sectioned
+                QVector<Point> corners;
+
+                //! \brief if the part is a straight prism along prism_axis, so every cross-section between
+                //!        prism_low and prism_high is the same
+                bool is_prism = false;
+                QVector3D prism_axis;
+                float prism_low = 0.0f;
+                float prism_high = 0.0f;
+
+                //! \brief last cross-section taken inside the prism and the plane midpoint it was taken at
+                bool has_section = false;
+                PolygonList section;
+                Point section_shift;
+            };
+
+            //! \brief builds a region part, finding its bounds and whether it is a prism along the slicing axis
+            //! \param part the settings or emboss part
+            //! \param section_settings settings to cross-section with
+            //! \param region_settings settings carried by the polygons
+            //! \return the region part
+            RegionPart makeRegionPart(const QSharedPointer<Part>& part, const QSharedPointer<SettingsBase>& section_settings,
+                                      const QSharedPointer<SettingsBase>& region_settings);
+
+            //! \brief cross-sections a region part with the current plane, reusing the last cross-section when
+            //!        both are inside the same prism
+            //! \param region_part the region part
+            //! \param geometry the cross-section, only set when the plane meets the part
+            //! \return false if the plane misses the bounding box of the part
+            bool sectionRegionPart(RegionPart& region_part, PolygonList& geometry);
+
             //! \brief processes a single slice (cross-sections)
             //! \return a cross-section (SliceMeta) object
             QSharedPointer<BufferedSlicer::SliceMeta> processSingleSlice();
@@ -139,10 +183,10 @@ namespace ORNL
             Point m_additional_shift;
 
             //! \brief list of settings parts being tracked
-            QVector<QSharedPointer<Part>> m_settings_parts;
+            QVector<RegionPart> m_settings_parts;
 
             //! \brief list of emboss parts being tracked
-            QVector<QSharedPointer<Part>> m_emboss_parts;
+            QVector<RegionPart> m_emboss_parts;
 
             #ifdef NVCC_FOUND
             //! \brief Only compiled with if NVCC is on the system
@@ -0,0 +1,42 @@
+#ifndef LAYER_REUSE_H
+#define LAYER_REUSE_H
+
+// Local
+#include "part/part.h"
+
+namespace ORNL
+{
+    //! \brief Finds layers of a part that compute the same as an earlier layer of that part, such as the walls of
+    //!        an extrusion, so that only the first of them is computed. The others take copies of its islands.
+    //!
+    //!        Layers are kept in the frame they were cut in until their paths are connected, so the copies need no
+    //!        transform: each layer keeps its own orientation and is moved to its own height like any other.
+    //!        Two layers compute the same when their settings, island outlines and everything their regions
+    //!        read from neighboring layers are equal. Paths are still ordered and connected per layer.
+    namespace LayerReuse
+    {
+        //! \struct Repeat
+        //! \brief A layer that computes the same as an earlier one
+        struct Repeat
+        {
+            //! \brief layer that is computed
+            QSharedPointer<Layer> source;
+
+            //! \brief layer that takes the islands of the source
+            QSharedPointer<Layer> copy;
+        };
+
+        //! \brief finds the repeated layers among the dirty layers of each part and leaves them clean, so they are
+        //!        not computed
+        //! \param parts: the build parts
+        //! \return every repeated layer with the layer it repeats
+        QVector<Repeat> findRepeats(const QVector<QSharedPointer<Part>>& parts);
+
+        //! \brief fills the repeated layers with copies of the computed islands of their source and marks them
+        //!        dirty again, so they are connected like freshly computed layers
+        //! \param repeats: the repeated layers
+        void placeRepeats(const QVector<Repeat>& repeats);
+    }
+}
+
+#endif // LAYER_REUSE_H
@@ -0,0 +1,55 @@
+#ifndef PART_INSTANCING_H
+#define PART_INSTANCING_H
+
+// Qt
+#include <QQuaternion>
+
+// Local
+#include "part/part.h"
+#include "slicing/preprocessor.h"
+
+namespace ORNL
+{
+    //! \brief Finds build parts that are identical copies of another part, so that only one of them is sliced and
+    //!        computed. The layers of the sliced part are then copied onto the others by a rigid transform.
+    //!
+    //!        Parts are copies when their meshes have the same content, their settings and ranges are equal, and
+    //!        one is placed from the other by a turn about the z axis and a move across the build plate, which
+    //!        leaves every layer at the same height.
+    namespace PartInstancing
+    {
+        //! \struct Instance
+        //! \brief A part placed as a copy of another
+        struct Instance
+        {
+            //! \brief part that is sliced
+            QSharedPointer<Part> source;
+
+            //! \brief part that takes the layers of the source
+            QSharedPointer<Part> copy;
+
+            //! \brief rotation about the z axis from the source to the copy
+            QQuaternion rotation;
+
+            //! \brief shift across the build plate applied after the rotation
+            Point shift;
+        };
+
+        //! \brief finds the copies among the build parts
+        //! \param parts: the parts of the session
+        //! \param global_sb: the global settings
+        //! \return every copy with the part it copies, empty when instancing is off or not possible with these settings
+        QVector<Instance> findInstances(const Preprocessor::Parts& parts, const QSharedPointer<SettingsBase>& global_sb);
+
+        //! \brief gives each copy stand-ins of the layers of its source, which are placed into global layers like any
+        //!        other layer but are not computed
+        //! \param instances: the copies
+        void linkSteps(const QVector<Instance>& instances);
+
+        //! \brief fills the stand-ins with copies of the computed islands of the source, moved onto the copy
+        //! \param instances: the copies
+        void placeCopies(const QVector<Instance>& instances);
+    }
+}
+
+#endif // PART_INSTANCING_H
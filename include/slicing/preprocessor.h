@@ -1,6 +1,8 @@
 #ifndef PREPROCESSOR_H
 #define PREPROCESSOR_H
 
+#include <QSet>
+
 #include "part/part.h"
 #include "slicing/buffered_slicer.h"
 
@@ -168,6 +170,11 @@ namespace ORNL
             //! \return Sorted Parts struct
             Parts getParts();
 
+            //! \brief Leaves parts out of slicing, such as copies that reuse the steps of an identical part
+            //! \note Only used by processAll(). Skipped parts are still handed to final processing.
+            //! \param part_ids: ids of the parts to leave out
+            void skipParts(const QSet<QUuid>& part_ids);
+
         private:
             //! \brief Callable functions used by the preprocessor
             StepBuilder m_step_builder;
@@ -183,6 +190,9 @@ namespace ORNL
             //! \brief Sorted parts
             Parts m_parts;
 
+            //! \brief Parts left out of slicing
+            QSet<QUuid> m_skipped_parts;
+
             //! \brief A list of Slicers matched with their part indices
             QHash<int, QSharedPointer<BufferedSlicer>> m_mesh_slicers;
 
@@ -46,6 +46,22 @@ namespace ORNL
             //! \note index in vector corresponds to extruder number
             void connectPaths(QSharedPointer<SettingsBase> global_sb, QVector<Point> &start, QVector<int> &start_index, QVector<QVector<QSharedPointer<RegionBase>>> &previousRegions);
 
+            //! \brief returns true if connectPaths only depends on the start points and island indices passed in,
+            //!        and can be run again after resetPaths
+            //! \param global_sb - a reference to the global settings base
+            //! \note must be called before connectPaths
+            bool canReconnectPaths(QSharedPointer<SettingsBase> global_sb);
+
+            //! \brief drops the pathing made by connectPaths so it can be called again
+            void resetPaths();
+
+            //! \brief moves the start of the travel a nozzle enters this layer with
+            //! \param tool - the nozzle
+            //! \param from - the start point connectPaths was given for the nozzle
+            //! \param to - the new start point
+            //! \return false if the nozzle does not enter the layer with a travel from the given point
+            bool moveFirstTravel(int tool, const Point& from, const Point& to);
+
             //! \brief generates gcode
             //! \param the writer/syntax to use
             QString writeGCode(QSharedPointer<WriterBase> writer);
@@ -62,6 +78,15 @@ namespace ORNL
             //! \brief returns a list of all the islands, from all parts and step groups
             QVector<QSharedPointer<IslandBase>> getIslands();
 
+            //! \brief returns the islands in output order, indexed by nozzle
+            //! \note only populated once paths have been connected. Paths may still be in the slicing
+            //!       frame, call applyFrames first to read placed paths.
+            const QVector<QList<QSharedPointer<IslandBase>>>& getIslandOrder() const { return m_island_order; }
+
+            //! \brief moves the paths of every part by the frame its layer has queued
+            //! \note islands are reached through m_island_order here, not through the layers
+            void applyFrames();
+
             //! \brief returns the minimum z-coordinate found within the layer
             //! \note used primarily for determining table movement
             double getMinZ();
@@ -17,6 +17,9 @@ namespace ORNL {
             //! \param settings_polygons: a vector of settings polygons to apply
             AnchorIsland(const PolygonList& geometry, const QSharedPointer<SettingsBase>& sb, const QVector<SettingsPolygon>& settings_polygons);
 
+            //! \brief Copies the island and its regions.
+            QSharedPointer<IslandBase> clone() const override;
+
             //! \brief Override from base. Filters down to individual regions to add
             //! travels and apply path modifiers
             void optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions) override;
@@ -36,6 +36,10 @@ namespace ORNL {
             //! \brief Destructor.
             virtual ~IslandBase() = default;
 
+            //! \brief Copies the island and its regions.
+            //! \return an island that shares nothing it can change with this one
+            virtual QSharedPointer<IslandBase> clone() const = 0;
+
             //! \brief mark bridge for this island, the first segment of first region on island
             void markRegionStartSegment();
 
@@ -81,6 +85,20 @@ namespace ORNL {
             //! \brief rotates and then shifts the island by given amounts
             void transform(QQuaternion rotation, Point shift);
 
+            //! \brief Moves the outline of a copied island to another instance of its part. The regions stay where
+            //!        they were computed, optimizePlaced moves their paths once they are made.
+            //! \param rotation: rotation about the z axis from the computed instance to this one
+            //! \param shift: shift applied after the rotation
+            void place(const QQuaternion& rotation, const Point& shift);
+
+            //! \brief Calls optimize where the regions were computed and moves the resulting paths to where
+            //!        the island was placed. Islands that were never placed are optimized as is.
+            //! \param layerNumber: current layer number
+            //! \param currentLocation: Current point in space
+            //! \param previousRegions: sequence of previously visited regions
+            void optimizePlaced(int layerNumber, Point& currentLocation,
+                                QVector<QSharedPointer<RegionBase>>& previousRegions);
+
             //! \brief applies the conformal mapping
             //! \param parameterization: the UV map to map with
             //! \param the normal to shift by
@@ -123,6 +141,9 @@ namespace ORNL {
             int getExtruder();
 
         protected:
+            //! \brief Gives this island its own copy of every region, used after an island is copied
+            void detachRegions();
+
             //! \brief Geometry of island.
             PolygonList m_geometry;
 
@@ -146,6 +167,11 @@ namespace ORNL {
 
             //! \brief zero-indexed extruder # this island is assigned to
             int m_extruder;
+
+            //! \brief Rotation and shift from where the regions were computed to where the island was placed
+            QQuaternion m_placement_rotation;
+            Point m_placement_shift;
+            bool m_placed = false;
     };
 }  // namespace ORNL
 #endif  // ISLANDBASE_H
@@ -19,6 +19,9 @@ namespace ORNL {
             PolymerIsland(const PolygonList& geometry, const QSharedPointer<SettingsBase>& sb, const QVector<SettingsPolygon>& settings_polygons,
                           const SingleExternalGridInfo& gridInfo = SingleExternalGridInfo(), const PolygonList& uncut_geometry = PolygonList());
 
+            //! \brief Copies the island and its regions.
+            QSharedPointer<IslandBase> clone() const override;
+
             //! \brief Override from base. Filters down to individual regions to add
             //! travels and apply path modifiers
             void optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions) override;
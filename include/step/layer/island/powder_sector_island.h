@@ -31,6 +31,9 @@ namespace ORNL {
             //! \param settings_polygons: a vector of settings polygons to apply
             PowderSectorIsland(SectorInformation si, const QSharedPointer<SettingsBase>& sb, const QVector<SettingsPolygon>& settings_polygons);
 
+            //! \brief Copies the island and its regions.
+            QSharedPointer<IslandBase> clone() const override;
+
             //! \brief Override from base. Filters down to individual regions to add
             //! travels and apply path modifiers
             void optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions) override;
@@ -68,6 +68,13 @@ namespace ORNL {
             //! \brief shifts this layers in three axis to compensate for raft layers that where added
             void compensateForRafts();
 
+            //! \brief Replaces the islands with copies of the computed islands of a layer that slices the same,
+            //!        placed by a rigid transform. The outline and orientation of this layer are kept.
+            //! \param source: computed layer that slices the same
+            //! \param rotation: rotation about the z axis from the source to this layer
+            //! \param shift: shift applied after the rotation
+            void placeIslandsOf(const QSharedPointer<Layer>& source, const QQuaternion& rotation, const Point& shift);
+
             //! \brief returns the minimum z of a layer
             float getMinZ() override;
 
@@ -12,6 +12,9 @@ namespace ORNL {
             //! \param settings_polygons: a vector of settings polygons to apply
             Anchor(const QSharedPointer<SettingsBase>& sb, const QVector<SettingsPolygon>& settings_polygons);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
             //! \brief Writes the gcode for the raft.
             //! \param writer Writer type to use for gcode output
             QString writeGCode(QSharedPointer<WriterBase> writer) override;
@@ -14,6 +14,9 @@ namespace ORNL {
             //! \param settings_polygons: a vector of settings polygons to apply
             InfillSector(const QSharedPointer<SettingsBase>& sb, const int index, const QVector<SettingsPolygon>& settings_polygons);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
             //! \brief Writes the gcode for the perimeter.
             //! \param writer Writer type to use for gcode output
             QString writeGCode(QSharedPointer<WriterBase> writer) override;
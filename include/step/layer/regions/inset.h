@@ -3,6 +3,7 @@
 
 // Local
 #include "step/layer/regions/region_base.h"
+#include "geometry/settings_region_splitter.h"
 
 namespace ORNL {
     class Inset : public RegionBase {
@@ -14,6 +15,9 @@ namespace ORNL {
             //! \param gridInfo: optional external file information
             Inset(const QSharedPointer<SettingsBase>& sb, const int index, const QVector<SettingsPolygon>& settings_polygons, const SingleExternalGridInfo& gridInfo);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
             //! \brief Writes the gcode for the inset.
             //! \param writer Writer type to use for gcode output
             QString writeGCode(QSharedPointer<WriterBase> writer) override;
@@ -32,8 +36,9 @@ namespace ORNL {
 
             //! \brief Creates paths for the inset region.
             //! \param line: polyline representing path
+            //! \param splitter: settings polygons of the region, prepared once for every path
             //! \return Polyline converted to path
-            Path createPath(Polyline line);
+            Path createPath(Polyline line, const SettingsRegionSplitter& splitter);
 
             #ifdef HAVE_SINGLE_PATH
             //! \brief Sets the single path geometry
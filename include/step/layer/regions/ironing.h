@@ -13,6 +13,13 @@ namespace ORNL {
             //! \param gridInfo: optional external file information
             Ironing(const QSharedPointer<SettingsBase>& sb, const int index, const QVector<SettingsPolygon>& settings_polygons, const SingleExternalGridInfo& gridInfo);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
+            //! \brief Adds the geometry taken from the layers above to a hash.
+            //! \param hash: the hash to add to
+            void addComputeInputs(QCryptographicHash& hash) const override;
+
             //! \brief Writes the gcode for the perimeter.
             //! \param writer Writer type to use for gcode output
             QString writeGCode(QSharedPointer<WriterBase> writer) override;
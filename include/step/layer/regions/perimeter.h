@@ -3,6 +3,7 @@
 
 // Local
 #include "step/layer/regions/region_base.h"
+#include "geometry/settings_region_splitter.h"
 
 namespace ORNL {
     class Perimeter : public RegionBase {
@@ -16,6 +17,9 @@ namespace ORNL {
             Perimeter(const QSharedPointer<SettingsBase>& sb, const int index, const QVector<SettingsPolygon>& settings_polygons,
                       const SingleExternalGridInfo& gridInfo, PolygonList uncut_geometry);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
             //! \brief Writes the gcode for the perimeter.
             //! \param writer Writer type to use for gcode output
             QString writeGCode(QSharedPointer<WriterBase> writer) override;
@@ -39,8 +43,9 @@ namespace ORNL {
 
             //! \brief Creates paths for the perimeter region.
             //! \param line: polyline representing path
+            //! \param splitter: settings polygons of the region, prepared once for every path
             //! \return Polyline converted to path
-            Path createPath(Polyline line);
+            Path createPath(Polyline line, const SettingsRegionSplitter& splitter);
 
             #ifdef HAVE_SINGLE_PATH
             //! \brief Sets the single path geometry
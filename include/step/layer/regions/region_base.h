@@ -43,6 +43,15 @@ namespace ORNL {
             //! \brief Destructor
             virtual ~RegionBase() = default;
 
+            //! \brief Copies the region with its computed geometry and paths.
+            //! \return a region that shares nothing it can change with this one
+            virtual QSharedPointer<RegionBase> clone() const = 0;
+
+            //! \brief Adds what compute reads besides the outline and settings of the island to a hash, such as
+            //!        geometry handed over from neighboring layers.
+            //! \param hash: the hash to add to
+            virtual void addComputeInputs(QCryptographicHash& hash) const;
+
             //! \brief Writes the GCode for this region.
             //! \param writer: writer for gcode syntax
             virtual QString writeGCode(QSharedPointer<WriterBase> writer) = 0;
@@ -134,6 +143,9 @@ namespace ORNL {
             //! \param path: path to append
             void appendPath(const Path& path);
 
+            //! \brief Gives this region its own copy of every path segment, used after a region is copied
+            void detachPaths();
+
             //! \brief adds the modifiers for each region
             //! \param path: path to add modifiers to
             //! \param supportsG3: whether or not the system supports G3 command
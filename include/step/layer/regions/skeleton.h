@@ -51,6 +51,9 @@ namespace ORNL {
             Skeleton(const QSharedPointer<SettingsBase>& sb, const int index, const QVector<SettingsPolygon>& settings_polygons,
                      const SingleExternalGridInfo& gridInfo, bool iswireFed = false);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
             //! \brief Writes the gcode for the skeleton
             //! \param writer is the instance of the Writer Base to be used for writing skeleton region GCode
             QString writeGCode(QSharedPointer<WriterBase> writer);
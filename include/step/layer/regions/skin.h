@@ -15,6 +15,13 @@ namespace ORNL {
             //! \param gridInfo: optional external file information
             Skin(const QSharedPointer<SettingsBase>& sb, const int index, const QVector<SettingsPolygon>& settings_polygons, const SingleExternalGridInfo& gridInfo);
 
+            //! \brief Copies the region with its computed geometry and paths.
+            QSharedPointer<RegionBase> clone() const override;
+
+            //! \brief Adds the geometry taken from the layers above and below to a hash.
+            //! \param hash: the hash to add to
+            void addComputeInputs(QCryptographicHash& hash) const override;
+
             //! \brief Writes the gcode for the skin.
             //! \param writer Writer type to use for gcode output
             QString writeGCode(QSharedPointer<WriterBase> writer) override;
@@ -4,6 +4,7 @@
 // Qt
 #include <QObject>
 #include <QDir>
+#include <QQuaternion>
 
 // Local
 #include "gcode/writers/writer_base.h"
@@ -138,7 +139,16 @@ namespace ORNL {
             //! \return distance to shift
             QVector3D getRaftShift();
 
+            //! \brief Moves every island by the pending frame in a single pass and clears it.
+            //! \note Called before islands are read or changed, so callers always see placed paths.
+            void applyFrame();
+
         protected:
+            //! \brief Queues a rotation followed by a shift of every island. Queued transforms
+            //!        are composed into one frame, which applyFrame uses to move the paths once.
+            //! \param rotation: rotation about the origin
+            //! \param shift: shift applied after the rotation
+            void composeFrame(const QQuaternion& rotation, const Point& shift);
 
             //! \brief Settings for the step.
             QSharedPointer<SettingsBase> m_sb;
@@ -170,6 +180,11 @@ namespace ORNL {
         private:
             //! \brief bool that holds dirty status
             bool m_dirty_bit;
+
+            //! \brief rotation and shift queued for the islands, see composeFrame
+            QQuaternion m_frame_rotation;
+            Point m_frame_shift;
+            bool m_frame_pending;
     };
 }
 
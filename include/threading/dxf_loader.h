@@ -7,6 +7,7 @@
 #include <QRegularExpression>
 
 #include "gcode/gcode_command.h"
+#include "gcode/gcode_text_index.h"
 #include "utilities/enums.h"
 #include "graphics/base_view.h"
 #include "geometry/segment_base.h"
@@ -42,11 +43,9 @@ namespace ORNL
             void dxfLoadedVisualization(QVector<QVector<QSharedPointer<SegmentBase>>> layers);
 
             //! \brief signal to UI with info for text and text font color
-            //! \param text: text from file to display
-            //! \param fontColors: Hash with formats to define colors for all lines of text. Allows lookup for each line into the hash for appropriate format.
+            //! \param text: text from file to display, indexed by line, with the font color of each line
             //! \param layerFirstLineNumbers: line numbers for BEGINNING LAYER for each layer to jump the cursor to appropriate line when spinbox moves up and down.
-            //! \param layerSkipLineNumbers: line numbers to skip applying formatting to hash based on visualization settings
-            void dxfLoadedText(QString text, QHash<QString, QTextCharFormat> fontColors, QList<int> layerFirstLineNumbers, QSet<int> layerSkipLineNumbers);
+            void dxfLoadedText(GcodeTextIndex text, QList<int> layerFirstLineNumbers);
 
             //! \brief Emits error signal
             //! \param msg: Qstring error message
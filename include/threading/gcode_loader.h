@@ -4,8 +4,10 @@
 // Qt
 #include <QThread>
 #include <QTextCharFormat>
+#include <QCryptographicHash>
 
 #include "gcode/gcode_command.h"
+#include "gcode/gcode_text_index.h"
 #include "utilities/enums.h"
 #include "graphics/base_view.h"
 #include "geometry/segment_base.h"
@@ -40,12 +42,16 @@ namespace ORNL
             //! provided to OpenGL view
             void gcodeLoadedVisualization(QVector<QVector<QSharedPointer<SegmentBase>>> layers);
 
+            //! \brief signal to view with a fingerprint of everything each layer is drawn from. Sent just before
+            //! the layers, so the view can keep the geometry of layers that did not change since the last load.
+            //! \param keys: one key per layer
+            void gcodeLoadedLayerKeys(QVector<QByteArray> keys);
+
             //! \brief signal to UI with info for text and text font color
-            //! \param text: text from file to display
-            //! \param fontColors: Hash with formats to define colors for all lines of text. Allows lookup for each line into the hash for appropriate format.
+            //! \param text: text from file to display, indexed by line, with the font color of each line.
+            //! Lines skipped based on visualization settings are left uncolored.
             //! \param layerFirstLineNumbers: line numbers for BEGINNING LAYER for each layer to jump the cursor to appropriate line when spinbox moves up and down.
-            //! \param layerSkipLineNumbers: line numbers to skip applying formatting to hash based on visualization settings
-            void gcodeLoadedText(QString text, QHash<QString, QTextCharFormat> fontColors, QList<int> layerFirstLineNumbers, QSet<int> layerSkipLineNumbers);
+            void gcodeLoadedText(GcodeTextIndex text, QList<int> layerFirstLineNumbers);
 
             //! \brief Emits error signal
             //! \param msg: Qstring error message
@@ -123,6 +129,18 @@ namespace ORNL
                                                                        const QMap<char, double>& parameters, QVector<bool> extruders_on, QVector<Point> extruder_offsets,
                                                                        double extruders_speed, bool is_travel, const QString comment, const QMap<char, double>& optional_parameters = QMap<char, double>());
 
+            //! \brief adds everything the geometry of a layer depends on, besides its commands, to a hash:
+            //! the position and table offset it starts from and the widths, offsets and colors of this load
+            //! \param hash: hash of the layer
+            void addLayerStartInputs(QCryptographicHash& hash);
+
+            //! \brief adds the inputs of generateVisualSegment for a command to a hash
+            //! \param hash: hash of the layer
+            //! \param command: the command
+            //! \param color: color the command is drawn in
+            //! \param is_travel: if travels are drawn for this command
+            void addCommandInputs(QCryptographicHash& hash, GcodeCommand& command, const QColor& color, bool is_travel);
+
             //! \brief Filename.
             QString m_filename;
 
@@ -0,0 +1,210 @@
+#ifndef GCODE_STREAMER_H
+#define GCODE_STREAMER_H
+
+// C++
+#include <deque>
+
+// Qt
+#include <QObject>
+#include <QThread>
+#include <QFile>
+#include <QQueue>
+#include <QVector>
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Local
+#include "net_functions/printer_transport.h"
+
+namespace ORNL
+{
+    /*!
+     * \class GCodeStreamer
+     * \brief Host side of a line-numbered, checksummed g-code stream to a printer.
+     *
+     * Lines are read from the output file as they are needed and sent through a
+     * PrinterTransport. The number of unacknowledged lines is bounded by a window
+     * modelled on the firmware: a fixed number of lines that fit in its command
+     * queue, plus as many further lines as fit in its serial receive buffer.
+     * Every "ok" retires the oldest line in flight and "Resend: N" rewinds the
+     * stream to line N from a history of recently sent lines.
+     *
+     * \note This object lives on its own thread. Call its slots through queued
+     * connections or QMetaObject::invokeMethod.
+     */
+    class GCodeStreamer : public QObject
+    {
+        Q_OBJECT
+        public:
+            //! \brief Constructor
+            GCodeStreamer();
+
+            //! \brief Destructor
+            ~GCodeStreamer();
+
+        public slots:
+            //! \brief Connects to a printer
+            //! \param url: transport url, see PrinterTransport::Create
+            void openConnection(const QString& url);
+
+            //! \brief Drops the connection and any stream in progress
+            void closeConnection();
+
+            //! \brief Sets the flow control window
+            //! \param queue_lines: number of lines the firmware command queue holds (Marlin BUFSIZE)
+            //! \param rx_bytes: size of the firmware serial receive buffer in bytes, 0 to disable byte counting
+            void setWindow(int queue_lines, int rx_bytes);
+
+            //! \brief Starts streaming a g-code file
+            //! \param path: file to stream
+            void streamFile(const QString& path);
+
+            //! \brief Stops pulling lines from the file. Lines already in flight complete.
+            void pause();
+
+            //! \brief Resumes a paused stream
+            void resume();
+
+            //! \brief Stops the stream. Lines already in flight complete.
+            void abort();
+
+            //! \brief Queues a single command ahead of any remaining file lines
+            //! \param command: g-code command without line number or checksum
+            void sendCommand(const QString& command);
+
+            //! \brief Sends M112 immediately, bypassing the window, and drops the stream
+            void emergencyStop();
+
+        signals:
+            //! \brief Emitted when the connection opens or closes
+            //! \param connected: whether the printer is ready for commands
+            void connectionChanged(bool connected);
+
+            //! \brief Emitted when a file stream starts or ends
+            //! \param streaming: whether a file is being streamed
+            void streamingChanged(bool streaming);
+
+            //! \brief Forwards printer output other than plain acknowledgements
+            //! \param line: line received from the printer
+            void response(const QString& line);
+
+            //! \brief Periodic throughput report
+            //! \param lines_per_second: acknowledged lines per second over the last interval
+            //! \param planner_occupancy: fraction of the planner buffer in use, or -1 if the firmware does not report it
+            //! \param in_flight: lines sent but not yet acknowledged
+            //! \param progress: fraction of the file read
+            //! \param starved_count: acknowledgements that reported an empty planner while lines were still available
+            void statistics(double lines_per_second, double planner_occupancy, int in_flight, double progress, int starved_count);
+
+            //! \brief Emitted when the whole file has been acknowledged
+            //! \param lines: number of file lines sent
+            //! \param seconds: wall time of the stream
+            void finished(qint64 lines, double seconds);
+
+            //! \brief Emitted on connection or protocol failure
+            //! \param msg: description of the failure
+            void error(const QString& msg);
+
+        private:
+            //! \brief A line that has been sent but not acknowledged
+            struct InFlightLine
+            {
+                qint64 number;
+                int bytes;
+            };
+
+            //! \brief Called once the printer has answered, or after the start-up grace period
+            void onReady();
+
+            //! \brief Dispatches a line received from the printer
+            void onLine(const QByteArray& line);
+
+            //! \brief Handles an acknowledgement
+            void onOk(const QByteArray& line);
+
+            //! \brief Handles a resend request
+            void onResend(qint64 line_number);
+
+            //! \brief Sends lines until the window is full or nothing is left
+            void fill();
+
+            //! \brief Whether another line of the given size fits in the window
+            bool windowAllows(int bytes) const;
+
+            //! \brief Returns the next command to number and send, or an empty array if there is none
+            QByteArray nextCommand();
+
+            //! \brief Assigns the next line number to a command and records the framed line in the history
+            void assign(const QByteArray& command);
+
+            //! \brief Ends the stream once every file line has been acknowledged
+            void checkFinished();
+
+            //! \brief Ends the current file stream
+            void endStream();
+
+            //! \brief Emits current statistics
+            void reportStatistics();
+
+            //! \brief Strips comments and surrounding whitespace from a file line
+            static QByteArray clean(const QByteArray& line);
+
+            //! \brief internal thread
+            QThread m_internal_thread;
+
+            //! \brief active transport, owned by this object
+            PrinterTransport* m_transport = nullptr;
+
+            //! \brief whether the printer has answered and accepts commands
+            bool m_ready = false;
+
+            //! \brief incremented on each connection to invalidate stale timers
+            int m_connection_generation = 0;
+
+            //! \brief window parameters
+            int m_queue_lines = 4;
+            int m_rx_bytes = 127;
+
+            //! \brief file being streamed
+            QFile m_file;
+            bool m_streaming = false;
+            bool m_paused = false;
+            qint64 m_file_lines = 0;
+            QElapsedTimer m_stream_timer;
+
+            //! \brief commands queued by sendCommand
+            QQueue<QByteArray> m_immediate;
+
+            //! \brief ring of framed lines indexed by line number, kept for resends
+            QVector<QByteArray> m_history;
+
+            //! \brief next line number to assign
+            qint64 m_next_line = 0;
+
+            //! \brief next line number to send. Less than m_next_line while rewinding after a resend.
+            qint64 m_send_cursor = 0;
+
+            //! \brief lines in flight, oldest first
+            std::deque<InFlightLine> m_in_flight;
+
+            //! \brief acknowledgements that belong to resend requests rather than lines
+            int m_skip_oks = 0;
+
+            //! \brief line of the most recent rewind. Repeated requests for it are stale until it has been resent.
+            qint64 m_last_resend = -1;
+
+            //! \brief throughput tracking
+            QTimer* m_statistics_timer;
+            QElapsedTimer m_statistics_clock;
+            qint64 m_acknowledged = 0;
+            qint64 m_acknowledged_at_report = 0;
+            double m_lines_per_second = 0.0;
+
+            //! \brief planner reporting from advanced "ok" responses
+            int m_planner_free = -1;
+            int m_planner_capacity = -1;
+            int m_starved_count = 0;
+    };
+}
+
+#endif // GCODE_STREAMER_H
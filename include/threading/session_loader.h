@@ -19,6 +19,12 @@ namespace ORNL {
     /*!
      * \class SessionLoader
      * \brief Saves or loads a session file in a separate thread.
+     *
+     * Models are compressed once and stored under the hash of their contents, so
+     * saving over an earlier save of the same session only writes models that
+     * changed along with the settings. G-code is kept with the hash of the
+     * inputs it was sliced from, so reopening a sliced session and slicing
+     * again without changes skips computation.
      * \todo The session saving and loading needs some cleanup.
      */
     class SessionLoader : public QThread {
@@ -56,6 +62,9 @@ namespace ORNL {
             //! \param key: the name of the file
             std::string loadStringFromZip(struct zip_t*, const std::string& key);
 
+            //! \brief Version of the stored g-code entry. Entries of other versions are ignored.
+            static constexpr int kToolpathVersion = 1;
+
             //! \brief Filename this loader thread will work on.
             QString m_filename;
 
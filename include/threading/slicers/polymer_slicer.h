@@ -4,6 +4,8 @@
 // Local
 #include "threading/traditional_ast.h"
 #include "step/global_layer.h"
+#include "slicing/part_instancing.h"
+#include "slicing/layer_reuse.h"
 
 //#include "slicing/preprocessor.h"
 //#include "slicing/buffered_slicer.h"
@@ -30,6 +32,12 @@ namespace ORNL {
             //! \param global_sb: global settings base
             void spiralizeLayers(QSharedPointer<SettingsBase> global_sb);
 
+            //! \brief Spirals each path of a shell toward the path above it
+            //! \param paths: closed paths of one shell, ordered bottom to top. Upper paths are rotated to start at
+            //!        the point the spiral arrives at.
+            //! \return spiral path made from all but the last path of the shell
+            static Path spiralizeShell(QVector<Path>& paths);
+
             //! \brief Exports spiral visualization files to temp gcode directory
             void exportSpiralVisFiles();
 
@@ -121,6 +129,12 @@ namespace ORNL {
             //! \brief list of global layers
             QList<QSharedPointer<GlobalLayer>> m_global_layers;
 
+            //! \brief build parts that take the layers of an identical part instead of being sliced
+            QVector<PartInstancing::Instance> m_part_instances;
+
+            //! \brief layers that take the islands of an earlier layer of their part instead of being computed
+            QVector<LayerReuse::Repeat> m_layer_repeats;
+
             //! \brief cached layer settings
             QList<QSharedPointer<SettingsBase>> m_saved_layer_settings;
 
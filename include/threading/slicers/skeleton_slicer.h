@@ -34,6 +34,11 @@ namespace ORNL
             void writeGCode();
 
         private:
+            //! \brief turns the cross-sections of every layer into paths, layers are built in parallel
+            //! \param layer_polylines: open and closed contours of each layer, in print order
+            //! \note all segments share one settings base holding the global perimeter settings
+            void buildLayers(const QVector<QVector<Polyline>>& layer_polylines);
+
             //! \typedef SkeletonLayer
             //! \brief a simple list of paths that make up a layer
             typedef QVector<Path> SkeletonLayer;
@@ -844,6 +844,9 @@ namespace ORNL
                 static const QString kEnableSecondCustomLocation;
                 static const QString kCustomPointSecondXLocation;
                 static const QString kCustomPointSecondYLocation;
+                static const QString kPathConnectionMode;
+                static const QString kPartInstancing;
+                static const QString kLayerReuse;
 
             };
 
@@ -1060,6 +1063,8 @@ namespace ORNL
                 static const QString kSandiaOutput;
                 static const QString kMarlinOutput;
                 static const QString kMarlinTravels;
+                static const QString kToolpathBinaryOutput;
+                static const QString kToolpathBinaryCompression;
             };
 
             class RotationOrigin
@@ -1123,6 +1128,16 @@ namespace ORNL
                     static const std::string kLocal;
                     static const std::string kPref;
                     static const std::string kModel;
+                    static const std::string kBlob;
+                    static const std::string kModels;
+                    static const std::string kToolpath;
+                };
+                class ToolpathFile
+                {
+                public:
+                    static const std::string kVersion;
+                    static const std::string kInputs;
+                    static const std::string kBlob;
                 };
             };
 
@@ -644,6 +644,37 @@ namespace ORNL
     //! \brief Function for going from OrderOptimization to json
     void from_json(const json& j, PathOrderOptimization& i);
 
+    /*!
+     * \enum  PathConnectionMode
+     * \brief How the paths of consecutive layers are connected in post processing
+     *
+     * kSequential connects one layer after another. kSpeculative connects layers in
+     * parallel from a predicted start point and connects again where the prediction
+     * missed, with output identical to kSequential. kSpeculativeRelaxed moves the first
+     * travel of a missed layer instead, so only the first move of a layer may differ.
+     */
+    enum class PathConnectionMode : uint8_t
+    {
+        kSequential = 0,
+        kSpeculative = 1,
+        kSpeculativeRelaxed = 2
+    };
+
+    /*!
+     * \enum  PartInstancingMode
+     * \brief Which build parts are sliced once and placed as copies of an identical part
+     *
+     * kTranslated takes parts with the same mesh and settings that are only moved
+     * across the build plate. kTranslatedAndRotated also takes parts turned about
+     * the z axis, whose patterns then turn with the part instead of staying fixed.
+     */
+    enum class PartInstancingMode : uint8_t
+    {
+        kOff = 0,
+        kTranslated = 1,
+        kTranslatedAndRotated = 2
+    };
+
     enum class Axis : uint8_t
     {
         kX,
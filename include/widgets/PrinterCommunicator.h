@@ -3,25 +3,70 @@
 
 #include <QObject>
 
+#include "threading/gcode_streamer.h"
+#include "net_functions/simulated_printer.h"
+
 
 namespace ORNL {
 
+    /*!
+     * \class PrinterCommunicator
+     * \brief GUI-side handle to the printer streaming host. Forwards requests to a
+     * GCodeStreamer running on its own thread and relays its reports back.
+     *
+     * Printer addresses are transport urls (see PrinterTransport::Create) or
+     * sim://localhost?rate=2000&planner=16&queue=4&transport=tcp&errors=0
+     * to start a SimulatedPrinter and connect to it.
+     */
     class PrinterCommunicator : public QObject
 {
     Q_OBJECT
 
 public:
     explicit PrinterCommunicator(QObject *parent = nullptr);
+    ~PrinterCommunicator();
 
     // 发送命令到3D打印机的函数
     void sendCommand(const QString &command);
 
+    //! \brief Connects to a printer or starts and connects to a simulated one
+    //! \param address: printer address
+    void connectToPrinter(const QString &address);
+
+    //! \brief Drops the connection and stops any simulated printer
+    void disconnectFromPrinter();
+
+    //! \brief Streams a g-code file to the connected printer
+    //! \param path: file to stream
+    void streamFile(const QString &path);
+
+    //! \brief Pauses, resumes or stops the current stream
+    void pauseStream();
+    void resumeStream();
+    void stopStream();
+
+    //! \brief Sends M112 ahead of everything else
+    void emergencyStop();
+
+    //! \brief Sets the flow control window, see GCodeStreamer::setWindow
+    void setWindow(int queue_lines, int rx_bytes);
+
 signals:
     void printerResponse(const QString &response);  // 从打印机接收到响应
 
+    //! \brief Relayed from GCodeStreamer
+    void connectionChanged(bool connected);
+    void streamingChanged(bool streaming);
+    void statistics(double lines_per_second, double planner_occupancy, int in_flight, double progress, int starved_count);
+    void finished(qint64 lines, double seconds);
+    void error(const QString &msg);
+
 private:
-    // 模拟与打印机的通信接口
-    void mockPrinterCommunication(const QString &command);  // 这里你可以替换成实际的通信代码
+    //! \brief streaming host, lives on its own thread
+    GCodeStreamer *m_streamer;
+
+    //! \brief simulated printer, created on demand for sim:// addresses
+    SimulatedPrinter *m_simulator = nullptr;
 };
 
 
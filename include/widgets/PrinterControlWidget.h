@@ -38,6 +38,11 @@ class PrinterControlWidget : public QWidget{
     QPushButton *m_disableButton;
 
 
+    QLineEdit *m_addressInput;  // printer address, see PrinterCommunicator
+    QLabel *m_streamStatusLabel; // throughput and planner occupancy while streaming
+    QString m_gcodePath;         // file streamed by Start Print
+    bool m_connected = false;
+
     QLineEdit *m_xInput;
     QLineEdit *m_yInput;
     QLineEdit *m_zInput;
@@ -50,10 +55,6 @@ class PrinterControlWidget : public QWidget{
     QLabel *m_tempLabel4;
     QTimer *m_timer;      // 定时器，用于定时更新温度
 
-    // 模拟获取硬件温度的函数，实际使用中可以替换为实际硬件接口
-    double getHardwareTemperature();
-
-
     // 初始化UI布局
     void setupLayout();
 
@@ -65,6 +66,10 @@ class PrinterControlWidget : public QWidget{
     void startPrint();
     void stopPrint();
     void updateTemperature();  // 更新温度的槽函数
+    void enablePrinter();
+    void disablePrinter();
+    void loadPath();
+    void onStatistics(double lines_per_second, double planner_occupancy, int in_flight, double progress, int starved_count);
 
     // 用于处理与打印机的通信
     void onPrinterResponse(const QString &response);
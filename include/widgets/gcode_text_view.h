@@ -0,0 +1,137 @@
+#ifndef GCODE_TEXT_VIEW_H
+#define GCODE_TEXT_VIEW_H
+
+// Qt
+#include <QAbstractScrollArea>
+#include <QSet>
+
+// Local
+#include "gcode/gcode_text_index.h"
+
+namespace ORNL
+{
+    /*!
+     * \class GcodeTextView
+     * \brief Read-only g-code view for programs too large for a text document.
+     *
+     * Only the lines inside the viewport are turned into strings, each time
+     * they are painted. Scrolling, going to a line and coloring a line are
+     * constant time lookups into a GcodeTextIndex. Line highlighting, layer
+     * jumps and search behave like GcodeTextBoxWidget.
+     */
+    class GcodeTextView : public QAbstractScrollArea
+    {
+        Q_OBJECT
+
+    public:
+        //! \brief Constructor
+        //! \param parent: parent widget
+        GcodeTextView(QWidget* parent = nullptr);
+
+        //! \brief Shows a program
+        //! \param text: indexed program text with line colors
+        void setContents(const GcodeTextIndex& text);
+
+        //! \brief Shows nothing
+        void clear();
+
+        //! \brief The program shown
+        const GcodeTextIndex& contents() const;
+
+        //! \brief Highlights and unhighlights lines
+        //! \param linesToAdd: lines to highlight
+        //! \param linesToRemove: lines to unhighlight
+        //! \param shouldCenter: whether or not to center the view on added lines
+        void highlightLine(QList<int> linesToAdd, QList<int> linesToRemove, bool shouldCenter);
+
+        //! \brief Resets the highlighted info after new gcode is parsed
+        void resetHighlight();
+
+        //! \brief Updates layer beginning line numbers for all layers
+        //! \param firstLineNumbers: first line number of every layer
+        void setLayerFirstLineNumbers(QList<int>& firstLineNumbers);
+
+        //! \brief Moves the cursor to a line and puts it on top unless the move is manual
+        //! \param line_number: one based line number
+        void moveCursorToLine(int line_number);
+
+        //! \brief Whether the last cursor move came from a click or an arrow key
+        bool getCursorManualMove();
+
+        //! \brief Sets the manual cursor move flag back to false
+        void setCursorManualMoveFalse();
+
+        //! \brief Searches the program
+        //! \param searchString: the search string
+        //! \param searchCount: the number of Enter/Return hits for the same search string
+        void search(QString searchString, int searchCount);
+
+    signals:
+        //! \brief Signal to indicate a text line was highlighted/unhighlighted
+        //! \param linesToAdd: Segments to highlight
+        //! \param linesToRemove: Segments to unhighlight
+        void lineChange(QList<int> linesToAdd, QList<int> linesToRemove);
+
+    protected:
+        //! \brief Paints the visible lines and their numbers
+        void paintEvent(QPaintEvent* event) override;
+
+        //! \brief Overrides for resizing, scrolling, mouse, and keys
+        void resizeEvent(QResizeEvent* event) override;
+        void scrollContentsBy(int dx, int dy) override;
+        void mousePressEvent(QMouseEvent* event) override;
+        void mouseReleaseEvent(QMouseEvent* event) override;
+        void keyPressEvent(QKeyEvent* event) override;
+
+    private:
+        //! \brief Line under a viewport y coordinate, clamped to the program
+        int lineAt(int y) const;
+
+        //! \brief Number of lines that fit in the viewport
+        int visibleLineCount() const;
+
+        //! \brief Width of the line number column
+        int gutterWidth() const;
+
+        //! \brief Updates scroll bar ranges to the program and viewport size
+        void updateScrollBars();
+
+        //! \brief Scrolls as little as needed to show a line
+        void ensureLineVisible(int line);
+
+        //! \brief Whether a line is inside the viewport
+        bool isLineVisible(int line) const;
+
+        //! \brief Program text and line colors
+        GcodeTextIndex m_text;
+
+        //! \brief Line holding the cursor
+        int m_cursor_line;
+
+        //! \brief Line the mouse was pressed on, used to detect drag selections
+        int m_press_line;
+
+        //! \brief Last line clicked on, anchor for shift clicks
+        int m_last_line_clicked_on;
+
+        //! \brief Highlighted lines
+        QSet<int> m_selected_lines;
+
+        //! \brief "BEGINNING LAYER" line numbers for all layers
+        QList<int> m_layer_first_line_numbers;
+
+        //! \brief Whether the cursor move is manual, such as a click or up/down arrow
+        bool m_manual_cursor_move;
+
+        //! \brief Saved search string
+        QString m_search_string;
+
+        //! \brief Lines matching the last search, in ascending order
+        QVector<int> m_matched_lines;
+
+        //! \brief Index in m_matched_lines of the focused match
+        int m_cursor_index;
+    };
+}  // namespace ORNL
+
+#endif  // GCODE_TEXT_VIEW_H
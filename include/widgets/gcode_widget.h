@@ -37,6 +37,8 @@ namespace ORNL {
         public slots:
             //! \brief Adds the GCode to the view after it has been loaded.
             void addGCode(QVector<QVector<QSharedPointer<SegmentBase>>> gcode);
+            //! \brief Passes the keys of the layers that are added next to the view.
+            void setLayerKeys(QVector<QByteArray> keys);
             //! \brief Clears the GCode in the view.
             void clear();
             //! \brief Uses an orthographic projection in place of the standard perspective.
@@ -12,9 +12,11 @@
 #include <QCheckBox>
 #include <QGridLayout>
 #include <QTimer>
+#include <QStackedWidget>
 
 // Local
 #include "widgets/gcodetextboxwidget.h"
+#include "widgets/gcode_text_view.h"
 #include "utilities/enums.h"
 
 namespace ORNL {
@@ -58,11 +60,9 @@ namespace ORNL {
 
         public slots:
             //! \brief necessary information passing to GcodeBar object after gcode loading
-            //! \param text: GCode content
-            //! \param fontColors: hash that contains color/highlight information for all lines
+            //! \param text: GCode content with the color of every line
             //! \param layerFirstLineNumbers: layer numbers for all layer beginning lines
-            //! \param layerSkipLineNumbers: line numbers to skip highlighting if visualization reduction setting is enabled
-            void updateGcodeText(QString text, QHash<QString, QTextCharFormat> fontColors, QList<int> layerFirstLineNumbers, QSet<int> layerSkipLineNumbers);
+            void updateGcodeText(GcodeTextIndex text, QList<int> layerFirstLineNumbers);
 
             //! \brief Clear GcodeBar
             void clear();
@@ -164,6 +164,8 @@ namespace ORNL {
             QLineEdit *m_search_bar;
             QToolButton *m_refresh_btn;
             GcodeTextBoxWidget *m_view;
+            GcodeTextView *m_large_view;
+            QStackedWidget *m_view_stack;
             QComboBox *m_view_sel;
             QCheckBox *m_hide_travel;
             QCheckBox *m_hide_support;
@@ -199,6 +201,13 @@ namespace ORNL {
             //! \brief number of Enter/Return hits, reset to 0 upon GCode loading
             int m_search_count;
 
+            //! \brief whether the loaded GCode is shown in the read-only m_large_view instead of m_view
+            bool m_use_large_view;
+
+            //! \brief programs with more lines are shown read-only, a text document holding them
+            //! would take minutes to lay out and gigabytes of memory
+            static constexpr int kMaxEditableLines = 200000;
+
             //! \brief If layers are locked, distance between lower/upper bound
             int m_lock_distance;
     };
@@ -4,6 +4,9 @@
 // Qt
 #include <QSyntaxHighlighter>
 
+// Local
+#include "gcode/gcode_text_index.h"
+
 class QTextDocument;
 
 namespace ORNL
@@ -20,21 +23,20 @@ namespace ORNL
         GcodeHighlighter(QTextDocument* parent);
 
         //! \brief Sets rules for coloring
-        //! \param colorHash: Hash of individual lines and associated color based on gcode comments
-        //! \param layerSkipLineNumbers: lines to skip coloring even if a match is found in the hash
-        //! due to visualization reduction settings being enabled
-        void setColorRules(QHash<QString, QTextCharFormat> colorHash, QSet<int> layerSkipLineNumbers);
+        //! \param lineColors: color of each line by line number, lines skipped due to
+        //! visualization reduction settings are left uncolored
+        void setColorRules(const GcodeTextIndex& lineColors);
 
     protected:
         //! \brief Line highlight override
         void highlightBlock(const QString& text) override;
 
     private:
-        //! \brief Hash holding gcode line as key with associated format
-        QHash<QString, QTextCharFormat> m_color_hash;
+        //! \brief Color index of each line
+        GcodeTextIndex m_line_colors;
 
-        //! \brief Set of lines to skip even if found in hash
-        QSet<int> m_layer_skip_numbers;
+        //! \brief Format for each palette entry of m_line_colors
+        QVector<QTextCharFormat> m_formats;
     };
 }  // namespace ORNL
 #endif  // GCODEHIGHLIGHTER_H
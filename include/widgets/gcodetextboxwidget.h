@@ -61,10 +61,8 @@ namespace ORNL
 
         //! \brief This function forwards the font colors for all gcode text as
         //! determined during the file parse
-        //! \param fontColors: keys are the lines of gcode text while values are the font color
-        //! for that line (used by gcode highlighter)
-        //! \param layerSkipLineNumbers: line numbers to skip highlighting if visualization reduction setting is enabled
-        void setHighlighterColors(QHash<QString, QTextCharFormat> fontColors, QSet<int> layerSkipLineNumbers);
+        //! \param lineColors: color of each line by line number (used by gcode highlighter)
+        void setHighlighterColors(const GcodeTextIndex& lineColors);
 
         //! \brief update layer beginning line numbers for all layers
         //! \param firstLineNumbers a vector containing first line number for all layers
@@ -0,0 +1,183 @@
+#include "external_files/exporters/toolpath_exporter.h"
+
+// Qt
+#include <QtEndian>
+#include <QVector3D>
+
+// Local
+#include "geometry/path.h"
+#include "geometry/segment_base.h"
+#include "step/global_layer.h"
+#include "step/layer/regions/region_base.h"
+#include "utilities/constants.h"
+
+namespace ORNL
+{
+    ToolpathExporter::ToolpathExporter(QString filename, bool compress, int chunk_size)
+        : m_file(filename), m_compress(compress), m_chunk_size(qMax(1, chunk_size))
+    {
+        m_columns.reserve(m_chunk_size);
+    }
+
+    ToolpathExporter::~ToolpathExporter()
+    {
+        close();
+    }
+
+    bool ToolpathExporter::open()
+    {
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return false;
+
+        const QVector<ToolpathColumns::Column>& layout = ToolpathColumns::layout();
+
+        QByteArray header;
+        header.append(ToolpathFormat::kMagic, sizeof(ToolpathFormat::kMagic));
+
+        uchar buffer[4];
+        qToLittleEndian<quint16>(ToolpathFormat::kVersion, buffer);
+        header.append(reinterpret_cast<char*>(buffer), 2);
+        qToLittleEndian<quint16>(m_compress ? ToolpathFormat::kCompressed : 0, buffer);
+        header.append(reinterpret_cast<char*>(buffer), 2);
+        qToLittleEndian<quint32>(layout.size(), buffer);
+        header.append(reinterpret_cast<char*>(buffer), 4);
+
+        for (const ToolpathColumns::Column& column : layout)
+        {
+            QByteArray name(column.name);
+            header.append(char(column.type));
+            header.append(char(name.size()));
+            header.append(name);
+        }
+
+        m_time = 0.0;
+        m_segment_count = 0;
+        m_cached_sb = nullptr;
+
+        return m_file.write(header) == header.size();
+    }
+
+    void ToolpathExporter::close()
+    {
+        if (!m_file.isOpen())
+            return;
+
+        flushChunk();
+        m_file.close();
+    }
+
+    void ToolpathExporter::appendLayer(QSharedPointer<GlobalLayer> layer, int layer_index)
+    {
+        layer->applyFrames();
+        const QVector<QList<QSharedPointer<IslandBase>>>& island_order = layer->getIslandOrder();
+        for (int tool = 0, end = island_order.size(); tool < end; ++tool)
+        {
+            for (const QSharedPointer<IslandBase>& island : island_order[tool])
+            {
+                for (const QSharedPointer<RegionBase>& region : island->getRegions())
+                {
+                    for (Path& path : region->getPaths())
+                        appendPath(path, layer_index, tool);
+                }
+            }
+        }
+    }
+
+    void ToolpathExporter::appendPath(Path& path, int layer_index, int tool)
+    {
+        for (const QSharedPointer<SegmentBase>& segment : path.getSegments())
+            appendSegment(segment, layer_index, tool);
+    }
+
+    void ToolpathExporter::appendSegment(const QSharedPointer<SegmentBase>& segment, int layer_index, int tool)
+    {
+        // settings lookups go through json, so only repeat them when the settings base changes
+        SettingsBase* sb = segment->getSb().data();
+        if (sb != m_cached_sb)
+        {
+            m_cached_sb = sb;
+            m_cached_width = sb->setting<Distance>(Constants::SegmentSettings::kWidth)();
+            m_cached_height = sb->setting<Distance>(Constants::SegmentSettings::kHeight)();
+            m_cached_speed = sb->setting<Velocity>(Constants::SegmentSettings::kSpeed)();
+            m_cached_region = quint16(sb->setting<RegionType>(Constants::SegmentSettings::kRegionType));
+
+            QVector<QVector3D> tilt = sb->setting<QVector<QVector3D>>(Constants::SegmentSettings::kTilt);
+            QVector3D normal = tilt.isEmpty() ? QVector3D(0, 0, 1) : tilt.first();
+            m_cached_normal[0] = normal.x();
+            m_cached_normal[1] = normal.y();
+            m_cached_normal[2] = normal.z();
+        }
+
+        Point start = segment->start();
+        Point end = segment->end();
+
+        if (m_cached_speed > 0.0f)
+            m_time += segment->length()() / m_cached_speed;
+
+        m_columns.start_x.append(start.x());
+        m_columns.start_y.append(start.y());
+        m_columns.start_z.append(start.z());
+        m_columns.end_x.append(end.x());
+        m_columns.end_y.append(end.y());
+        m_columns.end_z.append(end.z());
+        m_columns.width.append(m_cached_width);
+        m_columns.height.append(m_cached_height);
+        m_columns.speed.append(m_cached_speed);
+        m_columns.region_type.append(m_cached_region);
+        m_columns.printing.append(segment->isPrintingSegment() ? 1 : 0);
+        m_columns.tool.append(quint16(tool));
+        m_columns.layer.append(quint32(layer_index));
+        m_columns.time.append(m_time);
+        m_columns.normal_x.append(m_cached_normal[0]);
+        m_columns.normal_y.append(m_cached_normal[1]);
+        m_columns.normal_z.append(m_cached_normal[2]);
+
+        ++m_segment_count;
+        if (m_columns.size() >= m_chunk_size)
+            flushChunk();
+    }
+
+    qint64 ToolpathExporter::segmentCount() const
+    {
+        return m_segment_count;
+    }
+
+    void ToolpathExporter::flushChunk()
+    {
+        int count = m_columns.size();
+        if (count == 0 || !m_file.isOpen())
+            return;
+
+        uchar buffer[4];
+        qToLittleEndian<quint32>(count, buffer);
+        m_file.write(reinterpret_cast<char*>(buffer), 4);
+
+        const QVector<ToolpathColumns::Column>& layout = ToolpathColumns::layout();
+        for (int column = 0, end = layout.size(); column < end; ++column)
+        {
+            char* data = m_columns.columnData(column);
+            ToolpathFormat::convertByteOrder(data, count, layout[column].type);
+            writeColumn(data, count * ToolpathFormat::elementSize(layout[column].type));
+        }
+
+        m_columns.clear();
+    }
+
+    void ToolpathExporter::writeColumn(const char* data, int bytes)
+    {
+        uchar buffer[4];
+        if (m_compress)
+        {
+            QByteArray compressed = qCompress(reinterpret_cast<const uchar*>(data), bytes, 1);
+            qToLittleEndian<quint32>(compressed.size(), buffer);
+            m_file.write(reinterpret_cast<char*>(buffer), 4);
+            m_file.write(compressed);
+        }
+        else
+        {
+            qToLittleEndian<quint32>(bytes, buffer);
+            m_file.write(reinterpret_cast<char*>(buffer), 4);
+            m_file.write(data, bytes);
+        }
+    }
+}
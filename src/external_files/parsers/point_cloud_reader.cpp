@@ -0,0 +1,331 @@
+#include "external_files/parsers/point_cloud_reader.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Qt
+#include <QThread>
+
+namespace ORNL
+{
+    namespace
+    {
+        //! \brief Smallest chunk handed to a thread, smaller files are parsed in one piece
+        constexpr qint64 kMinChunkSize = 1 << 20;
+
+        //! \brief Parses a decimal number starting at p. Locale independent, unlike
+        //! strtod, which follows the application locale once Qt has set it.
+        //! \param p: start of the number, moved past it on success
+        //! \param end: end of the text
+        //! \param value: set to the number
+        //! \return false if no number starts at p
+        bool parseNumber(const char*& p, const char* end, double& value)
+        {
+            const char* s = p;
+            bool negative = false;
+            if (s < end && (*s == '-' || *s == '+'))
+            {
+                negative = (*s == '-');
+                ++s;
+            }
+
+            //! Keep 19 significant digits, which still fit the mantissa accumulator
+            quint64 mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            bool found_digit = false;
+
+            for (; s < end && *s >= '0' && *s <= '9'; ++s)
+            {
+                found_digit = true;
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + (*s - '0');
+                    if (mantissa != 0)
+                        ++digits;
+                }
+                else
+                    ++exponent;
+            }
+
+            if (s < end && *s == '.')
+            {
+                for (++s; s < end && *s >= '0' && *s <= '9'; ++s)
+                {
+                    found_digit = true;
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*s - '0');
+                        if (mantissa != 0)
+                            ++digits;
+                        --exponent;
+                    }
+                }
+            }
+
+            if (!found_digit)
+                return false;
+
+            if (s < end && (*s == 'e' || *s == 'E'))
+            {
+                const char* e = s + 1;
+                bool negative_exponent = false;
+                if (e < end && (*e == '-' || *e == '+'))
+                {
+                    negative_exponent = (*e == '-');
+                    ++e;
+                }
+
+                if (e < end && *e >= '0' && *e <= '9')
+                {
+                    int written = 0;
+                    for (; e < end && *e >= '0' && *e <= '9'; ++e)
+                    {
+                        if (written < 100000)
+                            written = written * 10 + (*e - '0');
+                    }
+                    exponent += negative_exponent ? -written : written;
+                    s = e;
+                }
+            }
+
+            //! Powers of ten up to 1e22 are exact, so the common cases round correctly
+            static const double kPowers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            double result = double(mantissa);
+            if (exponent > 0 && exponent <= 22)
+                result *= kPowers[exponent];
+            else if (exponent < 0 && exponent >= -22)
+                result /= kPowers[-exponent];
+            else if (exponent != 0)
+                result *= std::pow(10.0, exponent);
+
+            value = negative ? -result : result;
+            p = s;
+            return true;
+        }
+
+        inline bool isBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        //! \brief End of the line starting at p, not including the line break
+        inline const char* lineEnd(const char* p, const char* end)
+        {
+            const char* found = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            return (found == nullptr) ? end : found;
+        }
+    }
+
+    PointCloudReader::PointCloudReader(QString filename) : m_filename(filename)
+    {
+        //NOP
+    }
+
+    HeightMap PointCloudReader::readMatrix(double scale)
+    {
+        QFile file(m_filename);
+        QByteArray contents;
+        qint64 size;
+        const char* data = load(file, contents, size);
+
+        //! Each chunk keeps its samples and the length of every row it holds
+        struct Chunk
+        {
+            QVector<double> values;
+            QVector<int> row_sizes;
+        };
+
+        const QVector<qint64> bounds = chunkBounds(data, size);
+        QVector<Chunk> chunks(bounds.size() - 1);
+        const double missing = std::numeric_limits<double>::quiet_NaN();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < chunks.size(); ++i)
+        {
+            Chunk& chunk = chunks[i];
+            const char* end = data + bounds[i + 1];
+            for (const char* line = data + bounds[i]; line < end;)
+            {
+                const char* line_end = lineEnd(line, end);
+                int row_size = 0;
+                bool blank = true;
+
+                for (const char* field = line;;)
+                {
+                    const char* field_end = static_cast<const char*>(std::memchr(field, ',', line_end - field));
+                    bool last = (field_end == nullptr);
+                    if (last)
+                        field_end = line_end;
+
+                    const char* a = field;
+                    const char* b = field_end;
+                    while (a < b && isBlank(*a))
+                        ++a;
+                    while (b > a && isBlank(b[-1]))
+                        --b;
+
+                    // a trailing comma does not start another column
+                    if (a == b && last)
+                        break;
+
+                    double value = missing;
+                    if (a != b)
+                    {
+                        blank = false;
+                        const char* p = a;
+                        if (parseNumber(p, b, value) && p == b && std::isfinite(value))
+                            value *= scale;
+                        else
+                            value = missing;
+                    }
+
+                    chunk.values.append(value);
+                    ++row_size;
+
+                    if (last)
+                        break;
+                    field = field_end + 1;
+                }
+
+                if (blank)
+                    chunk.values.resize(chunk.values.size() - row_size);
+                else
+                    chunk.row_sizes.append(row_size);
+
+                line = line_end + 1;
+            }
+        }
+
+        HeightMap map;
+        map.origin_x = map.origin_y = 5.0 * scale;
+        map.spacing_x = map.spacing_y = 12.0 * scale;
+
+        //! Place each chunk's rows after those of the chunks before it
+        QVector<int> first_rows(chunks.size() + 1, 0);
+        for (int i = 0; i < chunks.size(); ++i)
+        {
+            first_rows[i + 1] = first_rows[i] + chunks[i].row_sizes.size();
+            for (int row_size : chunks[i].row_sizes)
+                map.columns = std::max(map.columns, row_size);
+        }
+        map.rows = first_rows.last();
+
+        if (map.rows == 0 || map.columns == 0)
+            return HeightMap();
+
+        map.heights.fill(missing, map.rows * map.columns);
+        double* heights = map.heights.data();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < chunks.size(); ++i)
+        {
+            const double* values = chunks[i].values.constData();
+            int row = first_rows[i];
+            for (int row_size : chunks[i].row_sizes)
+            {
+                std::copy(values, values + row_size, heights + qint64(row) * map.columns);
+                values += row_size;
+                ++row;
+            }
+        }
+
+        return map;
+    }
+
+    PointCloud PointCloudReader::readXYZ(double scale)
+    {
+        QFile file(m_filename);
+        QByteArray contents;
+        qint64 size;
+        const char* data = load(file, contents, size);
+
+        const QVector<qint64> bounds = chunkBounds(data, size);
+        QVector<PointCloud> chunks(bounds.size() - 1);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < chunks.size(); ++i)
+        {
+            PointCloud& chunk = chunks[i];
+            const char* end = data + bounds[i + 1];
+            for (const char* line = data + bounds[i]; line < end;)
+            {
+                const char* line_end = lineEnd(line, end);
+
+                const char* p = line;
+                while (p < line_end && isBlank(*p))
+                    ++p;
+
+                if (p < line_end && *p != '#')
+                {
+                    double values[3];
+                    int count = 0;
+                    while (count < 3 && parseNumber(p, line_end, values[count]))
+                    {
+                        ++count;
+                        while (p < line_end && (isBlank(*p) || *p == ','))
+                            ++p;
+                    }
+
+                    // a leading point count or a malformed line has fewer than three values
+                    if (count == 3)
+                        chunk.append(values[0] * scale, values[1] * scale, values[2] * scale);
+                }
+
+                line = line_end + 1;
+            }
+        }
+
+        PointCloud cloud;
+        int total = 0;
+        for (const PointCloud& chunk : chunks)
+            total += chunk.size();
+
+        cloud.x.reserve(total);
+        cloud.y.reserve(total);
+        cloud.z.reserve(total);
+        for (const PointCloud& chunk : chunks)
+            cloud.append(chunk);
+
+        return cloud;
+    }
+
+    const char* PointCloudReader::load(QFile& file, QByteArray& contents, qint64& size)
+    {
+        file.setFileName(m_filename);
+        if (!file.open(QIODevice::ReadOnly))
+            throw IOException("Could not open point cloud file " + m_filename);
+
+        size = file.size();
+        const uchar* mapped = (size > 0) ? file.map(0, size) : nullptr;
+        if (mapped != nullptr)
+            return reinterpret_cast<const char*>(mapped);
+
+        contents = file.readAll();
+        size = contents.size();
+        return contents.constData();
+    }
+
+    QVector<qint64> PointCloudReader::chunkBounds(const char* data, qint64 size)
+    {
+        qint64 chunk_count = std::max<qint64>(1, std::min<qint64>(QThread::idealThreadCount() * 4, size / kMinChunkSize));
+
+        QVector<qint64> bounds;
+        bounds.append(0);
+        for (qint64 i = 1; i < chunk_count; ++i)
+        {
+            qint64 position = std::max(bounds.last(), i * size / chunk_count);
+            if (position > 0 && position < size && data[position - 1] != '\n')
+                position = (lineEnd(data + position, data + size) - data) + 1;
+
+            bounds.append(std::min(position, size));
+        }
+        bounds.append(size);
+
+        return bounds;
+    }
+}
@@ -0,0 +1,168 @@
+#include "external_files/parsers/toolpath_reader.h"
+
+// C++
+#include <cstring>
+#include <limits>
+
+// Qt
+#include <QFile>
+#include <QtEndian>
+#include <QStringBuilder>
+
+namespace ORNL
+{
+    ToolpathReader::ToolpathReader(QString filename) : m_filename(filename)
+    {
+        //NOP
+    }
+
+    ToolpathColumns ToolpathReader::read()
+    {
+        QFile file(m_filename);
+        if (!file.open(QIODevice::ReadOnly))
+            throw IOException("Could not open toolpath file " % m_filename);
+
+        // map the file so columns are copied once, straight into their arrays
+        QByteArray contents;
+        const uchar* data = file.map(0, file.size());
+        qint64 size = file.size();
+        if (data == nullptr)
+        {
+            contents = file.readAll();
+            data = reinterpret_cast<const uchar*>(contents.constData());
+            size = contents.size();
+        }
+
+        qint64 offset = 0;
+        auto require = [&](qint64 bytes)
+        {
+            if (offset + bytes > size)
+                throw InvalidParseException("Toolpath file " % m_filename % " is truncated");
+        };
+        auto readUInt32 = [&]()
+        {
+            require(4);
+            quint32 value = qFromLittleEndian<quint32>(data + offset);
+            offset += 4;
+            return value;
+        };
+
+        require(12);
+        if (std::memcmp(data, ToolpathFormat::kMagic, sizeof(ToolpathFormat::kMagic)) != 0)
+            throw InvalidParseException(m_filename % " is not a toolpath file");
+
+        m_version = qFromLittleEndian<quint16>(data + 4);
+        m_flags = qFromLittleEndian<quint16>(data + 6);
+        offset = 8;
+        if (m_version > ToolpathFormat::kVersion)
+            throw InvalidParseException("Toolpath file version " % QString::number(m_version) % " is newer than this reader");
+
+        //! Match file columns to known columns by name
+        struct FileColumn
+        {
+            ToolpathFormat::ColumnType type;
+            int element_size;
+            int target;
+        };
+
+        const QVector<ToolpathColumns::Column>& layout = ToolpathColumns::layout();
+        QVector<FileColumn> file_columns(readUInt32());
+        for (FileColumn& column : file_columns)
+        {
+            require(2);
+            column.type = ToolpathFormat::ColumnType(data[offset]);
+            int name_size = data[offset + 1];
+            offset += 2;
+
+            require(name_size);
+            QByteArray name(reinterpret_cast<const char*>(data + offset), name_size);
+            offset += name_size;
+
+            column.element_size = ToolpathFormat::elementSize(column.type);
+            if (column.element_size == 0)
+                throw InvalidParseException("Toolpath column " % QString(name) % " has an unknown type");
+
+            column.target = -1;
+            for (int i = 0, end = layout.size(); i < end; ++i)
+            {
+                if (name == layout[i].name)
+                {
+                    if (layout[i].type != column.type)
+                        throw InvalidParseException("Toolpath column " % QString(name) % " has an unexpected type");
+                    column.target = i;
+                    break;
+                }
+            }
+        }
+
+        //! First pass: walk the chunk headers to size the columns once
+        qint64 header_end = offset;
+        qint64 total = 0;
+        while (offset < size)
+        {
+            total += readUInt32();
+            for (int i = 0, end = file_columns.size(); i < end; ++i)
+            {
+                quint32 stored = readUInt32();
+                require(stored);
+                offset += stored;
+            }
+        }
+
+        if (total > std::numeric_limits<int>::max())
+            throw InvalidParseException("Toolpath file " % m_filename % " holds too many segments");
+
+        // resizing zero fills, which leaves columns missing from the file at zero
+        ToolpathColumns columns;
+        columns.resize(int(total));
+
+        //! Second pass: copy or decompress each column into place
+        bool compressed = isCompressed();
+        qint64 written = 0;
+        offset = header_end;
+        while (offset < size)
+        {
+            quint32 count = readUInt32();
+            for (const FileColumn& column : file_columns)
+            {
+                quint32 stored = readUInt32();
+                const uchar* source = data + offset;
+                offset += stored;
+
+                if (column.target < 0)
+                    continue;
+
+                char* target = columns.columnData(column.target) + written * column.element_size;
+                qint64 expected = qint64(count) * column.element_size;
+                if (compressed)
+                {
+                    QByteArray raw = qUncompress(source, int(stored));
+                    if (raw.size() != expected)
+                        throw InvalidParseException("Toolpath file " % m_filename % " has a corrupt chunk");
+                    std::memcpy(target, raw.constData(), size_t(expected));
+                }
+                else
+                {
+                    if (stored != expected)
+                        throw InvalidParseException("Toolpath file " % m_filename % " has a corrupt chunk");
+                    std::memcpy(target, source, size_t(expected));
+                }
+
+                ToolpathFormat::convertByteOrder(target, int(count), column.type);
+            }
+            written += count;
+        }
+
+        return columns;
+    }
+
+    quint16 ToolpathReader::version() const
+    {
+        return m_version;
+    }
+
+    bool ToolpathReader::isCompressed() const
+    {
+        return (m_flags & ToolpathFormat::kCompressed) != 0;
+    }
+}
@@ -0,0 +1,129 @@
+#include "external_files/toolpath_format.h"
+
+// C++
+#include <algorithm>
+
+// Qt
+#include <QtEndian>
+
+namespace ORNL
+{
+    int ToolpathFormat::elementSize(ColumnType type)
+    {
+        switch (type)
+        {
+            case ColumnType::kFloat32: return sizeof(float);
+            case ColumnType::kFloat64: return sizeof(double);
+            case ColumnType::kUInt8:   return sizeof(quint8);
+            case ColumnType::kUInt16:  return sizeof(quint16);
+            case ColumnType::kUInt32:  return sizeof(quint32);
+        }
+        return 0;
+    }
+
+    void ToolpathFormat::convertByteOrder(char* data, int count, ColumnType type)
+    {
+        #if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        int size = elementSize(type);
+        if (size > 1)
+        {
+            for (char* element = data, *end = data + qint64(count) * size; element < end; element += size)
+                std::reverse(element, element + size);
+        }
+        #else
+        Q_UNUSED(data);
+        Q_UNUSED(count);
+        Q_UNUSED(type);
+        #endif
+    }
+
+    const QVector<ToolpathColumns::Column>& ToolpathColumns::layout()
+    {
+        using ToolpathFormat::ColumnType;
+        static const QVector<Column> columns {
+            {"start_x", ColumnType::kFloat32}, {"start_y", ColumnType::kFloat32}, {"start_z", ColumnType::kFloat32},
+            {"end_x", ColumnType::kFloat32}, {"end_y", ColumnType::kFloat32}, {"end_z", ColumnType::kFloat32},
+            {"width", ColumnType::kFloat32}, {"height", ColumnType::kFloat32}, {"speed", ColumnType::kFloat32},
+            {"region_type", ColumnType::kUInt16}, {"printing", ColumnType::kUInt8},
+            {"tool", ColumnType::kUInt16}, {"layer", ColumnType::kUInt32}, {"time", ColumnType::kFloat64},
+            {"normal_x", ColumnType::kFloat32}, {"normal_y", ColumnType::kFloat32}, {"normal_z", ColumnType::kFloat32}
+        };
+        return columns;
+    }
+
+    char* ToolpathColumns::columnData(int column)
+    {
+        switch (column)
+        {
+            case 0:  return reinterpret_cast<char*>(start_x.data());
+            case 1:  return reinterpret_cast<char*>(start_y.data());
+            case 2:  return reinterpret_cast<char*>(start_z.data());
+            case 3:  return reinterpret_cast<char*>(end_x.data());
+            case 4:  return reinterpret_cast<char*>(end_y.data());
+            case 5:  return reinterpret_cast<char*>(end_z.data());
+            case 6:  return reinterpret_cast<char*>(width.data());
+            case 7:  return reinterpret_cast<char*>(height.data());
+            case 8:  return reinterpret_cast<char*>(speed.data());
+            case 9:  return reinterpret_cast<char*>(region_type.data());
+            case 10: return reinterpret_cast<char*>(printing.data());
+            case 11: return reinterpret_cast<char*>(tool.data());
+            case 12: return reinterpret_cast<char*>(layer.data());
+            case 13: return reinterpret_cast<char*>(time.data());
+            case 14: return reinterpret_cast<char*>(normal_x.data());
+            case 15: return reinterpret_cast<char*>(normal_y.data());
+            case 16: return reinterpret_cast<char*>(normal_z.data());
+        }
+        return nullptr;
+    }
+
+    const char* ToolpathColumns::columnData(int column) const
+    {
+        switch (column)
+        {
+            case 0:  return reinterpret_cast<const char*>(start_x.constData());
+            case 1:  return reinterpret_cast<const char*>(start_y.constData());
+            case 2:  return reinterpret_cast<const char*>(start_z.constData());
+            case 3:  return reinterpret_cast<const char*>(end_x.constData());
+            case 4:  return reinterpret_cast<const char*>(end_y.constData());
+            case 5:  return reinterpret_cast<const char*>(end_z.constData());
+            case 6:  return reinterpret_cast<const char*>(width.constData());
+            case 7:  return reinterpret_cast<const char*>(height.constData());
+            case 8:  return reinterpret_cast<const char*>(speed.constData());
+            case 9:  return reinterpret_cast<const char*>(region_type.constData());
+            case 10: return reinterpret_cast<const char*>(printing.constData());
+            case 11: return reinterpret_cast<const char*>(tool.constData());
+            case 12: return reinterpret_cast<const char*>(layer.constData());
+            case 13: return reinterpret_cast<const char*>(time.constData());
+            case 14: return reinterpret_cast<const char*>(normal_x.constData());
+            case 15: return reinterpret_cast<const char*>(normal_y.constData());
+            case 16: return reinterpret_cast<const char*>(normal_z.constData());
+        }
+        return nullptr;
+    }
+
+    void ToolpathColumns::resize(int size)
+    {
+        start_x.resize(size); start_y.resize(size); start_z.resize(size);
+        end_x.resize(size); end_y.resize(size); end_z.resize(size);
+        width.resize(size); height.resize(size); speed.resize(size);
+        region_type.resize(size); printing.resize(size);
+        tool.resize(size); layer.resize(size); time.resize(size);
+        normal_x.resize(size); normal_y.resize(size); normal_z.resize(size);
+    }
+
+    void ToolpathColumns::reserve(int size)
+    {
+        start_x.reserve(size); start_y.reserve(size); start_z.reserve(size);
+        end_x.reserve(size); end_y.reserve(size); end_z.reserve(size);
+        width.reserve(size); height.reserve(size); speed.reserve(size);
+        region_type.reserve(size); printing.reserve(size);
+        tool.reserve(size); layer.reserve(size); time.reserve(size);
+        normal_x.reserve(size); normal_y.reserve(size); normal_z.reserve(size);
+    }
+
+    void ToolpathColumns::clear()
+    {
+        // keep capacity, the exporter refills the same columns chunk after chunk
+        resize(0);
+    }
+}
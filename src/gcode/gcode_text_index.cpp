@@ -0,0 +1,217 @@
+#include "gcode/gcode_text_index.h"
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+namespace ORNL
+{
+    namespace
+    {
+        inline char asciiUpper(char c)
+        {
+            return (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c;
+        }
+
+        //! \brief Whether an upper case ASCII needle occurs in [begin, end), ignoring case
+        bool containsAscii(const char* begin, const char* end, const QByteArray& needle)
+        {
+            const int size = needle.size();
+            const char* data = needle.constData();
+            for (const char* p = begin; end - p >= size; ++p)
+            {
+                if (asciiUpper(*p) != data[0])
+                    continue;
+
+                int i = 1;
+                while (i < size && asciiUpper(p[i]) == data[i])
+                    ++i;
+                if (i == size)
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    GcodeTextIndex::GcodeTextIndex() : m_palette(1), m_max_line_length(0)
+    {
+        //NOP
+    }
+
+    bool GcodeTextIndex::load(const QString& file_name, int skipped_lines)
+    {
+        QSharedPointer<Source> source = QSharedPointer<Source>::create();
+        source->file.setFileName(file_name);
+        if (!source->file.open(QIODevice::ReadOnly))
+            return false;
+
+        source->size = source->file.size();
+        const uchar* mapped = (source->size > 0) ? source->file.map(0, source->size) : nullptr;
+        if (mapped != nullptr)
+        {
+            source->data = reinterpret_cast<const char*>(mapped);
+        }
+        else
+        {
+            source->contents = source->file.readAll();
+            source->size = source->contents.size();
+            source->data = source->contents.constData();
+        }
+
+        const char* data = source->data;
+        const qint64 size = source->size;
+
+        // skipped lines are scanned past, but not indexed
+        const char* p = data;
+        for (int i = 0; i < skipped_lines && p != nullptr; ++i)
+        {
+            p = static_cast<const char*>(std::memchr(p, '\n', data + size - p));
+            if (p != nullptr)
+                ++p;
+        }
+        qint64 first = (p != nullptr) ? qint64(p - data) : size;
+
+        m_source = source;
+        m_max_line_length = 0;
+        m_line_offsets.clear();
+        m_line_offsets.append(first);
+        for (p = data + first; size > 0 && (p = static_cast<const char*>(std::memchr(p, '\n', data + size - p))) != nullptr; ++p)
+        {
+            qint64 start = m_line_offsets.last();
+            qint64 next = qint64(p - data) + 1;
+            m_max_line_length = std::max(m_max_line_length, int(next - 1 - start));
+            m_line_offsets.append(next);
+        }
+
+        // the last line has no line break, its end is placed as if it had one
+        m_max_line_length = std::max(m_max_line_length, int(size - m_line_offsets.last()));
+        m_line_offsets.append(size + 1);
+        m_line_offsets.squeeze();
+
+        m_line_colors.resize(lineCount());
+        m_line_colors.squeeze();
+        return true;
+    }
+
+    int GcodeTextIndex::lineCount() const
+    {
+        return std::max(0, m_line_offsets.size() - 1);
+    }
+
+    bool GcodeTextIndex::isEmpty() const
+    {
+        return lineCount() == 0;
+    }
+
+    QString GcodeTextIndex::line(int line) const
+    {
+        const char* data = m_source->data;
+        qint64 start = m_line_offsets[line];
+        int length = int(m_line_offsets[line + 1] - 1 - start);
+        if (length > 0 && data[start + length - 1] == '\r')
+            --length;
+        return QString::fromUtf8(data + start, length);
+    }
+
+    int GcodeTextIndex::maxLineLength() const
+    {
+        return m_max_line_length;
+    }
+
+    QString GcodeTextIndex::text() const
+    {
+        QString result;
+        for (int i = 0, count = lineCount(); i < count; ++i)
+        {
+            if (i > 0)
+                result += '\n';
+            result += line(i);
+        }
+        return result;
+    }
+
+    void GcodeTextIndex::setLineColor(int line, const QColor& color)
+    {
+        if (line < 0)
+            return;
+
+        // colors may be gathered before the file they belong to is loaded
+        if (line >= m_line_colors.size())
+        {
+            if (!m_source.isNull())
+                return;
+            m_line_colors.resize(line + 1);
+        }
+
+        // programs use a handful of colors, and consecutive lines mostly repeat the last one
+        int index = m_palette.lastIndexOf(color);
+        if (index <= 0)
+        {
+            if (m_palette.size() > 255)
+                return;
+            index = m_palette.size();
+            m_palette.append(color);
+        }
+
+        m_line_colors[line] = quint8(index);
+    }
+
+    void GcodeTextIndex::clearLineColor(int line)
+    {
+        if (line >= 0 && line < m_line_colors.size())
+            m_line_colors[line] = 0;
+    }
+
+    int GcodeTextIndex::lineColorIndex(int line) const
+    {
+        return (line >= 0 && line < m_line_colors.size()) ? m_line_colors[line] : 0;
+    }
+
+    const QVector<QColor>& GcodeTextIndex::palette() const
+    {
+        return m_palette;
+    }
+
+    GcodeTextIndex GcodeTextIndex::colorsOnly() const
+    {
+        GcodeTextIndex colors;
+        colors.m_line_colors = m_line_colors;
+        colors.m_palette = m_palette;
+        return colors;
+    }
+
+    QVector<int> GcodeTextIndex::findLines(const QString& needle) const
+    {
+        QVector<int> result;
+        if (needle.isEmpty() || isEmpty())
+            return result;
+
+        bool ascii = std::all_of(needle.begin(), needle.end(), [](const QChar& c) { return c.unicode() < 128; });
+        const QByteArray upper_needle = needle.toUpper().toUtf8();
+        const char* data = m_source->data;
+
+        //! Search blocks of lines in parallel and join their matches in order
+        const int line_count = lineCount();
+        const int block_size = 1 << 14;
+        const int block_count = (line_count + block_size - 1) / block_size;
+        QVector<QVector<int>> matches(block_count);
+        QVector<int>* block_matches = matches.data();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int block = 0; block < block_count; ++block)
+        {
+            for (int i = block * block_size, end = std::min(line_count, (block + 1) * block_size); i < end; ++i)
+            {
+                bool found = ascii ? containsAscii(data + m_line_offsets[i], data + m_line_offsets[i + 1] - 1, upper_needle)
+                                   : line(i).contains(needle, Qt::CaseInsensitive);
+                if (found)
+                    block_matches[block].append(i);
+            }
+        }
+
+        for (const QVector<int>& lines : matches)
+            result += lines;
+
+        return result;
+    }
+}  // namespace ORNL
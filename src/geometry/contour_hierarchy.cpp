@@ -0,0 +1,201 @@
+// Main Module
+#include "geometry/contour_hierarchy.h"
+
+// Qt
+#include <QPair>
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ORNL
+{
+    namespace
+    {
+        //! \brief Integer bounding box of a contour
+        struct Box
+        {
+            ClipperLib2::cInt min_x = 0, min_y = 0, max_x = 0, max_y = 0;
+
+            bool contains(const ClipperLib2::IntPoint& p) const
+            {
+                return p.X >= min_x && p.X <= max_x && p.Y >= min_y && p.Y <= max_y;
+            }
+        };
+    }
+
+    ContourHierarchy::ContourHierarchy(const QVector<ClipperLib2::Path>& contours, const QVector<bool>& can_enclose)
+    {
+        findParents(contours, can_enclose);
+        orderChildren();
+    }
+
+    int ContourHierarchy::parent(int contour) const
+    {
+        return m_parents[contour];
+    }
+
+    const QVector<int>& ContourHierarchy::children(int contour) const
+    {
+        return m_children[contour];
+    }
+
+    void ContourHierarchy::findParents(const QVector<ClipperLib2::Path>& contours, const QVector<bool>& can_enclose)
+    {
+        const int count = contours.size();
+        m_parents.fill(0, count);
+        if (count == 0)
+            return;
+        m_parents[0] = -1;
+
+        QVector<Box> boxes(count);
+        QVector<double> areas(count, 0.0);
+        QVector<bool> encloses(count, false);
+        Box bounds;
+        bool has_bounds = false;
+
+        for (int i = 1; i < count; ++i)
+        {
+            const ClipperLib2::Path& path = contours[i];
+            if (path.empty())
+                continue;
+
+            Box& box = boxes[i];
+            box.min_x = box.max_x = path[0].X;
+            box.min_y = box.max_y = path[0].Y;
+            for (const ClipperLib2::IntPoint& p : path)
+            {
+                box.min_x = std::min(box.min_x, p.X); box.max_x = std::max(box.max_x, p.X);
+                box.min_y = std::min(box.min_y, p.Y); box.max_y = std::max(box.max_y, p.Y);
+            }
+
+            encloses[i] = can_enclose.isEmpty() || can_enclose[i];
+            if (encloses[i])
+                areas[i] = std::abs(ClipperLib2::Area(path));
+
+            if (!has_bounds)
+                bounds = box;
+            bounds.min_x = std::min(bounds.min_x, box.min_x); bounds.max_x = std::max(bounds.max_x, box.max_x);
+            bounds.min_y = std::min(bounds.min_y, box.min_y); bounds.max_y = std::max(bounds.max_y, box.max_y);
+            has_bounds = true;
+        }
+
+        if (!has_bounds)
+            return;
+
+        //! An enclosing contour has a larger area than what it encloses, so visiting
+        //! from the largest down sees every possible parent before its children
+        QVector<int> order(count - 1);
+        std::iota(order.begin(), order.end(), 1);
+        std::stable_sort(order.begin(), order.end(), [&areas](int lhs, int rhs) { return areas[lhs] > areas[rhs]; });
+
+        //! Grid of the boxes of contours visited so far. Each cell lists them in
+        //! visiting order, so scanning a cell backwards meets inner contours first.
+        const int size = std::max(1, std::min(64, int(std::ceil(std::sqrt(double(count))))));
+        const ClipperLib2::cInt cell_x = (bounds.max_x - bounds.min_x) / size + 1;
+        const ClipperLib2::cInt cell_y = (bounds.max_y - bounds.min_y) / size + 1;
+        QVector<QVector<int>> cells(size * size);
+
+        auto column = [&](ClipperLib2::cInt x) { return int(std::min<ClipperLib2::cInt>(size - 1, (x - bounds.min_x) / cell_x)); };
+        auto row = [&](ClipperLib2::cInt y) { return int(std::min<ClipperLib2::cInt>(size - 1, (y - bounds.min_y) / cell_y)); };
+
+        for (int contour : order)
+        {
+            const ClipperLib2::Path& path = contours[contour];
+            if (path.empty())
+                continue;
+
+            const ClipperLib2::IntPoint& first = path[0];
+            const QVector<int>& candidates = cells[row(first.Y) * size + column(first.X)];
+            for (int i = candidates.size() - 1; i >= 0; --i)
+            {
+                int candidate = candidates[i];
+                if (boxes[candidate].contains(first) && ClipperLib2::PointInPolygon(first, contours[candidate]) == 1)
+                {
+                    m_parents[contour] = candidate;
+                    break;
+                }
+            }
+
+            if (!encloses[contour])
+                continue;
+
+            const Box& box = boxes[contour];
+            for (int r = row(box.min_y), r_end = row(box.max_y); r <= r_end; ++r)
+                for (int c = column(box.min_x), c_end = column(box.max_x); c <= c_end; ++c)
+                    cells[r * size + c].append(contour);
+        }
+    }
+
+    void ContourHierarchy::orderChildren()
+    {
+        const int count = m_parents.size();
+        m_children = QVector<QVector<int>>(count);
+        if (count == 0)
+            return;
+
+        //! Entry and exit times of a walk of the final tree answer whether one
+        //! contour lies below another, and the smallest index below each contour
+        //! tells whether any of its descendants were inserted before it
+        QVector<QVector<int>> tree(count);
+        for (int i = 1; i < count; ++i)
+            tree[m_parents[i]].append(i);
+
+        QVector<int> enter(count), leave(count), earliest_below(count, count);
+        QVector<QPair<int, int>> stack;
+        stack.append(qMakePair(0, 0));
+        int time = 0;
+        enter[0] = time++;
+        while (!stack.isEmpty())
+        {
+            int node = stack.last().first;
+            int& next = stack.last().second;
+            if (next < tree[node].size())
+            {
+                int child = tree[node][next++];
+                enter[child] = time++;
+                stack.append(qMakePair(child, 0));
+            }
+            else
+            {
+                leave[node] = time++;
+                stack.removeLast();
+                if (!stack.isEmpty())
+                {
+                    int parent = stack.last().first;
+                    earliest_below[parent] = std::min({earliest_below[parent], node, earliest_below[node]});
+                }
+            }
+        }
+
+        auto below = [&enter, &leave](int node, int ancestor) {
+            return enter[ancestor] < enter[node] && leave[node] < leave[ancestor];
+        };
+
+        //! Replays inserting contours in index order: each contour goes under its
+        //! nearest ancestor that is already in the tree, and takes over the
+        //! children of that ancestor it encloses, scanning them from the back
+        for (int contour = 1; contour < count; ++contour)
+        {
+            int ancestor = m_parents[contour];
+            while (ancestor > contour)
+                ancestor = m_parents[ancestor];
+
+            QVector<int>& siblings = m_children[ancestor];
+            if (earliest_below[contour] < contour)
+            {
+                QVector<int>& adopted = m_children[contour];
+                for (int i = siblings.size() - 1; i >= 0; --i)
+                {
+                    if (below(siblings[i], contour))
+                        adopted.append(siblings[i]);
+                }
+                siblings.erase(std::remove_if(siblings.begin(), siblings.end(),
+                                              [&](int sibling) { return below(sibling, contour); }),
+                               siblings.end());
+            }
+            siblings.append(contour);
+        }
+    }
+}
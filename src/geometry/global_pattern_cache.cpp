@@ -0,0 +1,164 @@
+// Main Module
+#include "geometry/global_pattern_cache.h"
+
+// C++
+#include <algorithm>
+#include <limits>
+
+namespace ORNL
+{
+    QHash<GlobalPatternCache::Key, QSharedPointer<const GlobalPattern>> GlobalPatternCache::m_patterns;
+    QReadWriteLock GlobalPatternCache::m_lock;
+
+    GlobalPattern::GlobalPattern(const QVector<Polyline>& rows)
+    {
+        int point_count = 0;
+        for (const Polyline& row : rows)
+            point_count += row.size();
+
+        m_x.reserve(point_count);
+        m_y.reserve(point_count);
+        m_z.reserve(point_count);
+        m_row_offsets.reserve(rows.size() + 1);
+
+        QVector<float> min_x, max_x, min_y, max_y;
+        for (const Polyline& row : rows)
+        {
+            m_row_offsets.push_back(m_x.size());
+
+            float lo_x = std::numeric_limits<float>::max(), lo_y = lo_x;
+            float hi_x = std::numeric_limits<float>::lowest(), hi_y = hi_x;
+            for (const Point& point : row)
+            {
+                m_x.push_back(point.x());
+                m_y.push_back(point.y());
+                m_z.push_back(point.z());
+                lo_x = std::min(lo_x, point.x());
+                hi_x = std::max(hi_x, point.x());
+                lo_y = std::min(lo_y, point.y());
+                hi_y = std::max(hi_y, point.y());
+            }
+
+            min_x.push_back(lo_x);
+            max_x.push_back(hi_x);
+            min_y.push_back(lo_y);
+            max_y.push_back(hi_y);
+        }
+        m_row_offsets.push_back(m_x.size());
+
+        //! Index rows along whichever axis they advance on. Rows that all span the
+        //! same extent on one axis (such as honeycomb rows in x) are ordered on it
+        //! trivially, so prefer the axis with the larger spread.
+        auto spread = [](const QVector<float>& lower, const QVector<float>& upper)
+        {
+            if (lower.isEmpty() || !std::is_sorted(lower.begin(), lower.end()) || !std::is_sorted(upper.begin(), upper.end()))
+                return -1.0f;
+            return lower.last() - lower.first();
+        };
+
+        float spread_x = spread(min_x, max_x), spread_y = spread(min_y, max_y);
+        if (spread_x >= 0.0f && spread_x >= spread_y)
+        {
+            m_axis = 0;
+            m_row_min = min_x;
+            m_row_max = max_x;
+        }
+        else if (spread_y >= 0.0f)
+        {
+            m_axis = 1;
+            m_row_min = min_y;
+            m_row_max = max_y;
+        }
+    }
+
+    QVector<Polyline> GlobalPattern::rowsOverlapping(const Point& min, const Point& max) const
+    {
+        int first = 0, last = rowCount();
+        if (m_axis >= 0)
+        {
+            float lo = (m_axis == 0) ? min.x() : min.y();
+            float hi = (m_axis == 0) ? max.x() : max.y();
+            first = std::lower_bound(m_row_max.begin(), m_row_max.end(), lo) - m_row_max.begin();
+            last = std::upper_bound(m_row_min.begin(), m_row_min.end(), hi) - m_row_min.begin();
+        }
+
+        const float min_x = min.x(), min_y = min.y(), max_x = max.x(), max_y = max.y();
+
+        QVector<Polyline> result;
+        for (int row = first; row < last; ++row)
+        {
+            //! Keep runs of segments that touch the box
+            Polyline run;
+            for (int i = m_row_offsets[row] + 1, end = m_row_offsets[row + 1]; i < end; ++i)
+            {
+                bool overlaps = std::max(m_x[i - 1], m_x[i]) >= min_x && std::min(m_x[i - 1], m_x[i]) <= max_x &&
+                                std::max(m_y[i - 1], m_y[i]) >= min_y && std::min(m_y[i - 1], m_y[i]) <= max_y;
+                if (overlaps)
+                {
+                    if (run.isEmpty())
+                        run << Point(m_x[i - 1], m_y[i - 1], m_z[i - 1]);
+                    run << Point(m_x[i], m_y[i], m_z[i]);
+                }
+                else if (!run.isEmpty())
+                {
+                    result += run;
+                    run.clear();
+                }
+            }
+
+            if (!run.isEmpty())
+                result += run;
+        }
+
+        return result;
+    }
+
+    int GlobalPattern::rowCount() const
+    {
+        return m_row_offsets.size() - 1;
+    }
+
+    bool GlobalPatternCache::Key::operator==(const Key& rhs) const
+    {
+        return pattern == rhs.pattern && spacing == rhs.spacing && bead_width == rhs.bead_width &&
+               min_x == rhs.min_x && min_y == rhs.min_y && max_x == rhs.max_x && max_y == rhs.max_y;
+    }
+
+    QSharedPointer<const GlobalPattern> GlobalPatternCache::Get(const Key& key, const std::function<QVector<Polyline>()>& generate)
+    {
+        {
+            QReadLocker locker(&m_lock);
+            auto found = m_patterns.constFind(key);
+            if (found != m_patterns.constEnd())
+                return found.value();
+        }
+
+        //! Generate without holding the lock, another thread may insert the same pattern meanwhile
+        QSharedPointer<const GlobalPattern> pattern(new GlobalPattern(generate()));
+
+        QWriteLocker locker(&m_lock);
+        auto found = m_patterns.constFind(key);
+        if (found != m_patterns.constEnd())
+            return found.value();
+
+        if (m_patterns.size() >= kMaxPatterns)
+            m_patterns.clear();
+
+        m_patterns.insert(key, pattern);
+        return pattern;
+    }
+
+    void GlobalPatternCache::Clear()
+    {
+        QWriteLocker locker(&m_lock);
+        m_patterns.clear();
+    }
+
+    uint qHash(const GlobalPatternCache::Key& key, uint seed)
+    {
+        seed = ::qHash(key.pattern, seed);
+        for (double value : {key.spacing, key.bead_width, key.min_x, key.min_y, key.max_x, key.max_y})
+            seed = ::qHash(value, seed) ^ (seed << 1);
+        return seed;
+    }
+}
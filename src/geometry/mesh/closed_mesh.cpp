@@ -148,6 +148,7 @@ namespace ORNL
         //! Apply translation to CGAL mesh
         CGAL::Polygon_mesh_processing::transform(translation, m_original_representation);
         CGAL::Polygon_mesh_processing::transform(translation, m_representation);
+        m_acceleration.clear();
 
         //! Update mesh vertices
         size_t i = 0;
@@ -169,8 +170,7 @@ namespace ORNL
 
     QVector<Point> ClosedMesh::boundingBox()
     {
-        MeshTypes::Polyhedron_AABB_Tree tree(CGAL::faces(m_representation).first, CGAL::faces(m_representation).second, m_representation);
-        auto box = tree.bbox();
+        auto box = m_acceleration.bbox(m_representation);
 
         QVector<Point> points;
 
@@ -204,11 +204,11 @@ namespace ORNL
 
     QVector<Point> ClosedMesh::intersect(Point start, Point end)
     {
-        MeshTypes::Polyhedron_AABB_Tree tree(CGAL::faces(m_representation).first, CGAL::faces(m_representation).second, m_representation);
+        auto tree = m_acceleration.faceTree(m_representation);
         MeshTypes::Kernel::Segment_3 segment(start.toCartesian3D(), end.toCartesian3D());
 
         std::list<MeshTypes::Polyhedron_Segment_intersection> intersections;
-        tree.all_intersections(segment, std::back_inserter(intersections));
+        tree->all_intersections(segment, std::back_inserter(intersections));
 
         QVector<Point> intersection_points;
         for(auto intersection : intersections)
@@ -258,11 +258,11 @@ namespace ORNL
 
     std::pair<QVector<Polyline>, QVector<Polygon>> ClosedMesh::intersect(Plane plane)
     {
-        // Slicer constructor from the mesh
-        CGAL::Polygon_mesh_slicer<MeshTypes::Polyhedron, MeshTypes::Kernel> slicer(m_representation);
+        // The slicer and its edge tree are built once and reused for every plane
+        auto slicer = m_acceleration.slicer(m_representation);
 
         QVector<std::vector<MeshTypes::Kernel::Point_3>> cgal_polylines;
-        slicer(plane.toCGALPlane(), std::back_inserter(cgal_polylines));
+        (*slicer)(plane.toCGALPlane(), std::back_inserter(cgal_polylines));
 
         QVector<Polyline> result_polylines;
         QVector<Polygon> result_polygons;
@@ -295,6 +295,7 @@ namespace ORNL
     {
         auto clip = clipper.polyhedron();
         CGAL::Polygon_mesh_processing::corefine_and_compute_difference(m_representation, clip, m_representation);
+        m_acceleration.clear();
 
         // Convert back to a mesh
         auto vertices_and_faces = FacesAndVerticesFromPolyhedron(m_representation);
@@ -404,8 +405,8 @@ namespace ORNL
     {
         // Take cross-section to find area
         std::list<std::vector<MeshTypes::Point_3>> cross_section;
-        CGAL::Polygon_mesh_slicer<MeshTypes::Polyhedron, MeshTypes::Kernel> slicer(m_representation);
-        slicer(plane.toCGALPlane(), std::back_inserter(cross_section));
+        auto slicer = m_acceleration.slicer(m_representation);
+        (*slicer)(plane.toCGALPlane(), std::back_inserter(cross_section));
 
         Area a = 0;
         bool intersecting = false;
@@ -513,6 +514,7 @@ namespace ORNL
     void ClosedMesh::convert()
     {
         m_representation = MeshTypes::Polyhedron(PolyhedronFromVerticesAndFaces(m_vertices, m_faces));
+        m_acceleration.clear();
     }
 
     bool ClosedMesh::CheckIntersectingCurves(Plane &plane, QVector<Polygon> boundary_curves)
@@ -3,6 +3,9 @@
 // Qt
 #include <QFileInfo>
 
+// Local
+#include "external_files/parsers/point_cloud_reader.h"
+
 // CGAL
 #include <CGAL/Polygon_mesh_processing/intersection.h>
 #include <CGAL/Polygon_mesh_processing/corefinement.h>
@@ -21,6 +24,9 @@
 #include <CGAL/disable_warnings.h>
 #include <CGAL/Polygon_mesh_processing/transform.h>
 
+// C++
+#include <cmath>
+
 
 
 namespace ORNL
@@ -220,6 +226,7 @@ namespace ORNL
         //! Apply translation to CGAL mesh
         CGAL::Polygon_mesh_processing::transform(translation, m_original_representation);
         CGAL::Polygon_mesh_processing::transform(translation, m_representation);
+        m_acceleration.clear();
 
         //! Update mesh vertices
         size_t i = 0;
@@ -241,8 +248,7 @@ namespace ORNL
 
     QVector<Point> OpenMesh::boundingBox()
     {
-        MeshTypes::SurfaceMesh_AABB_Tree tree(CGAL::faces(m_representation).first, CGAL::faces(m_representation).second, m_representation);
-        auto box = tree.bbox();
+        auto box = m_acceleration.bbox(m_representation);
 
         QVector<Point> points;
 
@@ -305,11 +311,11 @@ namespace ORNL
 
     std::pair<QVector<Polyline>, QVector<Polygon>> OpenMesh::intersect(Plane plane)
     {
-        // Slicer constructor from the mesh
-        CGAL::Polygon_mesh_slicer<MeshTypes::SurfaceMesh, MeshTypes::Kernel> slicer(m_representation);
+        // The slicer and its edge tree are built once and reused for every plane
+        auto slicer = m_acceleration.slicer(m_representation);
 
         QVector<std::vector<MeshTypes::Kernel::Point_3>> cgal_polylines;
-        slicer(plane.toCGALPlane(), std::back_inserter(cgal_polylines));
+        (*slicer)(plane.toCGALPlane(), std::back_inserter(cgal_polylines));
 
         QVector<Polyline> result_polylines;
         QVector<Polygon> result_polygons;
@@ -404,30 +410,50 @@ namespace ORNL
         return std::pair<QVector<MeshVertex>, QVector<MeshFace>>(mesh_vertices, mesh_faces);
     }
 
-    QSharedPointer<OpenMesh> OpenMesh::BuildMeshFromPointCloud(const QString &file_path)
+    QSharedPointer<OpenMesh> OpenMesh::BuildMeshFromPointCloud(const QString &file_path, int max_points)
     {
-        QVector<MeshTypes::Point_3> p;
-
         QFileInfo file(file_path);
-
         QString suffix  = file.suffix();
-        if(suffix == "xyz")
-            p = loadXYZFile(file_path);
-        else if(suffix == "matrix")
-            p = loadMatrixFile(file_path);
-
-        if(p.isEmpty())
-            return nullptr; // No points loaded
-
-        std::vector<MeshTypes::Point_3> points(p.begin(), p.end());
-        MeshTypes::SurfaceMesh m;
 
         try
         {
-            ConstructPointCloud construct(m,points.begin(),points.end());
-            CGAL::advancing_front_surface_reconstruction(points.begin(),
-                                                         points.end(),
-                                                         construct);
+            // Scale to micron
+            PointCloudReader reader(file_path);
+            HeightMap height_map;
+            PointCloud cloud;
+            if(suffix == "matrix")
+                height_map = reader.readMatrix(1000.0);
+            else if(suffix == "xyz")
+            {
+                cloud = reader.readXYZ(1000.0);
+                HeightMap::FromPoints(cloud, height_map);
+            }
+
+            // Scans sampled on a grid already know their connectivity
+            MeshTypes::SurfaceMesh m;
+            if(!height_map.isEmpty())
+                m = SurfaceMeshFromHeightMap(height_map);
+
+            if(m.number_of_faces() == 0)
+            {
+                if(cloud.isEmpty())
+                    cloud = height_map.points();
+
+                cloud = cloud.voxelDownsampled(max_points);
+                if(cloud.isEmpty())
+                    return nullptr; // No points loaded
+
+                std::vector<MeshTypes::Point_3> points;
+                points.reserve(cloud.size());
+                for(int i = 0, end = cloud.size(); i < end; ++i)
+                    points.push_back(MeshTypes::Point_3(cloud.x[i], cloud.y[i], cloud.z[i]));
+
+                m = MeshTypes::SurfaceMesh();
+                ConstructPointCloud construct(m,points.begin(),points.end());
+                CGAL::advancing_front_surface_reconstruction(points.begin(),
+                                                             points.end(),
+                                                             construct);
+            }
 
             auto new_mesh = QSharedPointer<OpenMesh>::create(m, file.baseName(), file_path);
             new_mesh->setType(MeshType::kBuild);
@@ -438,49 +464,85 @@ namespace ORNL
         }
     }
 
-    void OpenMesh::convert()
+    MeshTypes::SurfaceMesh OpenMesh::SurfaceMeshFromHeightMap(const HeightMap& height_map)
     {
-        m_representation = MeshTypes::SurfaceMesh(SurfaceMeshFromVerticesAndFaces(m_vertices, m_faces));
-    }
+        typedef MeshTypes::SurfaceMesh::Vertex_index Vertex;
 
-    QVector<MeshTypes::Point_3> OpenMesh::loadMatrixFile(const QString &file_path)
-    {
-        // Open file
-        QFile height(file_path);
+        MeshTypes::SurfaceMesh m;
+        const int rows = height_map.rows;
+        const int columns = height_map.columns;
 
-        if (!height.open(QIODevice::ReadOnly))
+        // One vertex per present sample, missing samples map to null vertices
+        QVector<Vertex> vertices(rows * columns, MeshTypes::SurfaceMesh::null_vertex());
+        int sample_count = 0;
+        for(double height : height_map.heights)
+            sample_count += std::isnan(height) ? 0 : 1;
+        m.reserve(sample_count, 3 * sample_count, 2 * sample_count);
+
+        for(int r = 0; r < rows; ++r)
         {
-             qDebug() << "Could not open file";
-             return QVector<MeshTypes::Point_3>();
+            for(int c = 0; c < columns; ++c)
+            {
+                if(height_map.isValid(r, c))
+                    vertices[r * columns + c] = m.add_vertex(MeshTypes::Point_3(height_map.origin_x + c * height_map.spacing_x,
+                                                                                height_map.origin_y + r * height_map.spacing_y,
+                                                                                height_map.height(r, c)));
+            }
         }
 
-        QVector<MeshTypes::Point_3> points;
-        double x_loc = 5.0;
-        double y_loc = 5.0;
-        while (!height.atEnd())
+        // Corners of each cell in counter-clockwise order seen from above, so faces point up.
+        // Neighbouring cells traverse shared edges in opposite directions, so every face is accepted.
+        for(int r = 0; r + 1 < rows; ++r)
         {
-            QByteArray line = height.readLine();
-            for(auto& entry : line.split(','))
+            for(int c = 0; c + 1 < columns; ++c)
             {
-                entry.trimmed();
-                // Scale to micron
-                points.append(MeshTypes::Point_3(x_loc * 1000, y_loc * 1000, entry.toDouble() * 1000));
-                x_loc += 12.0;
+                Vertex corners[4] = {vertices[r * columns + c], vertices[r * columns + c + 1],
+                                     vertices[(r + 1) * columns + c + 1], vertices[(r + 1) * columns + c]};
+
+                int present = 0;
+                int missing = -1;
+                for(int i = 0; i < 4; ++i)
+                {
+                    if(corners[i] != MeshTypes::SurfaceMesh::null_vertex())
+                        ++present;
+                    else
+                        missing = i;
+                }
+
+                if(present == 4)
+                {
+                    // Split along the diagonal with the smaller height change, which follows ridges and valleys
+                    double diagonal_02 = std::abs(m.point(corners[0]).z() - m.point(corners[2]).z());
+                    double diagonal_13 = std::abs(m.point(corners[1]).z() - m.point(corners[3]).z());
+                    if(diagonal_02 <= diagonal_13)
+                    {
+                        m.add_face(corners[0], corners[1], corners[2]);
+                        m.add_face(corners[0], corners[2], corners[3]);
+                    }
+                    else
+                    {
+                        m.add_face(corners[0], corners[1], corners[3]);
+                        m.add_face(corners[1], corners[2], corners[3]);
+                    }
+                }
+                else if(present == 3)
+                {
+                    // Cells at the edge of a hole keep the triangle spanned by their present corners
+                    m.add_face(corners[(missing + 1) % 4], corners[(missing + 2) % 4], corners[(missing + 3) % 4]);
+                }
             }
-            x_loc = 5.0;
-            y_loc += 12.0;
         }
-        height.close();
-        return points;
+
+        // Samples isolated by holes are not part of any face
+        CGAL::Polygon_mesh_processing::remove_isolated_vertices(m);
+        m.collect_garbage();
+
+        return m;
     }
 
-    QVector<MeshTypes::Point_3> OpenMesh::loadXYZFile(const QString &file_path)
+    void OpenMesh::convert()
     {
-        QVector<MeshTypes::Point_3> points;
-        CGAL::IO::read_points(file_path.toStdString(), std::back_inserter(points));
-        for(auto it = points.begin(); it != points.end(); ++it) // Scale to micron
-            *it = MeshTypes::Point_3(it->x() * 1000, it->y() * 1000, it->z() * 1000);
-
-        return points;
+        m_representation = MeshTypes::SurfaceMesh(SurfaceMeshFromVerticesAndFaces(m_vertices, m_faces));
+        m_acceleration.clear();
     }
 }
@@ -1,6 +1,10 @@
 // Main Module
 #include "geometry/pattern_generator.h"
 
+// Local
+#include "geometry/polyline_clipper.h"
+#include "geometry/global_pattern_cache.h"
+
 namespace ORNL {
 
     QVector<Polyline> PatternGenerator::GenerateLines(PolygonList geometry, Distance lineSpacing, Angle rotation, bool globalBounds, Point min, Point max)
@@ -18,40 +22,18 @@ namespace ORNL {
             max = max.rotate(rotation);
         }
 
-        //! The result we get after intersecting the polygons with the grid lines
-        QVector<Polyline> cutlines;
+        //! The grid lines, clipped against the polygons all at once below
+        QVector<Polyline> gridlines = Rows(RowPattern::kLines, geometry, lineSpacing, Distance(), globalBounds, min, max);
 
-        //! The space left over after all the max number of cutlines are generated
-        //! 计算填充区域内的水平（x 方向）总空间减去每条线的间距，得到填充线格子之间的剩余空白区域 freeSpace。
-        // freeSpace是为了将填充线居中放置，防止填充线挤在某个边缘。
-        Distance freeSpace = (max.toDistance3D().x - min.toDistance3D().x) % lineSpacing;
-
-        //! start at the bounding box's minimum x value and go all the way to the bounding box's maximum x value.
-        //! As we go along, every "line_spacing" distance we intersect the polygons with the grid lines
-        for (Distance x = min.toDistance3D().x + (freeSpace / 2);
-             x < max.toDistance3D().x;
-             x += lineSpacing)
-        {
-            //! Create the grid lines
-            Polyline cutline;
-            cutline << Point(x(), min.y());
-            cutline << Point(x(), max.y());
-
-            //! Intersect the polygons and the gridlines and store them
-            //! \note This calls ClipperLib
-            //! 将生成的填充线和几何区域进行相交操作。只保留填充线与几何边界相交的部分。这个操作调用了第三方库 ClipperLib。
-            cutlines += geometry & cutline;
-        }
+        //! Intersect the polygons and the gridlines, reversing every other result
+        //! 将生成的填充线和几何区域进行相交操作。只保留填充线与几何边界相交的部分。
+        //! 偶数条填充线会被反转，使填充线的起点和终点交替变化，减少连续打印时的移动距离。
+        QVector<Polyline> cutlines = PolylineClipper(geometry).clip(gridlines, true);
 
         //! Unrotate polygons
+        //在生成填充线后，将它们旋转回原始角度（反向旋转），恢复到未旋转的坐标系。
         for(int i = 0; i < cutlines.size(); i++)
-        {
             cutlines[i] = cutlines[i].rotate(-rotation);
-            //在生成填充线后，将它们旋转回原始角度（反向旋转），恢复到未旋转的坐标系。
-            //如果是偶数条填充线，会将其路径反转。这是为了使填充线的起点和终点交替变化，优化路径规划，减少3D打印机头在连续打印时的移动距离。
-            if(i % 2 == 0)
-                cutlines[i] = cutlines[i].reverse();
-        }
 
         return cutlines;
     }
@@ -121,46 +103,13 @@ namespace ORNL {
                 max = max.rotate(rotation);
             }
 
-            QVector<Polyline> cutlines;
-
-            //! The space left over after all the max number of cutlines are generated
-            Distance freeSpace = (max.toDistance3D().x - min.toDistance3D().x) % lineSpacing;
-            int cutCount = ceil(((max.toDistance3D().x - min.toDistance3D().x) / lineSpacing)());
-
-            //! \note Always ensure that there is an odd number of lines so that there is always a line intersecting the center
-            if(cutCount % 2 == 0){
-                --cutCount;
-                freeSpace += lineSpacing;
-            }
-            if(cutCount < 0){
-                cutCount = 0;
-            }
-
-            //! start at the bounding box's minimum x value and go all the way to the bounding box's maximum x value.
-            //! As we go along, every "line_spacing" distance we intersect the polygons with the grid lines
-            //! offseting by half of freespace ensures that a line will always cut through the center
-            for (Distance x = min.toDistance3D().x + (freeSpace / 2);
-                 x < max.toDistance3D().x;
-                 x += lineSpacing)
-            {
-                //! Create the grid lines
-                Polyline cutline;
-                cutline << Point(x(), min.y());
-                cutline << Point(x(), max.y());
-
-                //! Intersect the polygons and the gridlines and store them
-                cutlines += rotated_geometry & cutline;
-            }
+            //! Create the grid lines and intersect them with the polygons, reversing every other result
+            QVector<Polyline> gridlines = Rows(RowPattern::kTriangles, rotated_geometry, lineSpacing, Distance(), globalBounds, min, max);
+            QVector<Polyline> cutlines = PolylineClipper(rotated_geometry).clip(gridlines, true);
 
             //! Unrotate polygons
             for(int i = 0; i < cutlines.size(); i++)
-            {
                 cutlines[i] = cutlines[i].rotate(-rotation);
-                if(i % 2 == 0)
-                {
-                    cutlines[i] = cutlines[i].reverse();
-                }
-            }
 
             result.append(cutlines);
 
@@ -189,39 +138,11 @@ namespace ORNL {
                 max = max.rotate(rotation);
             }
 
-            QVector< Polyline > cutlines;
-
-            Distance freeSpace = (max.toDistance3D().x - min.toDistance3D().x) % lineSpacing;
-            int cutCount = ceil(((max.toDistance3D().x - min.toDistance3D().x) / lineSpacing)());
-
-            if(cutCount % 2 == 1){
-                --cutCount;
-                freeSpace += lineSpacing;
-            }
-            if(cutCount < 0){
-                cutCount = 0;
-            }
-
-            for (Distance x = min.toDistance3D().x + (freeSpace / 2);
-                 x < max.toDistance3D().x;
-                 x += lineSpacing)
-            {
-                //create the grid lines
-                Polyline cutline;
-                cutline << Point(x(), min.y());
-                cutline << Point(x(), max.y());
-
-                cutlines += rotated_geometry & cutline;
-            }
+            QVector< Polyline > gridlines = Rows(RowPattern::kHexagonsAndTriangles, rotated_geometry, lineSpacing, Distance(), globalBounds, min, max);
+            QVector< Polyline > cutlines = PolylineClipper(rotated_geometry).clip(gridlines, true);
 
             for(int i = 0; i < cutlines.size(); i++)
-            {
                 cutlines[i] = cutlines[i].rotate(-rotation);
-                if(i % 2 == 0)
-                {
-                    cutlines[i] = cutlines[i].reverse();
-                }
-            }
 
             result.append(cutlines);
 
@@ -247,80 +168,14 @@ namespace ORNL {
             max = max.rotate(rotation);
         }
 
-        //! \note r^2 = 3/4 * R^2 is used to find the radius of a circumscribed polygon from a supplied side length
-        Distance verticalLineSpacing = sqrt(((lineSpacing * lineSpacing) * 0.75)) * 2;
-        Distance horizontalLineSpacing = lineSpacing;
-
-        QVector<Polyline> cutlines;
-
-        //! Calculate how many cuts we need on each axis.
-        //! \note A hexagon's width is two times its side length.
-        //! \note A hexagon's height is 1/2 of its vertical spacing.
-        int xCutCount = ceil((max.x() - min.x()) / (horizontalLineSpacing() * 2));
-        int yCutCount = ceil((max.y() - min.y()) / (verticalLineSpacing() / 2 + beadWidth()));
-
-        Point currentLocation = min;
-
-        for(int yCount = 0; yCount < yCutCount; yCount++)
-        {
-            Polyline row;
-            for (int xCount = 0; xCount < (xCutCount * 4); xCount++)
-            {
-                switch (xCount % 4)
-                {
-                    case 0:
-                    {
-                        if(xCount==0)
-                            row << currentLocation;
-                        currentLocation = Point(currentLocation.x() + horizontalLineSpacing, currentLocation.y());
-                        row << currentLocation;
-                        break;
-                    }
-                    case 1:
-                    {
-                        if(yCount % 2)
-                            currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() - verticalLineSpacing / 2);
-                        else
-                            currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() + verticalLineSpacing / 2);
-                        row << currentLocation;
-                        break;
-                    }
-                    case 2:
-                    {
-                        currentLocation = Point(currentLocation.x() + horizontalLineSpacing, currentLocation.y());
-                        row << currentLocation;
-                        break;
-                    }
-                    case 3:
-                    {
-                        if(yCount % 2)
-                            currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() + verticalLineSpacing / 2);
-                        else
-                            currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() - verticalLineSpacing / 2);
-                        row << currentLocation;
-                        break;
-                    }
-                }
-            }
-
-            if(yCount % 2){
-                currentLocation = Point(min.x(), currentLocation.y() + beadWidth);
-            }else{
-                currentLocation = Point(min.x(), currentLocation.y() + verticalLineSpacing + beadWidth);
-            }
+        QVector<Polyline> rows = Rows(RowPattern::kHoneyComb, geometry, lineSpacing, beadWidth, globalBounds, min, max);
 
-            cutlines += geometry & row;
-        }
+        //! Intersect the polygons and the rows, reversing every other result
+        QVector<Polyline> cutlines = PolylineClipper(geometry).clip(rows, true);
 
         //! \note Rotate back our cutlines to match the rotation
         for(int i = 0; i < cutlines.size(); i++)
-        {
             cutlines[i] = cutlines[i].rotate(-rotation);
-            if(i % 2 == 0)
-            {
-                cutlines[i] = cutlines[i].reverse();
-            }
-        }
 
         return cutlines;
     }
@@ -334,8 +189,8 @@ namespace ORNL {
         Point outline_minimum = geometry_oriented.min();
         Point outline_maximum = geometry_oriented.max();
 
-        //! The result we get after intersecting the polygons with the grid lines
-        QVector<Polyline> cutlines;
+        //! The grid lines, clipped against the polygons all at once below
+        QVector<Polyline> gridlines;
 
         //! The space left over after all the max number of cutlines are generated
         Distance freeSpace = (outline_maximum.toDistance3D().x - outline_minimum.toDistance3D().x) % lineSpacing;
@@ -360,13 +215,14 @@ namespace ORNL {
                 cutline << Point(x(), outline_minimum.y());
             }
 
-            //! Intersect the polygons and the gridlines and store them
-            //! \note This calls ClipperLib
-            cutlines += geometry_oriented & cutline;
+            gridlines += cutline;
 
             ++alternate;
         }
 
+        //! Intersect the polygons and the gridlines. Direction already alternates with the grid lines.
+        QVector<Polyline> cutlines = PolylineClipper(geometry_oriented).clip(gridlines);
+
         //! Unrotate polygons
         for(int j = 0; j < cutlines.size(); ++j)
         {
@@ -375,4 +231,148 @@ namespace ORNL {
         }
         return cutlines;
     }
+
+    QVector<Polyline> PatternGenerator::GenerateRows(RowPattern pattern, Distance lineSpacing, Distance beadWidth, Point min, Point max)
+    {
+        QVector<Polyline> gridlines;
+
+        switch (pattern)
+        {
+            case RowPattern::kLines:
+            {
+                //! The space left over after all the max number of cutlines are generated
+                //! 计算填充区域内的水平（x 方向）总空间减去每条线的间距，得到填充线格子之间的剩余空白区域 freeSpace。
+                // freeSpace是为了将填充线居中放置，防止填充线挤在某个边缘。
+                Distance freeSpace = (max.toDistance3D().x - min.toDistance3D().x) % lineSpacing;
+
+                //! start at the bounding box's minimum x value and go all the way to the bounding box's maximum x value.
+                //! As we go along, every "line_spacing" distance we create a grid line
+                for (Distance x = min.toDistance3D().x + (freeSpace / 2);
+                     x < max.toDistance3D().x;
+                     x += lineSpacing)
+                {
+                    //! Create the grid lines
+                    Polyline cutline;
+                    cutline << Point(x(), min.y());
+                    cutline << Point(x(), max.y());
+                    gridlines += cutline;
+                }
+                break;
+            }
+            case RowPattern::kTriangles:
+            case RowPattern::kHexagonsAndTriangles:
+            {
+                //! The space left over after all the max number of cutlines are generated
+                Distance freeSpace = (max.toDistance3D().x - min.toDistance3D().x) % lineSpacing;
+                int cutCount = ceil(((max.toDistance3D().x - min.toDistance3D().x) / lineSpacing)());
+
+                //! \note Triangles always use an odd number of lines so that one intersects the center,
+                //! hexagons and triangles an even number
+                int unwanted_parity = (pattern == RowPattern::kTriangles) ? 0 : 1;
+                if(cutCount % 2 == unwanted_parity){
+                    --cutCount;
+                    freeSpace += lineSpacing;
+                }
+                if(cutCount < 0){
+                    cutCount = 0;
+                }
+
+                //! offseting by half of freespace ensures that a line will always cut through the center
+                for (Distance x = min.toDistance3D().x + (freeSpace / 2);
+                     x < max.toDistance3D().x;
+                     x += lineSpacing)
+                {
+                    //! Create the grid lines
+                    Polyline cutline;
+                    cutline << Point(x(), min.y());
+                    cutline << Point(x(), max.y());
+                    gridlines += cutline;
+                }
+                break;
+            }
+            case RowPattern::kHoneyComb:
+            {
+                //! \note r^2 = 3/4 * R^2 is used to find the radius of a circumscribed polygon from a supplied side length
+                Distance verticalLineSpacing = sqrt(((lineSpacing * lineSpacing) * 0.75)) * 2;
+                Distance horizontalLineSpacing = lineSpacing;
+
+                //! Calculate how many cuts we need on each axis.
+                //! \note A hexagon's width is two times its side length.
+                //! \note A hexagon's height is 1/2 of its vertical spacing.
+                int xCutCount = ceil((max.x() - min.x()) / (horizontalLineSpacing() * 2));
+                int yCutCount = ceil((max.y() - min.y()) / (verticalLineSpacing() / 2 + beadWidth()));
+
+                Point currentLocation = min;
+
+                for(int yCount = 0; yCount < yCutCount; yCount++)
+                {
+                    Polyline row;
+                    for (int xCount = 0; xCount < (xCutCount * 4); xCount++)
+                    {
+                        switch (xCount % 4)
+                        {
+                            case 0:
+                            {
+                                if(xCount==0)
+                                    row << currentLocation;
+                                currentLocation = Point(currentLocation.x() + horizontalLineSpacing, currentLocation.y());
+                                row << currentLocation;
+                                break;
+                            }
+                            case 1:
+                            {
+                                if(yCount % 2)
+                                    currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() - verticalLineSpacing / 2);
+                                else
+                                    currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() + verticalLineSpacing / 2);
+                                row << currentLocation;
+                                break;
+                            }
+                            case 2:
+                            {
+                                currentLocation = Point(currentLocation.x() + horizontalLineSpacing, currentLocation.y());
+                                row << currentLocation;
+                                break;
+                            }
+                            case 3:
+                            {
+                                if(yCount % 2)
+                                    currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() + verticalLineSpacing / 2);
+                                else
+                                    currentLocation = Point(currentLocation.x() + (horizontalLineSpacing / 2), currentLocation.y() - verticalLineSpacing / 2);
+                                row << currentLocation;
+                                break;
+                            }
+                        }
+                    }
+
+                    if(yCount % 2){
+                        currentLocation = Point(min.x(), currentLocation.y() + beadWidth);
+                    }else{
+                        currentLocation = Point(min.x(), currentLocation.y() + verticalLineSpacing + beadWidth);
+                    }
+
+                    gridlines += row;
+                }
+                break;
+            }
+        }
+
+        return gridlines;
+    }
+
+    QVector<Polyline> PatternGenerator::Rows(RowPattern pattern, const PolygonList& geometry, Distance lineSpacing, Distance beadWidth,
+                                             bool globalBounds, Point min, Point max)
+    {
+        if (!globalBounds)
+            return GenerateRows(pattern, lineSpacing, beadWidth, min, max);
+
+        //! Every layer with the same pattern, spacing and angle shares one set of rows over the printer area
+        GlobalPatternCache::Key key {static_cast<int>(pattern), lineSpacing(), beadWidth(), min.x(), min.y(), max.x(), max.y()};
+        QSharedPointer<const GlobalPattern> global_pattern = GlobalPatternCache::Get(key, [=]() {
+            return GenerateRows(pattern, lineSpacing, beadWidth, min, max);
+        });
+
+        return global_pattern->rowsOverlapping(geometry.min(), geometry.max());
+    }
 }
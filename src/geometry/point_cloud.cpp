@@ -0,0 +1,222 @@
+// Main Module
+#include "geometry/point_cloud.h"
+
+// Qt
+#include <QHash>
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ORNL
+{
+    namespace
+    {
+        //! \brief Finds a regular lattice that every value sits on
+        //! \param values: coordinates along one axis
+        //! \param origin: set to the smallest value
+        //! \param spacing: set to the lattice spacing
+        //! \param count: set to the number of lattice nodes between the smallest and largest value
+        //! \param max_count: lattices with more nodes than this are rejected
+        bool findLattice(QVector<double> values, double& origin, double& spacing, int& count, int max_count)
+        {
+            std::sort(values.begin(), values.end());
+            origin = values.first();
+
+            double range = values.last() - origin;
+            if (range <= 0.0)
+                return false;
+
+            //! Values closer than this are the same node written out with rounding noise
+            double merge = range * 1e-6;
+            spacing = std::numeric_limits<double>::max();
+            double previous = origin;
+            for (double value : values)
+            {
+                if (value - previous > merge)
+                {
+                    spacing = std::min(spacing, value - previous);
+                    previous = value;
+                }
+            }
+
+            double nodes = std::round(range / spacing) + 1.0;
+            if (nodes > max_count)
+                return false;
+            count = int(nodes);
+
+            double tolerance = spacing * 0.01;
+            for (double value : values)
+            {
+                double offset = value - origin;
+                if (std::abs(offset - std::round(offset / spacing) * spacing) > tolerance)
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    int PointCloud::size() const
+    {
+        return x.size();
+    }
+
+    bool PointCloud::isEmpty() const
+    {
+        return x.isEmpty();
+    }
+
+    void PointCloud::append(double px, double py, double pz)
+    {
+        x.append(px);
+        y.append(py);
+        z.append(pz);
+    }
+
+    void PointCloud::append(const PointCloud& other)
+    {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+    }
+
+    PointCloud PointCloud::voxelDownsampled(int max_points) const
+    {
+        if (max_points <= 0 || size() <= max_points)
+            return *this;
+
+        double min[3] = {x[0], y[0], z[0]};
+        double max[3] = {x[0], y[0], z[0]};
+        for (int i = 1, end = size(); i < end; ++i)
+        {
+            min[0] = std::min(min[0], x[i]); max[0] = std::max(max[0], x[i]);
+            min[1] = std::min(min[1], y[i]); max[1] = std::max(max[1], y[i]);
+            min[2] = std::min(min[2], z[i]); max[2] = std::max(max[2], z[i]);
+        }
+
+        double extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+        if (extent <= 0.0)
+        {
+            PointCloud single;
+            single.append(x[0], y[0], z[0]);
+            return single;
+        }
+
+        //! Scans are surfaces, so the XY area sets the first guess. Voxel indices are
+        //! packed into 21 bits per axis, which bounds the voxel size from below.
+        double area = (max[0] - min[0]) * (max[1] - min[1]);
+        double voxel = (area > 0.0) ? std::sqrt(area / max_points) : extent / max_points;
+        voxel = std::max(voxel, extent / double(1 << 20));
+
+        while (true)
+        {
+            QHash<quint64, int> voxels;
+            voxels.reserve(max_points);
+
+            PointCloud sums;
+            QVector<int> counts;
+            bool too_many = false;
+
+            for (int i = 0, end = size(); i < end && !too_many; ++i)
+            {
+                quint64 ix = quint64((x[i] - min[0]) / voxel);
+                quint64 iy = quint64((y[i] - min[1]) / voxel);
+                quint64 iz = quint64((z[i] - min[2]) / voxel);
+                quint64 key = ix | (iy << 21) | (iz << 42);
+
+                auto found = voxels.find(key);
+                if (found == voxels.end())
+                {
+                    voxels.insert(key, counts.size());
+                    sums.append(x[i], y[i], z[i]);
+                    counts.append(1);
+                    too_many = counts.size() > max_points;
+                }
+                else
+                {
+                    int index = found.value();
+                    sums.x[index] += x[i];
+                    sums.y[index] += y[i];
+                    sums.z[index] += z[i];
+                    ++counts[index];
+                }
+            }
+
+            if (!too_many)
+            {
+                for (int i = 0, end = sums.size(); i < end; ++i)
+                {
+                    sums.x[i] /= counts[i];
+                    sums.y[i] /= counts[i];
+                    sums.z[i] /= counts[i];
+                }
+                return sums;
+            }
+
+            voxel *= 1.25;
+        }
+    }
+
+    bool HeightMap::isEmpty() const
+    {
+        return heights.isEmpty();
+    }
+
+    bool HeightMap::isValid(int r, int c) const
+    {
+        return !std::isnan(heights[r * columns + c]);
+    }
+
+    double HeightMap::height(int r, int c) const
+    {
+        return heights[r * columns + c];
+    }
+
+    PointCloud HeightMap::points() const
+    {
+        PointCloud cloud;
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int c = 0; c < columns; ++c)
+            {
+                if (isValid(r, c))
+                    cloud.append(origin_x + c * spacing_x, origin_y + r * spacing_y, height(r, c));
+            }
+        }
+        return cloud;
+    }
+
+    bool HeightMap::FromPoints(const PointCloud& cloud, HeightMap& map)
+    {
+        const int count = cloud.size();
+        if (count < 4)
+            return false;
+
+        //! Only accept dense grids, a scattered cloud would otherwise become a sparse
+        //! map that triangulates into slivers
+        const int max_nodes = 2 * count;
+
+        HeightMap result;
+        if (!findLattice(cloud.x, result.origin_x, result.spacing_x, result.columns, max_nodes) ||
+            !findLattice(cloud.y, result.origin_y, result.spacing_y, result.rows, max_nodes) ||
+            qint64(result.columns) * result.rows > max_nodes)
+            return false;
+
+        result.heights.fill(std::numeric_limits<double>::quiet_NaN(), result.columns * result.rows);
+        for (int i = 0; i < count; ++i)
+        {
+            int c = int(std::round((cloud.x[i] - result.origin_x) / result.spacing_x));
+            int r = int(std::round((cloud.y[i] - result.origin_y) / result.spacing_y));
+
+            double& sample = result.heights[r * result.columns + c];
+            if (!std::isnan(sample))
+                return false;
+            sample = cloud.z[i];
+        }
+
+        map = result;
+        return true;
+    }
+}
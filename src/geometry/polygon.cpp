@@ -9,6 +9,28 @@
 
 namespace ORNL
 {
+    namespace
+    {
+        //! \brief Signed area of the integer outline, computed like ClipperLib2::Area
+        double integerArea(const Polygon& polygon)
+        {
+            const int size = polygon.size();
+            if (size < 3)
+                return 0;
+
+            const Point* points = polygon.constData();
+            double a = 0;
+            ClipperLib2::IntPoint prev = points[size - 1].toIntPoint();
+            for (int i = 0; i < size; ++i)
+            {
+                ClipperLib2::IntPoint curr = points[i].toIntPoint();
+                a += ((double)prev.X + curr.X) * ((double)prev.Y - curr.Y);
+                prev = curr;
+            }
+            return -a * 0.5;
+        }
+    }
+
     Polygon::Polygon(const QVector< Point >& path)
     {
         for (Point point : path)
@@ -77,7 +99,7 @@ namespace ORNL
 
     bool Polygon::orientation() const
     {
-        return ClipperLib2::Orientation((*this)());
+        return integerArea(*this) >= 0;
     }
 
     PolygonList Polygon::offset(Distance distance,
@@ -278,7 +300,7 @@ namespace ORNL
 
     bool Polygon::inside(const Point& point, bool border_result) const
     {
-        int res = ClipperLib2::PointInPolygon(point.toIntPoint(), (*this)());
+        int res = pointInPolygon(point);
         if (res == -1)
         {
             return border_result;
@@ -286,6 +308,46 @@ namespace ORNL
         return res == 1;
     }
 
+    int Polygon::pointInPolygon(const Point& point) const
+    {
+        // Same crossing test as ClipperLib2::PointInPolygon, walking the points in place
+        const int cnt = size();
+        if (cnt < 3)
+            return 0;
+
+        const Point* points = constData();
+        const ClipperLib2::IntPoint pt = point.toIntPoint();
+        int result = 0;
+        ClipperLib2::IntPoint ip = points[0].toIntPoint();
+        for (int i = 1; i <= cnt; ++i)
+        {
+            ClipperLib2::IntPoint ipNext = points[i == cnt ? 0 : i].toIntPoint();
+            if (ipNext.Y == pt.Y)
+            {
+                if ((ipNext.X == pt.X) || (ip.Y == pt.Y && ((ipNext.X > pt.X) == (ip.X < pt.X))))
+                    return -1;
+            }
+            if ((ip.Y < pt.Y) != (ipNext.Y < pt.Y))
+            {
+                if (ip.X >= pt.X && ipNext.X > pt.X)
+                {
+                    result = 1 - result;
+                }
+                else if (ip.X >= pt.X || ipNext.X > pt.X)
+                {
+                    double d = (double)(ip.X - pt.X) * (ipNext.Y - pt.Y) -
+                               (double)(ipNext.X - pt.X) * (ip.Y - pt.Y);
+                    if (!d)
+                        return -1;
+                    if ((d > 0) == (ipNext.Y > ip.Y))
+                        result = 1 - result;
+                }
+            }
+            ip = ipNext;
+        }
+        return result;
+    }
+
     bool Polygon::overlaps(const Polygon& p){
         ClipperLib2::Clipper clipper;
 
@@ -303,7 +365,7 @@ namespace ORNL
 
     Area Polygon::area() const
     {
-        return Area(ClipperLib2::Area((*this)()));
+        return Area(integerArea(*this));
     }
 
     Point Polygon::centerOfMass() const
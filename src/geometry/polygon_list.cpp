@@ -4,11 +4,82 @@
 // Qt
 #include <QPolygon>
 
+// C++
+#include <algorithm>
+
 //Local
+#include "geometry/segment_grid.h"
 #include "utilities/mathutils.h"
 
 namespace ORNL
 {
+    namespace
+    {
+        /*!
+         * \brief Signed distance from points to the edges of a flat island,
+         * negative outside. Used by poleOfInaccessibility.
+         *
+         * Edges are bucketed in a SegmentGrid, so a query only measures the
+         * edges around the point and only tests the edges in its row for the
+         * even-odd crossing count. Edges are flattened to z = 0.
+         */
+        class IslandDistance
+        {
+        public:
+            IslandDistance(const PolygonList& island)
+            {
+                QVector<Point> starts, ends;
+                for (const Polygon& ring : island)
+                {
+                    for (int i = 0, len = ring.size(), j = len - 1; i < len; j = i++)
+                    {
+                        Point a(ring[j].x(), ring[j].y(), 0);
+                        Point b(ring[i].x(), ring[i].y(), 0);
+
+                        // zero length edges are covered by their neighbors
+                        if (a.x() == b.x() && a.y() == b.y())
+                            continue;
+
+                        starts.push_back(a);
+                        ends.push_back(b);
+                        m_max_x = std::max({m_max_x, a.x(), b.x()});
+                    }
+                }
+                m_edges = SegmentGrid(starts, ends);
+            }
+
+            float operator()(const Point& point) const
+            {
+                if (m_edges.isEmpty())
+                    return -FLT_MAX;
+
+                const Point flat(point.x(), point.y(), 0);
+                Point closest;
+                float distance = FLT_MAX;
+                m_edges.nearest(flat, closest, distance);
+
+                // crossings of a ray towards +x can only come from the edges in the point's row
+                bool inside = false;
+                m_edges.forEachInBox(flat, Point(m_max_x, flat.y(), 0), [&](int index) {
+                    const Point& a = m_edges.start(index);
+                    const Point& b = m_edges.end(index);
+                    if ((a.y() > flat.y()) != (b.y() > flat.y()) &&
+                        flat.x() < (b.x() - a.x()) * (flat.y() - a.y()) / (b.y() - a.y()) + a.x())
+                        inside = !inside;
+                });
+
+                return inside ? distance : -distance;
+            }
+
+        private:
+            //! \brief island edges
+            SegmentGrid m_edges;
+
+            //! \brief largest x of any edge, where crossing rays end
+            float m_max_x = std::numeric_limits<float>::lowest();
+        };
+    }
+
     PolygonList::PolygonList()
     {}
 
@@ -90,10 +161,9 @@ namespace ORNL
     bool PolygonList::inside(Point p, bool border_result)
     {
         int poly_count_inside = 0;
-        for (ClipperLib2::Path poly : (*this)())
+        for (const Polygon& poly : *this)
         {
-            const int is_inside_this_poly =
-                ClipperLib2::PointInPolygon(p.toIntPoint(), poly);
+            const int is_inside_this_poly = poly.pointInPolygon(p);
             if (is_inside_this_poly == -1)
             {
                 return border_result;
@@ -619,7 +689,7 @@ namespace ORNL
     Area PolygonList::totalArea()
     {
         Area total_area;
-        for (Polygon poly : *this)
+        for (const Polygon& poly : *this)
         {
             total_area += poly.area();
         }
@@ -783,58 +853,71 @@ namespace ORNL
         return _xor_with_this(rhs);
     }
 
-    Point PolygonList::poleOfInaccessibility(float precision) // designed for flat shape with no change in z across points
+    Point PolygonList::poleOfInaccessibility(float precision, bool record_cells) // designed for flat shape with no change in z across points
     {
         assert(precision > 0); // to default to the center of the island, set precision greater than length of island
 
         // based on the algorithm devised by mourner: https://github.com/mapbox/polylabel
-        Point curr_point = this->min();
+        const Point min = this->min();
+        const Point max = this->max();
+        const IslandDistance distance_to(*this);
+
+        std::priority_queue<SearchCell, QVector<SearchCell>, CellComparator> cell_queue; // queue of "squares" (two points defining a min and max value)
+        if (record_cells)
+            visual_cells.clear();
+
+        Point curr_point = min;
 
         SearchCell best_cell; // Set current best as the exact middle of island.
-        best_cell.center_point = (this->min()+this->max())/2;
+        best_cell.center_point = (min + max) / 2;
         best_cell.min_point = best_cell.center_point;
         best_cell.max_point = best_cell.center_point;
-        best_cell.distance = this->distanceTo(best_cell.center_point);
+        best_cell.distance = distance_to(best_cell.center_point);
         best_cell.radius = 0;
 
-        float x_length = this->max().x() - this->min().x();
-        float y_length = this->max().y() - this->min().y();
+        float x_length = max.x() - min.x();
+        float y_length = max.y() - min.y();
+
+        // a degenerate island has no area to search, its center is the answer
+        if (x_length <= 0 || y_length <= 0)
+            return best_cell.center_point;
 
         if (x_length > y_length) // fill bounding-box with square cells whose sides are equal to either length or width of the bounding box, whichever is shorter
         {
-            while (curr_point.x() < this->max().x())
+            while (curr_point.x() < max.x())
             {
                 SearchCell new_cell; // set all values of SearchCell
                 new_cell.min_point = curr_point;
                 new_cell.max_point = curr_point + Point(y_length, y_length, 0);
                 new_cell.center_point = (new_cell.min_point+new_cell.max_point)/2;
-                new_cell.distance = this->distanceTo(new_cell.center_point);
+                new_cell.distance = distance_to(new_cell.center_point);
                 new_cell.radius = y_length * qSqrt(2) / 2;
 
-                m_cell_queue.push(new_cell); // push to priority queue
+                cell_queue.push(new_cell); // push to priority queue
                 curr_point.x(curr_point.x() + y_length); // set up for next cell
             }
         } else
         {
-            while (curr_point.y() < this->max().y())
+            while (curr_point.y() < max.y())
             {
                 SearchCell new_cell; // set all values of SearchCell
                 new_cell.min_point = curr_point;
                 new_cell.max_point = curr_point + Point(x_length, x_length, 0);
                 new_cell.center_point = (new_cell.min_point+new_cell.max_point)/2;
-                new_cell.distance = this->distanceTo(new_cell.center_point);
+                new_cell.distance = distance_to(new_cell.center_point);
                 new_cell.radius = x_length * qSqrt(2) / 2;
 
-                m_cell_queue.push(new_cell); // push to priority queue
+                cell_queue.push(new_cell); // push to priority queue
                 curr_point.y(curr_point.y() + x_length); // set up for next cell
             }
         }
 
-        while (!m_cell_queue.empty())
+        while (!cell_queue.empty())
         {
-            SearchCell curr_cell = m_cell_queue.top();
-            m_cell_queue.pop();
-            visual_cells.push_back(curr_cell); // remove this line when finished debugging
+            SearchCell curr_cell = cell_queue.top();
+            cell_queue.pop();
+            if (record_cells)
+                visual_cells.push_back(curr_cell);
             if (curr_cell.distance > best_cell.distance)
             {
                 best_cell = curr_cell;
@@ -849,33 +932,33 @@ namespace ORNL
                 new_cell_q1.min_point = curr_point + Point(0, -curr_length/2, 0);
                 new_cell_q1.max_point = curr_point + Point(curr_length/2, 0, 0);
                 new_cell_q1.center_point = (new_cell_q1.min_point+new_cell_q1.max_point)/2;
-                new_cell_q1.distance = this->distanceTo(new_cell_q1.center_point);
+                new_cell_q1.distance = distance_to(new_cell_q1.center_point);
                 new_cell_q1.radius = curr_length * qSqrt(2) / 4;
-                m_cell_queue.push(new_cell_q1); // push to priority queue
+                cell_queue.push(new_cell_q1); // push to priority queue
 
                 SearchCell new_cell_q2;
                 new_cell_q2.min_point = curr_point + Point(-curr_length/2, -curr_length/2, 0);
                 new_cell_q2.max_point = curr_point + Point(0,0,0); //max_point cannot refer to the same object as curr_point
                 new_cell_q2.center_point = (new_cell_q2.min_point+new_cell_q2.max_point)/2;
-                new_cell_q2.distance = this->distanceTo(new_cell_q2.center_point);
+                new_cell_q2.distance = distance_to(new_cell_q2.center_point);
                 new_cell_q2.radius = curr_length * qSqrt(2) / 4;
-                m_cell_queue.push(new_cell_q2); // push to priority queue
+                cell_queue.push(new_cell_q2); // push to priority queue
 
                 SearchCell new_cell_q3;
                 new_cell_q3.min_point = curr_point + Point(-curr_length/2, 0, 0);
                 new_cell_q3.max_point = curr_point + Point(0, curr_length/2, 0);
                 new_cell_q3.center_point = (new_cell_q3.min_point+new_cell_q3.max_point)/2;
-                new_cell_q3.distance = this->distanceTo(new_cell_q3.center_point);
+                new_cell_q3.distance = distance_to(new_cell_q3.center_point);
                 new_cell_q3.radius = curr_length * qSqrt(2) / 4;
-                m_cell_queue.push(new_cell_q3); // push to priority queue
+                cell_queue.push(new_cell_q3); // push to priority queue
 
                 SearchCell new_cell_q4;
                 new_cell_q4.min_point = curr_point + Point(0, 0, 0);
                 new_cell_q4.max_point = curr_point + Point(curr_length/2, curr_length/2, 0);
                 new_cell_q4.center_point = (new_cell_q4.min_point+new_cell_q4.max_point)/2;
-                new_cell_q4.distance = this->distanceTo(new_cell_q4.center_point);
+                new_cell_q4.distance = distance_to(new_cell_q4.center_point);
                 new_cell_q4.radius = curr_length * qSqrt(2) / 4;
-                m_cell_queue.push(new_cell_q4); // push to priority queue
+                cell_queue.push(new_cell_q4); // push to priority queue
             }
         }
 
@@ -1311,6 +1394,36 @@ namespace ORNL
         return pl;
     }
 
+    PolygonList PolygonList::transform(const QQuaternion& rotation, const Point& shift) const
+    {
+        PolygonList pl;
+        for (const Polygon& polygon : *this)
+        {
+            Polygon moved;
+            moved.reserve(polygon.size());
+            for (const Point& p : polygon)
+                moved.append(Point(rotation.rotatedVector(p.toQVector3D())) + shift);
+            pl.append(moved);
+        }
+        return pl;
+    }
+
+    void PolygonList::addTo(QCryptographicHash& hash) const
+    {
+        int polygon_count = size();
+        hash.addData(reinterpret_cast<const char*>(&polygon_count), sizeof(polygon_count));
+        for (const Polygon& polygon : *this)
+        {
+            int point_count = polygon.size();
+            hash.addData(reinterpret_cast<const char*>(&point_count), sizeof(point_count));
+            for (const Point& p : polygon)
+            {
+                float xy[2] = { p.x(), p.y() };
+                hash.addData(reinterpret_cast<const char*>(xy), sizeof(xy));
+            }
+        }
+    }
+
     float PolygonList::commonArea(PolygonList cur_layer_outline)
     {
         PolygonList temp       = *this;
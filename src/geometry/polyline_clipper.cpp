@@ -0,0 +1,216 @@
+// Main Module
+#include "geometry/polyline_clipper.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ORNL
+{
+    namespace
+    {
+        //! \brief A boundary edge crossed by a polyline segment
+        struct Crossing
+        {
+            //! \brief parameter along the segment
+            double t;
+
+            //! \brief change in winding number when passing it
+            int delta;
+
+            bool operator<(const Crossing& rhs) const { return t < rhs.t; }
+        };
+
+        //! \brief Orientation of c relative to the line through a and b. Points on the
+        //! line count as left of it, which keeps crossing tests consistent where a
+        //! polyline passes exactly through a boundary vertex.
+        inline bool leftOf(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax) >= 0.0;
+        }
+
+        //! \brief Collects the boundary edges crossed by the segment from p to q
+        void crossings(const SegmentGrid& edges, const Point& p, const Point& q, std::vector<Crossing>& result)
+        {
+            result.clear();
+
+            const double px = p.x(), py = p.y(), qx = q.x(), qy = q.y();
+            Point box_min(float(std::min(px, qx)), float(std::min(py, qy)), 0.0f);
+            Point box_max(float(std::max(px, qx)), float(std::max(py, qy)), 0.0f);
+
+            edges.forEachInBox(box_min, box_max, [&](int index)
+            {
+                const Point& a = edges.start(index);
+                const Point& b = edges.end(index);
+                const double ax = a.x(), ay = a.y(), bx = b.x(), by = b.y();
+
+                bool p_left = leftOf(ax, ay, bx, by, px, py);
+                bool q_left = leftOf(ax, ay, bx, by, qx, qy);
+                if (p_left == q_left || leftOf(px, py, qx, qy, ax, ay) == leftOf(px, py, qx, qy, bx, by))
+                    return;
+
+                double sp = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+                double sq = (bx - ax) * (qy - ay) - (by - ay) * (qx - ax);
+                double t = (sp == sq) ? 0.0 : sp / (sp - sq);
+
+                // the region lies left of its edges, so stepping onto the left side enters it
+                result.push_back(Crossing{std::min(std::max(t, 0.0), 1.0), q_left ? 1 : -1});
+            });
+
+            std::sort(result.begin(), result.end());
+        }
+
+        //! \brief Appends a point unless it repeats the last one
+        inline void appendPoint(Polyline& polyline, const Point& point)
+        {
+            if (polyline.isEmpty() || polyline.last().x() != point.x() || polyline.last().y() != point.y())
+                polyline.append(point);
+        }
+    }
+
+    PolylineClipper::PolylineClipper(const PolygonList& boundary)
+    {
+        QVector<Point> starts, ends;
+        for (const Polygon& polygon : boundary)
+        {
+            for (int i = 0, count = polygon.size(); i < count; ++i)
+            {
+                starts.push_back(polygon[i]);
+                ends.push_back(polygon[(i + 1) % count]);
+            }
+        }
+
+        m_min_x = m_min_y = std::numeric_limits<double>::max();
+        m_max_x = m_max_y = std::numeric_limits<double>::lowest();
+        for (const Point& point : starts)
+        {
+            m_min_x = std::min(m_min_x, double(point.x()));
+            m_min_y = std::min(m_min_y, double(point.y()));
+            m_max_x = std::max(m_max_x, double(point.x()));
+            m_max_y = std::max(m_max_y, double(point.y()));
+        }
+
+        m_edges = SegmentGrid(starts, ends);
+    }
+
+    QVector<Polyline> PolylineClipper::clip(const Polyline& polyline) const
+    {
+        QVector<Polyline> result;
+        clipInto(polyline, result);
+        return result;
+    }
+
+    QVector<Polyline> PolylineClipper::clip(const QVector<Polyline>& polylines, bool alternate) const
+    {
+        //! Clip each polyline on its own, the boundary is shared read-only
+        QVector<QVector<Polyline>> pieces(polylines.size());
+        const Polyline* input = polylines.data();
+        QVector<Polyline>* output = pieces.data();
+
+        #pragma omp parallel for schedule(dynamic, 16)
+        for (int i = 0; i < polylines.size(); ++i)
+            clipInto(input[i], output[i]);
+
+        int total = 0;
+        for (const QVector<Polyline>& line_pieces : pieces)
+            total += line_pieces.size();
+
+        QVector<Polyline> result;
+        result.reserve(total);
+        for (const QVector<Polyline>& line_pieces : pieces)
+        {
+            for (const Polyline& piece : line_pieces)
+            {
+                result.append(piece);
+                if (alternate && result.size() % 2 == 1)
+                    std::reverse(result.last().begin(), result.last().end());
+            }
+        }
+
+        return result;
+    }
+
+    int PolylineClipper::startWinding(const Polyline& polyline) const
+    {
+        const Point& start = polyline.first();
+        if (start.x() < m_min_x || start.x() > m_max_x || start.y() < m_min_y || start.y() > m_max_y)
+            return 0;
+
+        //! Walk back from outside the boundary along the first segment's line, so the
+        //! start point is classified with the same crossing rule as the rest of the polyline
+        double dx = 1.0, dy = 0.0;
+        for (int i = 1; i < polyline.size(); ++i)
+        {
+            double ex = polyline[i].x() - start.x(), ey = polyline[i].y() - start.y();
+            double length = std::hypot(ex, ey);
+            if (length > 0.0)
+            {
+                dx = ex / length;
+                dy = ey / length;
+                break;
+            }
+        }
+
+        double reach = std::hypot(m_max_x - m_min_x, m_max_y - m_min_y) + 1.0;
+        Point outside(float(start.x() - dx * reach), float(start.y() - dy * reach), start.z());
+
+        std::vector<Crossing> found;
+        crossings(m_edges, outside, start, found);
+
+        int winding = 0;
+        for (const Crossing& crossing : found)
+            winding += crossing.delta;
+        return winding;
+    }
+
+    void PolylineClipper::clipInto(const Polyline& polyline, QVector<Polyline>& result) const
+    {
+        if (polyline.size() < 2 || m_edges.isEmpty())
+            return;
+
+        int winding = startWinding(polyline);
+
+        Polyline piece;
+        if (winding != 0)
+            piece.append(polyline.first());
+
+        auto finish = [&result, &piece]()
+        {
+            if (piece.size() > 1)
+                result.append(piece);
+            piece.clear();
+        };
+
+        std::vector<Crossing> found;
+        for (int i = 1, count = polyline.size(); i < count; ++i)
+        {
+            const Point& p = polyline[i - 1];
+            const Point& q = polyline[i];
+
+            crossings(m_edges, p, q, found);
+            for (const Crossing& crossing : found)
+            {
+                int previous = winding;
+                winding += crossing.delta;
+                if ((previous == 0) == (winding == 0))
+                    continue;
+
+                //! Clipper works on integer coordinates, round the same way
+                Point cut(float(std::round(p.x() + (q.x() - p.x()) * crossing.t)),
+                          float(std::round(p.y() + (q.y() - p.y()) * crossing.t)),
+                          float(p.z() + (q.z() - p.z()) * crossing.t));
+
+                appendPoint(piece, cut);
+                if (winding == 0)
+                    finish();
+            }
+
+            if (winding != 0)
+                appendPoint(piece, q);
+        }
+
+        finish();
+    }
+}
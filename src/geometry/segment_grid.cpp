@@ -0,0 +1,264 @@
+// Main Module
+#include "geometry/segment_grid.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Local
+#include "utilities/mathutils.h"
+
+namespace ORNL
+{
+    SegmentGrid::SegmentGrid() {}
+
+    SegmentGrid::SegmentGrid(const QVector<Point>& starts, const QVector<Point>& ends, double cell_size)
+        : m_starts(starts), m_ends(ends)
+    {
+        Q_ASSERT(m_starts.size() == m_ends.size());
+        build(cell_size);
+    }
+
+    SegmentGrid SegmentGrid::fromClosedPolygon(const QVector<Point>& points, double cell_size)
+    {
+        QVector<Point> starts, ends;
+        starts.reserve(points.size());
+        ends.reserve(points.size());
+
+        for (int i = 0, count = points.size(); i < count; ++i)
+        {
+            starts.push_back(points[i]);
+            ends.push_back(points[(i + 1) % count]);
+        }
+
+        return SegmentGrid(starts, ends, cell_size);
+    }
+
+    void SegmentGrid::build(double cell_size)
+    {
+        const int count = m_starts.size();
+        if (count == 0)
+            return;
+
+        double min_x = std::numeric_limits<double>::max(), min_y = std::numeric_limits<double>::max();
+        double max_x = std::numeric_limits<double>::lowest(), max_y = std::numeric_limits<double>::lowest();
+        double total_length = 0.0;
+        for (int i = 0; i < count; ++i)
+        {
+            const Point& a = m_starts[i];
+            const Point& b = m_ends[i];
+            min_x = std::min({min_x, (double)a.x(), (double)b.x()});
+            min_y = std::min({min_y, (double)a.y(), (double)b.y()});
+            max_x = std::max({max_x, (double)a.x(), (double)b.x()});
+            max_y = std::max({max_y, (double)a.y(), (double)b.y()});
+            total_length += std::hypot(b.x() - a.x(), b.y() - a.y());
+        }
+
+        // size cells to the typical segment so each one lands in only a few cells
+        if (cell_size <= 0.0)
+            cell_size = total_length / count;
+        cell_size = std::max(cell_size, 1.0);
+
+        // cap the cell count relative to the number of segments so sparse inputs stay cheap to build
+        const double width = max_x - min_x, height = max_y - min_y;
+        const double max_cells = 4.0 * count + 16.0;
+        while ((std::floor(width / cell_size) + 1.0) * (std::floor(height / cell_size) + 1.0) > max_cells)
+            cell_size *= 2.0;
+
+        m_min_x = min_x;
+        m_min_y = min_y;
+        m_cell_size = cell_size;
+        m_columns = (int)std::floor(width / cell_size) + 1;
+        m_rows = (int)std::floor(height / cell_size) + 1;
+
+        // counting pass, then fill pass, to build the flat cell index
+        const int cell_count = m_columns * m_rows;
+        m_cell_offsets.assign(cell_count + 1, 0);
+        for (int i = 0; i < count; ++i)
+        {
+            const Point& a = m_starts[i];
+            const Point& b = m_ends[i];
+            int c0 = column(std::min(a.x(), b.x())), c1 = column(std::max(a.x(), b.x()));
+            int r0 = row(std::min(a.y(), b.y())), r1 = row(std::max(a.y(), b.y()));
+            for (int r = r0; r <= r1; ++r)
+                for (int c = c0; c <= c1; ++c)
+                    ++m_cell_offsets[r * m_columns + c + 1];
+        }
+
+        for (int cell = 0; cell < cell_count; ++cell)
+            m_cell_offsets[cell + 1] += m_cell_offsets[cell];
+
+        m_cell_items.resize(m_cell_offsets[cell_count]);
+        std::vector<int> cursor(m_cell_offsets.begin(), m_cell_offsets.end() - 1);
+        for (int i = 0; i < count; ++i)
+        {
+            const Point& a = m_starts[i];
+            const Point& b = m_ends[i];
+            int c0 = column(std::min(a.x(), b.x())), c1 = column(std::max(a.x(), b.x()));
+            int r0 = row(std::min(a.y(), b.y())), r1 = row(std::max(a.y(), b.y()));
+            for (int r = r0; r <= r1; ++r)
+                for (int c = c0; c <= c1; ++c)
+                    m_cell_items[cursor[r * m_columns + c]++] = i;
+        }
+    }
+
+    int SegmentGrid::column(double x) const
+    {
+        int c = (int)std::floor((x - m_min_x) / m_cell_size);
+        return std::min(std::max(c, 0), m_columns - 1);
+    }
+
+    int SegmentGrid::row(double y) const
+    {
+        int r = (int)std::floor((y - m_min_y) / m_cell_size);
+        return std::min(std::max(r, 0), m_rows - 1);
+    }
+
+    int SegmentGrid::nearest(const Point& p, Point& closest, float& distance, const Filter& filter) const
+    {
+        int best_index = -1;
+        float best_distance = std::numeric_limits<float>::max();
+        Point best_point;
+
+        if (isEmpty())
+            return best_index;
+
+        const int cx = column(p.x()), cy = row(p.y());
+        const int max_ring = std::max(m_columns, m_rows);
+
+        auto visitCell = [&](int c, int r)
+        {
+            const int cell = r * m_columns + c;
+            for (int item = m_cell_offsets[cell], last = m_cell_offsets[cell + 1]; item < last; ++item)
+            {
+                const int index = m_cell_items[item];
+                if (best_index >= 0 && index == best_index)
+                    continue;
+
+                Point target;
+                float dist;
+                std::tie(dist, target) = MathUtils::findClosestPointOnSegment(m_starts[index], m_ends[index], p);
+
+                if (dist > best_distance || (dist == best_distance && index > best_index))
+                    continue;
+
+                if (filter && !filter(index, target))
+                    continue;
+
+                best_index = index;
+                best_distance = dist;
+                best_point = target;
+            }
+        };
+
+        for (int ring = 0; ring <= max_ring; ++ring)
+        {
+            const int c0 = cx - ring, c1 = cx + ring, r0 = cy - ring, r1 = cy + ring;
+
+            // walk only the cells on the border of this ring
+            for (int r = std::max(r0, 0); r <= std::min(r1, m_rows - 1); ++r)
+            {
+                const bool edge_row = (r == r0 || r == r1);
+                for (int c = std::max(c0, 0); c <= std::min(c1, m_columns - 1); ++c)
+                {
+                    if (edge_row || c == c0 || c == c1)
+                        visitCell(c, r);
+                }
+            }
+
+            // any segment not yet seen lies wholly outside the visited square, so it is at least as far away as
+            // the nearest side of that square that still has cells beyond it
+            double bound = std::numeric_limits<double>::max();
+            bool covers_grid = true;
+            if (c0 > 0)
+            {
+                bound = std::min(bound, p.x() - (m_min_x + c0 * m_cell_size));
+                covers_grid = false;
+            }
+            if (c1 < m_columns - 1)
+            {
+                bound = std::min(bound, (m_min_x + (c1 + 1) * m_cell_size) - p.x());
+                covers_grid = false;
+            }
+            if (r0 > 0)
+            {
+                bound = std::min(bound, p.y() - (m_min_y + r0 * m_cell_size));
+                covers_grid = false;
+            }
+            if (r1 < m_rows - 1)
+            {
+                bound = std::min(bound, (m_min_y + (r1 + 1) * m_cell_size) - p.y());
+                covers_grid = false;
+            }
+
+            if (covers_grid || (best_index >= 0 && best_distance < bound))
+                break;
+        }
+
+        if (best_index >= 0)
+        {
+            closest = best_point;
+            distance = best_distance;
+        }
+
+        return best_index;
+    }
+
+    void SegmentGrid::collect(int c0, int r0, int c1, int r1, const std::function<void(int)>& visitor) const
+    {
+        std::vector<int> found;
+        for (int r = r0; r <= r1; ++r)
+        {
+            for (int c = c0; c <= c1; ++c)
+            {
+                const int cell = r * m_columns + c;
+                found.insert(found.end(), m_cell_items.begin() + m_cell_offsets[cell], m_cell_items.begin() + m_cell_offsets[cell + 1]);
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+
+        for (int index : found)
+            visitor(index);
+    }
+
+    void SegmentGrid::forEachInBox(const Point& min, const Point& max, const std::function<void(int)>& visitor) const
+    {
+        if (isEmpty())
+            return;
+
+        // boxes entirely off the grid touch nothing
+        if (max.x() < m_min_x || max.y() < m_min_y ||
+            min.x() > m_min_x + m_columns * m_cell_size || min.y() > m_min_y + m_rows * m_cell_size)
+            return;
+
+        collect(column(min.x()), row(min.y()), column(max.x()), row(max.y()), visitor);
+    }
+
+    void SegmentGrid::forEachNear(const Point& p, double radius, const std::function<void(int)>& visitor) const
+    {
+        forEachInBox(Point(float(p.x() - radius), float(p.y() - radius), 0.0f), Point(float(p.x() + radius), float(p.y() + radius), 0.0f), visitor);
+    }
+
+    int SegmentGrid::size() const
+    {
+        return m_starts.size();
+    }
+
+    bool SegmentGrid::isEmpty() const
+    {
+        return m_starts.isEmpty();
+    }
+
+    const Point& SegmentGrid::start(int index) const
+    {
+        return m_starts[index];
+    }
+
+    const Point& SegmentGrid::end(int index) const
+    {
+        return m_ends[index];
+    }
+}
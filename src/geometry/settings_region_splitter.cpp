@@ -0,0 +1,217 @@
+// Main Module
+#include "geometry/settings_region_splitter.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace ORNL
+{
+    namespace
+    {
+        //! \brief A settings polygon edge crossed by a polyline edge
+        struct Crossing
+        {
+            //! \brief parameter along the polyline edge
+            double t;
+
+            //! \brief id of the polygon the edge belongs to
+            int id;
+
+            //! \brief change in winding number when passing it
+            int delta;
+
+            bool operator<(const Crossing& rhs) const { return t < rhs.t; }
+        };
+
+        //! \brief Orientation of c relative to the line through a and b, points on the line count as left
+        inline bool leftOf(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax) >= 0.0;
+        }
+
+        //! \brief Collects the polygon edges crossed by the segment from p to q
+        void crossings(const SegmentGrid& edges, const QVector<int>& edge_ids, const Point& p, const Point& q, std::vector<Crossing>& result)
+        {
+            result.clear();
+
+            const double px = p.x(), py = p.y(), qx = q.x(), qy = q.y();
+            Point box_min(float(std::min(px, qx)), float(std::min(py, qy)), 0.0f);
+            Point box_max(float(std::max(px, qx)), float(std::max(py, qy)), 0.0f);
+
+            edges.forEachInBox(box_min, box_max, [&](int index)
+            {
+                const Point& a = edges.start(index);
+                const Point& b = edges.end(index);
+                const double ax = a.x(), ay = a.y(), bx = b.x(), by = b.y();
+
+                bool p_left = leftOf(ax, ay, bx, by, px, py);
+                bool q_left = leftOf(ax, ay, bx, by, qx, qy);
+                if (p_left == q_left || leftOf(px, py, qx, qy, ax, ay) == leftOf(px, py, qx, qy, bx, by))
+                    return;
+
+                double sp = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+                double sq = (bx - ax) * (qy - ay) - (by - ay) * (qx - ax);
+                double t = (sp == sq) ? 0.0 : sp / (sp - sq);
+
+                // the polygon lies left of its edges, so stepping onto the left side enters it
+                result.push_back(Crossing{std::min(std::max(t, 0.0), 1.0), edge_ids[index], q_left ? 1 : -1});
+            });
+
+            std::sort(result.begin(), result.end());
+        }
+    }
+
+    SettingsRegionSplitter::SettingsRegionSplitter(const QSharedPointer<SettingsBase>& sb, QVector<SettingsPolygon> settings_polygons)
+    {
+        m_settings.push_back(sb);
+
+        QVector<Point> starts, ends;
+        for (int i = 0, end = settings_polygons.size(); i < end; ++i)
+        {
+            QSharedPointer<SettingsBase> merged = QSharedPointer<SettingsBase>::create(*sb);
+            merged->populate(settings_polygons[i].getSettings());
+            m_settings.push_back(merged);
+
+            // a polygon that changes nothing never splits a path
+            if (merged->json() == sb->json())
+                continue;
+
+            for (const Polygon& polygon : settings_polygons[i])
+            {
+                for (int j = 0, count = polygon.size(); j < count; ++j)
+                {
+                    starts.push_back(polygon[j]);
+                    ends.push_back(polygon[(j + 1) % count]);
+                    m_edge_ids.push_back(i + 1);
+                }
+            }
+        }
+
+        m_min_x = m_min_y = std::numeric_limits<double>::max();
+        m_max_x = m_max_y = std::numeric_limits<double>::lowest();
+        for (const Point& point : starts)
+        {
+            m_min_x = std::min(m_min_x, double(point.x()));
+            m_min_y = std::min(m_min_y, double(point.y()));
+            m_max_x = std::max(m_max_x, double(point.x()));
+            m_max_y = std::max(m_max_y, double(point.y()));
+        }
+
+        m_edges = SegmentGrid(starts, ends);
+    }
+
+    bool SettingsRegionSplitter::isEmpty() const
+    {
+        return m_edges.isEmpty();
+    }
+
+    const QSharedPointer<SettingsBase>& SettingsRegionSplitter::settings(int id) const
+    {
+        return m_settings[id];
+    }
+
+    QVector<SettingsRegionSplitter::Span> SettingsRegionSplitter::split(const Polyline& line, int edge_count) const
+    {
+        QVector<Span> spans;
+        if (line.size() < 2 || edge_count <= 0)
+            return spans;
+
+        spans.reserve(edge_count);
+        if (isEmpty())
+        {
+            for (int j = 0; j < edge_count; ++j)
+                spans.push_back(Span{line[j], line[(j + 1) % line.size()], 0});
+            return spans;
+        }
+
+        QVector<int> windings = startWindings(line);
+        int id = activeId(windings);
+
+        std::vector<Crossing> found;
+        for (int j = 0; j < edge_count; ++j)
+        {
+            const Point& p = line[j];
+            const Point& q = line[(j + 1) % line.size()];
+
+            Point start = p;
+            start.setSettings(m_settings[id]);
+
+            crossings(m_edges, m_edge_ids, p, q, found);
+            for (const Crossing& crossing : found)
+            {
+                windings[crossing.id] += crossing.delta;
+                int next = activeId(windings);
+                if (next == id)
+                    continue;
+
+                //! Round the same way Clipper did when the paths were split with it
+                Point cut(float(std::round(p.x() + (q.x() - p.x()) * crossing.t)),
+                          float(std::round(p.y() + (q.y() - p.y()) * crossing.t)),
+                          float(p.z() + (q.z() - p.z()) * crossing.t));
+
+                if (cut.x() != start.x() || cut.y() != start.y())
+                {
+                    spans.push_back(Span{start, cut, id});
+                    start = cut;
+                }
+
+                id = next;
+                start.setSettings(m_settings[id]);
+            }
+
+            Point end = q;
+            end.setSettings(m_settings[id]);
+            spans.push_back(Span{start, end, id});
+        }
+
+        return spans;
+    }
+
+    int SettingsRegionSplitter::activeId(const QVector<int>& windings) const
+    {
+        for (int id = windings.size() - 1; id > 0; --id)
+        {
+            if (windings[id] != 0)
+                return id;
+        }
+
+        return 0;
+    }
+
+    QVector<int> SettingsRegionSplitter::startWindings(const Polyline& line) const
+    {
+        QVector<int> windings(m_settings.size(), 0);
+
+        const Point& start = line.first();
+        if (start.x() < m_min_x || start.x() > m_max_x || start.y() < m_min_y || start.y() > m_max_y)
+            return windings;
+
+        //! Walk in from outside along the first edge's line, so the start is classified
+        //! with the same crossing rule as the rest of the polyline
+        double dx = 1.0, dy = 0.0;
+        for (int i = 1; i < line.size(); ++i)
+        {
+            double ex = line[i].x() - start.x(), ey = line[i].y() - start.y();
+            double length = std::hypot(ex, ey);
+            if (length > 0.0)
+            {
+                dx = ex / length;
+                dy = ey / length;
+                break;
+            }
+        }
+
+        double reach = std::hypot(m_max_x - m_min_x, m_max_y - m_min_y) + 1.0;
+        Point outside(float(start.x() - dx * reach), float(start.y() - dy * reach), start.z());
+
+        std::vector<Crossing> found;
+        crossings(m_edges, m_edge_ids, outside, start, found);
+        for (const Crossing& crossing : found)
+            windings[crossing.id] += crossing.delta;
+
+        return windings;
+    }
+}
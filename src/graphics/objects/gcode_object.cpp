@@ -5,7 +5,8 @@
 #include "graphics/base_view.h"
 
 namespace ORNL {    
-    GCodeObject::GCodeObject(BaseView* view, QVector<QVector<QSharedPointer<SegmentBase>>> gcode, QSharedPointer<GCodeInfoControl> segmentInfoControl) {
+    GCodeObject::GCodeObject(BaseView* view, QVector<QVector<QSharedPointer<SegmentBase>>> gcode, QSharedPointer<GCodeInfoControl> segmentInfoControl,
+                             const QVector<QByteArray>& layer_keys, QSharedPointer<GCodeObject> previous) {
         std::vector<float> vertices;
         std::vector<float> normals;
         std::vector<float> colors;
@@ -15,11 +16,29 @@ namespace ORNL {
 
         m_segments.reserve(gcode.size());
 
-        for (auto& layer : gcode) {
+        if (layer_keys.size() == gcode.size()) m_layer_keys = layer_keys;
+
+        // Layers of the previous object by key, so unchanged layers can be copied rather than built again
+        QHash<QByteArray, int> previous_layers;
+        if (!m_layer_keys.isEmpty() && !previous.isNull() && previous->m_layer_keys.size() == previous->m_segments.size()) {
+            for (int i = 0, end = previous->m_layer_keys.size(); i < end; ++i)
+                previous_layers.insert(previous->m_layer_keys[i], i);
+        }
+
+        for (int layer_index = 0, layer_count = gcode.size(); layer_index < layer_count; ++layer_index) {
+            QVector<QSharedPointer<SegmentBase>>& layer = gcode[layer_index];
             QVector<QSharedPointer<SegmentDisplayMeta>> layer_meta;
             layer_meta.reserve(layer.size());
 
-            for (auto& segment : layer) {
+            const QVector<QSharedPointer<SegmentDisplayMeta>>* previous_meta = nullptr;
+            if (!previous_layers.isEmpty()) {
+                auto match = previous_layers.constFind(m_layer_keys[layer_index]);
+                if (match != previous_layers.constEnd() && previous->m_segments[match.value()].size() == layer.size())
+                    previous_meta = &previous->m_segments[match.value()];
+            }
+
+            for (int segment_index = 0, segment_count = layer.size(); segment_index < segment_count; ++segment_index) {
+                QSharedPointer<SegmentBase>& segment = layer[segment_index];
                 QSharedPointer<SegmentDisplayMeta> seg_meta = QSharedPointer<SegmentDisplayMeta>::create();
                 seg_meta->layer  = segment->layerNumber();
                 seg_meta->line   = segment->lineNumber();
@@ -28,7 +47,28 @@ namespace ORNL {
                 seg_meta->current_color  = segment->color();
                 seg_meta->offset = vertices.size() / 3;
 
-                segment->createGraphic(vertices, normals, colors);
+                if (previous_meta != nullptr) {
+                    // Same inputs give the same tube, only the color is set again since the old one may be painted
+                    const SegmentDisplayMeta& old_meta = *(*previous_meta)[segment_index];
+                    const std::vector<float>& old_vertices = previous->vertices();
+                    const std::vector<float>& old_normals = previous->normals();
+
+                    vertices.insert(vertices.end(), old_vertices.begin() + old_meta.offset * 3,
+                                    old_vertices.begin() + (old_meta.offset + old_meta.length) * 3);
+                    normals.insert(normals.end(), old_normals.begin() + old_meta.offset * 3,
+                                   old_normals.begin() + (old_meta.offset + old_meta.length) * 3);
+
+                    QColor color = segment->color();
+                    for (uint i = 0; i < old_meta.length; i++) {
+                        colors.push_back(color.redF());
+                        colors.push_back(color.greenF());
+                        colors.push_back(color.blueF());
+                        colors.push_back(color.alphaF());
+                    }
+                }
+                else {
+                    segment->createGraphic(vertices, normals, colors);
+                }
 
                 seg_meta->length = (vertices.size() / 3) - seg_meta->offset;
 
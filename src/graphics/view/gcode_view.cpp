@@ -59,7 +59,8 @@ namespace ORNL {
             if(m_state.high_layer >= gcode.size())
                 m_state.high_layer = gcode.size() - 1;
 
-            m_gcode_object = QSharedPointer<GCodeObject>::create(this, gcode, m_segment_info_control);
+            QSharedPointer<GCodeObject> previous = m_gcode_object.isNull() ? m_previous_gcode_object : m_gcode_object;
+            m_gcode_object = QSharedPointer<GCodeObject>::create(this, gcode, m_segment_info_control, m_layer_keys, previous);
             m_gcode_object->showLayers(m_state.low_layer, m_state.high_layer);
             m_gcode_object->hideSegmentType(m_state.hidden_type, true);
 
@@ -89,10 +90,19 @@ namespace ORNL {
         }
 
 
+        // keys only describe the gcode they were sent with
+        m_layer_keys.clear();
+        m_previous_gcode_object.reset();
+
         this->update();
         m_gcode = gcode;
     }
 
+    void GCodeView::setLayerKeys(QVector<QByteArray> keys)
+    {
+        m_layer_keys = keys;
+    }
+
     void GCodeView::hideSegmentType(SegmentDisplayType type, bool hidden)
     {
         m_state.hidden_type = (hidden) ? (m_state.hidden_type | type) : (m_state.hidden_type & ~type);
@@ -107,6 +117,9 @@ namespace ORNL {
     void GCodeView::updateSegmentWidths(bool use_true_width)
     {
         clear();
+
+        // the old geometry was drawn with the old widths
+        m_previous_gcode_object.reset();
         m_use_true_segment_widths = use_true_width;
 
         // Adjust existing G-code
@@ -404,6 +417,9 @@ namespace ORNL {
         if (m_gcode_object.isNull()) return;
 
         m_printer->orphanChild(m_gcode_object);
+
+        // kept so a reload after a slice can reuse the layers that did not change
+        m_previous_gcode_object = m_gcode_object;
         m_gcode_object.reset();
 
         this->update();
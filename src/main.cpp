@@ -7,6 +7,7 @@
 #include "utilities/msg_handler.h"
 #include "part/part.h"
 #include "gcode/gcode_command.h"
+#include "gcode/gcode_text_index.h"
 #include "units/unit.h"
 #include "utilities/enums.h"
 #include "utilities/qt_json_conversion.h"
@@ -30,6 +31,7 @@ int main(int argc, char* argv[])
     qRegisterMetaType<QSharedPointer<ORNL::OpenMesh> >("QSharedPointer<OpenMesh>");
     qRegisterMetaType<QSharedPointer<ORNL::MeshBase> >("QSharedPointer<MeshBase>");
     qRegisterMetaType<QVector<QVector<QSharedPointer<ORNL::SegmentBase>>>>("QVector<QVector<QSharedPointer<SegmentBase>>>");
+    qRegisterMetaType<QVector<QByteArray>>("QVector<QByteArray>");
     qRegisterMetaType<ORNL::Distance>("Distance");
     qRegisterMetaType<ORNL::Velocity>("Velocity");
     qRegisterMetaType<ORNL::Acceleration>("Acceleration");
@@ -38,7 +40,7 @@ int main(int argc, char* argv[])
     qRegisterMetaType<ORNL::Temperature>("Temperature");
     qRegisterMetaType<ORNL::Voltage>("Voltage");
     qRegisterMetaType<ORNL::Mass>("Mass");
-    qRegisterMetaType<QHash<QString,QTextCharFormat>>("QHash<QString,QTextCharFormat>");
+    qRegisterMetaType<ORNL::GcodeTextIndex>("GcodeTextIndex");
     qRegisterMetaType<QList<ORNL::Time>>("QList<Time>");
     qRegisterMetaType<QList<int>>("QList<int>");
     qRegisterMetaType<ORNL::StatusUpdateStepType>("StatusUpdateStepType");
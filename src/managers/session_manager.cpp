@@ -1,6 +1,7 @@
 // Qt
 #include <QStandardPaths>
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QUuid>
 
 #include <threading/slicers/skeleton_slicer.h>
@@ -27,6 +28,8 @@
 #include "utilities/qt_json_conversion.h"
 #include "gcode/gcode_meta.h"
 #include "geometry/mesh/mesh_factory.h"
+#include "geometry/global_pattern_cache.h"
+#include "build_id.h"
 
 namespace ORNL
 {
@@ -363,12 +366,19 @@ namespace ORNL
         QSharedPointer<Part> old_part = m_parts[part->name()];
         m_parts.remove(old_part->name());
 
-        if(m_models.contains(part->rootMesh()->name()))
-            m_models.remove(part->rootMesh()->name());
+        // Models are stored by file name, and may still be used by another part from the same file
+        QString file_name = part->rootMesh()->path().split("/").back();
+        bool file_in_use = false;
+        for(auto& other : m_parts)
+            file_in_use = file_in_use || other->rootMesh()->path().split("/").back() == file_name;
 
-        for(auto& model : part->subMeshes())
-            if(m_models.contains(model->name()))
-                m_models.remove(model->name());
+        if(!file_in_use && m_models.contains(file_name))
+        {
+            // A save in progress may still be copying the model
+            waitForSessionSavers();
+            free(m_models[file_name].model);
+            m_models.remove(file_name);
+        }
 
         emit partRemoved(old_part);
 
@@ -378,14 +388,7 @@ namespace ORNL
     bool SessionManager::removePart(QString name) {
         if (!m_parts.contains(name)) return false;
 
-        // Keep the part around for a second so we can emit a removed signal. That way, any object that wants to
-        // perform some finals operations on the part can still do so.
-        QSharedPointer<Part> old_part = m_parts[name];
-        m_parts.remove(name);
-
-        emit partRemoved(old_part);
-
-        return true;
+        return removePart(m_parts[name]);
     }
 
     void SessionManager::clearParts() {
@@ -416,56 +419,82 @@ namespace ORNL
 
     bool SessionManager::loadPartsJson(fifojson j)
     {
-        int totalParts = 0;
-        for (auto it : j[Constants::Settings::Session::kParts].items())
+        struct part_entry
         {
-            ++totalParts;
-        }
-
-        emit totalPartsInProject(totalParts);
+            QString name;
+            MeshType mesh_type;
+            MeshGeneratorType gen_type;
+            Distance3D org_dims;
+            QVector<QMatrix4x4> mtrxes;
+            QString filename;
+        };
 
+        QVector<part_entry> entries;
         for (auto it : j[Constants::Settings::Session::kParts].items())
         {
             // Get mesh information
-            QString name = QString::fromStdString(it.key());
-            MeshType mesh_type = it.value()[Constants::Settings::Session::kMeshType];
-            MeshGeneratorType gen_type = it.value()[Constants::Settings::Session::kGenType];
-            Distance3D org_dims(it.value()[Constants::Settings::Session::kOrgDims]["x"],
-                                it.value()[Constants::Settings::Session::kOrgDims]["y"],
-                                it.value()[Constants::Settings::Session::kOrgDims]["z"]);
+            part_entry entry;
+            entry.name = QString::fromStdString(it.key());
+            entry.mesh_type = it.value()[Constants::Settings::Session::kMeshType];
+            entry.gen_type = it.value()[Constants::Settings::Session::kGenType];
+            entry.org_dims = Distance3D(it.value()[Constants::Settings::Session::kOrgDims]["x"],
+                                        it.value()[Constants::Settings::Session::kOrgDims]["y"],
+                                        it.value()[Constants::Settings::Session::kOrgDims]["z"]);
             auto mtrxesArray = it.value()[Constants::Settings::Session::kTransforms];
 
-            int transformCount = 1;
-            QVector<QMatrix4x4> mtrxes;
             if(mtrxesArray.size() == 0){
                 QMatrix4x4 mtrx = it.value()[Constants::Settings::Session::kTransform];
-                mtrxes.append(mtrx);
+                entry.mtrxes.append(mtrx);
             }
             else{
-                transformCount = (int)mtrxesArray.size();
+                int transformCount = (int)mtrxesArray.size();
                 for(auto i = 0; i < transformCount; i++){
                     QMatrix4x4 mx = mtrxesArray[i];
-                    mtrxes.append(mx);
+                    entry.mtrxes.append(mx);
                 }
             }
 
-            switch(gen_type)
+            if(entry.gen_type == kNone)
+                entry.filename = QString::fromStdString(it.value()[Constants::Settings::Session::kFile]);
+
+            entries.append(entry);
+        }
+
+        emit totalPartsInProject(entries.size());
+
+        // Parsing models dominates loading, so they are parsed in parallel and added in order afterwards
+        QVector<QVector<MeshLoader::MeshData>> loaded(entries.size());
+        QVector<MeshLoader::MeshData>* loaded_data = loaded.data();
+        const part_entry* entry_data = entries.constData();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            const part_entry& entry = entry_data[i];
+            if(entry.gen_type == kNone && m_models.contains(entry.filename)) // Allready have this model data
+            {
+                auto data = m_models.value(entry.filename);
+                loaded_data[i] = MeshLoader::LoadMeshes(entry.filename, entry.mesh_type, entry.mtrxes[0], Distance(mm), data.model, data.size);
+            }
+        }
+
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            const QString& name = entries[i].name;
+            MeshType mesh_type = entries[i].mesh_type;
+            const Distance3D& org_dims = entries[i].org_dims;
+            const QVector<QMatrix4x4>& mtrxes = entries[i].mtrxes;
+
+            switch(entries[i].gen_type)
             {
                 case kNone: // Not generated, so load from file
                 {
-                    QString filename = QString::fromStdString(it.value()[Constants::Settings::Session::kFile]);
-
-                    if(m_models.contains(filename)) // Allready have this model data
+                    for(auto mesh_data : loaded[i])
                     {
-                        auto data = m_models.value(filename);
-                        auto meshes = MeshLoader::LoadMeshes(filename, mesh_type, mtrxes[0], Distance(mm), data.model, data.size);
-                        for(auto mesh_data : meshes)
-                        {
-                            mesh_data.mesh->setTransformations(mtrxes);
-
-                            mesh_data.mesh->setName(name);
-                            addPart(mesh_data.mesh);
-                        }
+                        mesh_data.mesh->setTransformations(mtrxes);
+
+                        mesh_data.mesh->setName(name);
+                        addPart(mesh_data.mesh);
                     }
                     break;
                 }
@@ -561,6 +590,22 @@ namespace ORNL
         // Request new information about the parts to be sliced.
         emit requestTransformationUpdate();
 
+        // The output file is rewritten from here on, until the slice completes it matches no inputs
+        QByteArray input_hash = sliceInputHash();
+        {
+            QMutexLocker locker(&m_toolpath_mutex);
+
+            // Patterns generated for other settings would only be found again if they were changed back
+            if(m_slice_input_hash != input_hash)
+                GlobalPatternCache::Clear();
+
+            m_slice_input_hash = input_hash;
+            m_output_input_hash.clear();
+        }
+
+        if(restoreStoredToolpath())
+            return true;
+
         emit startSlice();
 
         return true;
@@ -568,11 +613,115 @@ namespace ORNL
 
     bool SessionManager::sliceComplete()
     {
+        {
+            QMutexLocker locker(&m_toolpath_mutex);
+            m_output_input_hash = m_slice_input_hash;
+        }
 
         emit forwardSliceComplete(tempGcodeFile, true);
         return true;
     }
 
+    QByteArray SessionManager::sliceInputHash()
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+
+        // Another build of the slicer may change its output, where it is installed does not
+        hash.addData(QByteArray(APP_BUILD_ID));
+        hash.addData(QByteArray::number(static_cast<int>(m_slicer_type)));
+
+        // Only the models of parts in the scene, found the same way the session saves them
+        QStringList file_names;
+        for(auto& part : m_parts)
+        {
+            QString file_name = part->rootMesh()->path().split("/").back();
+            if(!file_names.contains(file_name))
+                file_names.push_back(file_name);
+        }
+        file_names.sort();
+
+        for(const QString& file_name : file_names)
+        {
+            hash.addData(file_name.toUtf8());
+            auto model = m_models.constFind(file_name);
+            if(model != m_models.constEnd())
+                hash.addData(static_cast<const char*>(model.value().model), int(model.value().size));
+        }
+
+        hash.addData(QByteArray::fromStdString(partsJson().dump()));
+        hash.addData(QByteArray::fromStdString(GSM->globalJson().dump()));
+        for(auto& part : m_parts)
+        {
+            hash.addData(QByteArray::fromStdString(part->getSb()->json().dump()));
+            hash.addData(QByteArray::fromStdString(part->rangesJson().dump()));
+        }
+
+        return hash.result().toHex();
+    }
+
+    QByteArray SessionManager::currentToolpath(QByteArray& input_hash)
+    {
+        input_hash = sliceInputHash();
+
+        QMutexLocker locker(&m_toolpath_mutex);
+        if(!isToolpathCacheable())
+            return QByteArray();
+
+        if(m_output_input_hash == input_hash)
+        {
+            QFile file(tempGcodeFile);
+            if(file.open(QIODevice::ReadOnly))
+                return file.readAll();
+        }
+
+        if(m_stored_toolpath_hash == input_hash)
+            return qUncompress(m_stored_toolpath);
+
+        return QByteArray();
+    }
+
+    void SessionManager::setStoredToolpath(const QByteArray& input_hash, const QByteArray& compressed)
+    {
+        QMutexLocker locker(&m_toolpath_mutex);
+        m_stored_toolpath_hash = input_hash;
+        m_stored_toolpath = compressed;
+    }
+
+    bool SessionManager::isToolpathCacheable()
+    {
+        // Real time slicers stream to a machine, and sensor, spiral and external grid data are not part of the inputs
+        return m_slicer_type != SlicerType::kRealTimePolymer && m_slicer_type != SlicerType::kRealTimeRPBF &&
+               m_active_connections.isEmpty() && m_grid_info.m_grid_layers.isEmpty() &&
+               !m_sensor_files_generated && !m_spiral_visualization_files_generated;
+    }
+
+    bool SessionManager::restoreStoredToolpath()
+    {
+        QMutexLocker locker(&m_toolpath_mutex);
+        if(!isToolpathCacheable() || m_stored_toolpath.isEmpty() || m_stored_toolpath_hash != m_slice_input_hash)
+            return false;
+
+        QByteArray gcode = qUncompress(m_stored_toolpath);
+        QFile file(tempGcodeFile);
+        if(gcode.isEmpty() || !file.open(QIODevice::WriteOnly))
+            return false;
+
+        if(file.write(gcode) != gcode.size())
+            return false;
+        file.close();
+
+        m_output_input_hash = m_slice_input_hash;
+        locker.unlock();
+
+        for(StatusUpdateStepType type : {StatusUpdateStepType::kPreProcess, StatusUpdateStepType::kCompute,
+                                         StatusUpdateStepType::kPostProcess, StatusUpdateStepType::kGcodeGeneraton})
+            emit updateDialog(type, 100);
+
+        // The stored g-code was already adjusted when it was first loaded
+        emit forwardSliceComplete(tempGcodeFile, false);
+        return true;
+    }
+
     void SessionManager::forwardDialogUpdate(StatusUpdateStepType type, int completedPercentage)
     {
         emit updateDialog(type, completedPercentage);
@@ -794,6 +943,8 @@ namespace ORNL
 
         SessionLoader* loader = new SessionLoader(path, true);
         connect(loader, &SessionLoader::finished, loader, &SessionLoader::deleteLater);
+        m_session_savers.removeAll(QPointer<SessionLoader>());
+        m_session_savers.push_back(loader);
 
         loader->start();
         m_file = path;
@@ -804,11 +955,22 @@ namespace ORNL
         return loader;
     }
 
+    void SessionManager::waitForSessionSavers()
+    {
+        for(QPointer<SessionLoader>& saver : m_session_savers)
+        {
+            if(!saver.isNull())
+                saver->wait();
+        }
+        m_session_savers.clear();
+    }
+
     void SessionManager::loadSession(bool shouldDelete, QString path)
     {
         // Clear out old data if necessary.
         if(shouldDelete)
         {
+            waitForSessionSavers();
             for (model_data file : m_models)
                 free(file.model);
 
@@ -0,0 +1,70 @@
+#include "net_functions/printer_transport.h"
+
+// Qt
+#include <QUrlQuery>
+
+// Local
+#include "net_functions/tcp_printer_transport.h"
+#include "net_functions/serial_printer_transport.h"
+#include "net_functions/pty_printer_transport.h"
+
+namespace ORNL
+{
+    PrinterTransport::PrinterTransport(QObject* parent) : QObject(parent) {}
+
+    PrinterTransport::~PrinterTransport() {}
+
+    PrinterTransport* PrinterTransport::Create(const QUrl& url, QObject* parent)
+    {
+        QString scheme = url.scheme().toLower();
+
+        if (scheme == "tcp")
+            return new TcpPrinterTransport(url.host(), url.port(), parent);
+
+        if (scheme == "serial")
+        {
+            // serial://COM3 carries the port as the host, serial:///dev/ttyUSB0 as the path
+            QString port_name = url.host().isEmpty() ? url.path() : url.host();
+            int baud = 115200;
+            bool ok = false;
+            int requested_baud = QUrlQuery(url).queryItemValue("baud").toInt(&ok);
+            if (ok && requested_baud > 0)
+                baud = requested_baud;
+
+            return new SerialPrinterTransport(port_name, baud, parent);
+        }
+
+        if (scheme == "pty")
+            return new PtyPrinterTransport(url.path(), parent);
+
+        return nullptr;
+    }
+
+    void PrinterTransport::receive(const QByteArray& bytes)
+    {
+        int line_start = 0;
+        for (int i = 0, size = bytes.size(); i < size; ++i)
+        {
+            if (bytes[i] != '\n')
+                continue;
+
+            QByteArray line = m_partial_line;
+            line.append(bytes.constData() + line_start, i - line_start);
+            m_partial_line.clear();
+            line_start = i + 1;
+
+            if (line.endsWith('\r'))
+                line.chop(1);
+
+            if (!line.isEmpty())
+                emit lineReceived(line);
+        }
+
+        m_partial_line.append(bytes.constData() + line_start, bytes.size() - line_start);
+    }
+
+    void PrinterTransport::resetReceiveBuffer()
+    {
+        m_partial_line.clear();
+    }
+}
@@ -0,0 +1,156 @@
+#include "net_functions/pty_printer_transport.h"
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace ORNL
+{
+    PtyPrinterTransport::PtyPrinterTransport(const QString& device_path, QObject* parent)
+        : PrinterTransport(parent), m_device_path(device_path), m_fd(-1), m_read_notifier(nullptr), m_write_notifier(nullptr)
+    {
+    }
+
+    PtyPrinterTransport::~PtyPrinterTransport()
+    {
+        close();
+    }
+
+    bool PtyPrinterTransport::open()
+    {
+        #ifdef Q_OS_UNIX
+        if (m_fd >= 0)
+            return true;
+
+        m_fd = ::open(m_device_path.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (m_fd < 0)
+        {
+            emit error(QString("Could not open %1: %2").arg(m_device_path, QString::fromLocal8Bit(std::strerror(errno))));
+            return false;
+        }
+
+        // raw mode: no echo, no line editing and no newline translation
+        termios options;
+        if (tcgetattr(m_fd, &options) == 0)
+        {
+            cfmakeraw(&options);
+            tcsetattr(m_fd, TCSANOW, &options);
+        }
+
+        resetReceiveBuffer();
+        m_pending.clear();
+
+        m_read_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        connect(m_read_notifier, &QSocketNotifier::activated, this, &PtyPrinterTransport::readAvailable);
+
+        m_write_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Write, this);
+        m_write_notifier->setEnabled(false);
+        connect(m_write_notifier, &QSocketNotifier::activated, this, &PtyPrinterTransport::flushPending);
+
+        emit opened();
+        return true;
+        #else
+        emit error("Pseudo-terminal printer connections are only available on POSIX systems");
+        return false;
+        #endif
+    }
+
+    void PtyPrinterTransport::close()
+    {
+        #ifdef Q_OS_UNIX
+        if (m_fd < 0)
+            return;
+
+        // this may run from a notifier's own activated signal, so only silence the notifiers here
+        m_read_notifier->setEnabled(false);
+        m_read_notifier->deleteLater();
+        m_read_notifier = nullptr;
+        m_write_notifier->setEnabled(false);
+        m_write_notifier->deleteLater();
+        m_write_notifier = nullptr;
+
+        ::close(m_fd);
+        m_fd = -1;
+        m_pending.clear();
+
+        emit closed();
+        #endif
+    }
+
+    bool PtyPrinterTransport::isOpen() const
+    {
+        return m_fd >= 0;
+    }
+
+    qint64 PtyPrinterTransport::write(const QByteArray& data)
+    {
+        if (m_fd < 0)
+            return -1;
+
+        m_pending.append(data);
+        flushPending();
+        return data.size();
+    }
+
+    QString PtyPrinterTransport::description() const
+    {
+        return m_device_path;
+    }
+
+    void PtyPrinterTransport::readAvailable()
+    {
+        #ifdef Q_OS_UNIX
+        char buffer[4096];
+        while (m_fd >= 0)
+        {
+            ssize_t count = ::read(m_fd, buffer, sizeof(buffer));
+            if (count > 0)
+            {
+                receive(QByteArray::fromRawData(buffer, int(count)));
+                continue;
+            }
+
+            // the remote side hung up
+            if (count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+                close();
+
+            break;
+        }
+        #endif
+    }
+
+    void PtyPrinterTransport::flushPending()
+    {
+        #ifdef Q_OS_UNIX
+        while (m_fd >= 0 && !m_pending.isEmpty())
+        {
+            ssize_t count = ::write(m_fd, m_pending.constData(), m_pending.size());
+            if (count > 0)
+            {
+                m_pending.remove(0, int(count));
+                continue;
+            }
+
+            if (count < 0 && errno == EINTR)
+                continue;
+
+            if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                emit error(QString("Write to %1 failed: %2").arg(m_device_path, QString::fromLocal8Bit(std::strerror(errno))));
+                close();
+                return;
+            }
+
+            break;
+        }
+
+        // only wake up on writability while there is something left to send
+        if (m_write_notifier != nullptr)
+            m_write_notifier->setEnabled(!m_pending.isEmpty());
+        #endif
+    }
+}
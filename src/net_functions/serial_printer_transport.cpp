@@ -0,0 +1,87 @@
+#include "net_functions/serial_printer_transport.h"
+
+#ifdef HAVE_SERIAL_PORT
+#include <QSerialPort>
+#endif
+
+namespace ORNL
+{
+    SerialPrinterTransport::SerialPrinterTransport(const QString& port_name, int baud, QObject* parent)
+        : PrinterTransport(parent), m_port_name(port_name), m_baud(baud), m_port(nullptr)
+    {
+        #ifdef HAVE_SERIAL_PORT
+        QSerialPort* port = new QSerialPort(this);
+        m_port = port;
+
+        connect(port, &QSerialPort::readyRead, this, [this, port]()
+        {
+            receive(port->readAll());
+        });
+
+        connect(port, &QSerialPort::errorOccurred, this, [this, port](QSerialPort::SerialPortError serial_error)
+        {
+            if (serial_error == QSerialPort::NoError)
+                return;
+
+            emit error(port->errorString());
+
+            // a vanished device (unplugged cable, printer power loss) will not recover on its own
+            if (serial_error == QSerialPort::ResourceError)
+            {
+                port->close();
+                emit closed();
+            }
+        });
+        #endif
+    }
+
+    bool SerialPrinterTransport::open()
+    {
+        #ifdef HAVE_SERIAL_PORT
+        QSerialPort* port = static_cast<QSerialPort*>(m_port);
+        port->setPortName(m_port_name);
+        port->setBaudRate(m_baud);
+        port->setDataBits(QSerialPort::Data8);
+        port->setParity(QSerialPort::NoParity);
+        port->setStopBits(QSerialPort::OneStop);
+        port->setFlowControl(QSerialPort::NoFlowControl);
+
+        resetReceiveBuffer();
+        if (!port->open(QIODevice::ReadWrite))
+            return false; // errorOccurred has already reported the reason
+
+        emit opened();
+        return true;
+        #else
+        emit error("Serial printer connections are unavailable: this build does not include Qt SerialPort");
+        return false;
+        #endif
+    }
+
+    void SerialPrinterTransport::close()
+    {
+        if (m_port != nullptr && m_port->isOpen())
+        {
+            m_port->close();
+            emit closed();
+        }
+    }
+
+    bool SerialPrinterTransport::isOpen() const
+    {
+        return m_port != nullptr && m_port->isOpen();
+    }
+
+    qint64 SerialPrinterTransport::write(const QByteArray& data)
+    {
+        if (!isOpen())
+            return -1;
+
+        return m_port->write(data);
+    }
+
+    QString SerialPrinterTransport::description() const
+    {
+        return QString("%1@%2").arg(m_port_name).arg(m_baud);
+    }
+}
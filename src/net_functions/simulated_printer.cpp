@@ -0,0 +1,365 @@
+#include "net_functions/simulated_printer.h"
+
+// Qt
+#include <QHostAddress>
+#include <QRandomGenerator>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace ORNL
+{
+    //! \brief period of the execution clock
+    static constexpr int kTickIntervalMs = 1;
+
+    //! \brief ticks between statistics reports
+    static constexpr int kTicksPerReport = 500;
+
+    SimulatedPrinter::SimulatedPrinter() : QObject(), m_server(new QTcpServer(this)), m_tick_timer(new QTimer(this))
+    {
+        m_tick_timer->setInterval(kTickIntervalMs);
+        m_tick_timer->setTimerType(Qt::PreciseTimer);
+        connect(m_tick_timer, &QTimer::timeout, this, &SimulatedPrinter::execute);
+
+        connect(m_server, &QTcpServer::newConnection, this, [this]()
+        {
+            QTcpSocket* socket = m_server->nextPendingConnection();
+
+            // one machine, one host
+            if (m_client != nullptr)
+            {
+                socket->disconnectFromHost();
+                socket->deleteLater();
+                return;
+            }
+
+            m_client = socket;
+            m_client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            connect(m_client, &QTcpSocket::readyRead, this, [this]()
+            {
+                receive(m_client->readAll());
+            });
+            connect(m_client, &QTcpSocket::disconnected, this, [this]()
+            {
+                m_client->deleteLater();
+                m_client = nullptr;
+            });
+
+            reset();
+        });
+
+        this->moveToThread(&m_internal_thread);
+        m_internal_thread.start();
+    }
+
+    SimulatedPrinter::~SimulatedPrinter()
+    {
+        m_internal_thread.quit();
+        m_internal_thread.wait();
+
+        #ifdef Q_OS_UNIX
+        if (m_pty_master >= 0)
+            ::close(m_pty_master);
+        #endif
+    }
+
+    void SimulatedPrinter::start(const QString& transport, double lines_per_second, int planner_blocks, int queue_lines, double error_rate)
+    {
+        stop();
+
+        m_lines_per_second = qMax(1.0, lines_per_second);
+        m_planner_blocks = qMax(1, planner_blocks);
+        m_queue_lines = qMax(1, queue_lines);
+        m_error_rate = qBound(0.0, error_rate, 1.0);
+
+        if (transport == "pty")
+        {
+            #ifdef Q_OS_UNIX
+            m_pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+            if (m_pty_master < 0 || grantpt(m_pty_master) != 0 || unlockpt(m_pty_master) != 0)
+            {
+                emit error("Could not create a pseudo-terminal for the simulated printer");
+                stop();
+                return;
+            }
+
+            // raw on both ends so neither side rewrites line endings
+            termios options;
+            if (tcgetattr(m_pty_master, &options) == 0)
+            {
+                cfmakeraw(&options);
+                tcsetattr(m_pty_master, TCSANOW, &options);
+            }
+            fcntl(m_pty_master, F_SETFL, fcntl(m_pty_master, F_GETFL) | O_NONBLOCK);
+
+            m_pty_notifier = new QSocketNotifier(m_pty_master, QSocketNotifier::Read, this);
+            connect(m_pty_notifier, &QSocketNotifier::activated, this, [this]()
+            {
+                char buffer[4096];
+                ssize_t count;
+                while ((count = ::read(m_pty_master, buffer, sizeof(buffer))) > 0)
+                    receive(QByteArray(buffer, int(count)));
+            });
+
+            m_pty_write_notifier = new QSocketNotifier(m_pty_master, QSocketNotifier::Write, this);
+            m_pty_write_notifier->setEnabled(false);
+            connect(m_pty_write_notifier, &QSocketNotifier::activated, this, &SimulatedPrinter::flushPty);
+
+            reset();
+            emit listening(QString("pty://%1").arg(QString::fromLocal8Bit(ptsname(m_pty_master))));
+            #else
+            emit error("Pseudo-terminals are only available on POSIX systems");
+            #endif
+            return;
+        }
+
+        if (!m_server->listen(QHostAddress::LocalHost, 0))
+        {
+            emit error(QString("Simulated printer could not listen: %1").arg(m_server->errorString()));
+            return;
+        }
+
+        emit listening(QString("tcp://127.0.0.1:%1").arg(m_server->serverPort()));
+    }
+
+    void SimulatedPrinter::stop()
+    {
+        m_tick_timer->stop();
+        m_server->close();
+
+        if (m_client != nullptr)
+        {
+            m_client->disconnect(this);
+            m_client->disconnectFromHost();
+            m_client->deleteLater();
+            m_client = nullptr;
+        }
+
+        #ifdef Q_OS_UNIX
+        if (m_pty_master >= 0)
+        {
+            delete m_pty_notifier;
+            m_pty_notifier = nullptr;
+            delete m_pty_write_notifier;
+            m_pty_write_notifier = nullptr;
+            m_pty_pending.clear();
+            ::close(m_pty_master);
+            m_pty_master = -1;
+        }
+        #endif
+    }
+
+    void SimulatedPrinter::reset()
+    {
+        m_input.clear();
+        m_queue.clear();
+        m_planner_count = 0;
+        m_last_line = 0;
+        m_halted = false;
+        m_execution_budget = 0.0;
+        m_executed = 0;
+        m_underruns = 0;
+        m_ticks_since_report = 0;
+
+        m_clock.start();
+        m_tick_timer->start();
+
+        reply("start\necho:Simulated printer\n");
+    }
+
+    void SimulatedPrinter::receive(const QByteArray& bytes)
+    {
+        if (m_halted)
+            return;
+
+        // the emergency parser acts as bytes arrive, ahead of anything queued
+        if (bytes.contains("M112"))
+        {
+            m_halted = true;
+            m_tick_timer->stop();
+            reply("Error:Printer halted. kill() called!\n");
+            return;
+        }
+
+        m_input.append(bytes);
+        parse();
+        plan();
+    }
+
+    void SimulatedPrinter::parse()
+    {
+        // like the firmware, stop reading input while the command queue is full
+        while (m_queue.size() < m_queue_lines)
+        {
+            int newline = m_input.indexOf('\n');
+            if (newline < 0)
+                return;
+
+            QByteArray line = m_input.left(newline).trimmed();
+            m_input.remove(0, newline + 1);
+            if (line.isEmpty())
+                continue;
+
+            qint64 line_number = -1;
+            QByteArray command = line;
+            if (line.startsWith('N'))
+            {
+                int star = line.lastIndexOf('*');
+                if (star < 0)
+                {
+                    requestResend("No Checksum with line number");
+                    continue;
+                }
+
+                unsigned char checksum = 0;
+                for (int i = 0; i < star; ++i)
+                    checksum ^= static_cast<unsigned char>(line[i]);
+
+                bool ok = false;
+                int expected = line.mid(star + 1).toInt(&ok);
+                bool corrupted = m_error_rate > 0.0 && QRandomGenerator::global()->generateDouble() < m_error_rate;
+                if (!ok || expected != checksum || corrupted)
+                {
+                    requestResend("checksum mismatch");
+                    continue;
+                }
+
+                int space = line.indexOf(' ');
+                line_number = line.mid(1, space - 1).toLongLong();
+                command = line.mid(space + 1, star - space - 1).trimmed();
+
+                if (command.startsWith("M110"))
+                {
+                    // M110 N<x> sets the line counter, plain M110 adopts the line's own number
+                    int n_param = command.indexOf('N');
+                    m_last_line = n_param < 0 ? line_number : command.mid(n_param + 1).toLongLong();
+                }
+                else if (line_number != m_last_line + 1)
+                {
+                    requestResend("Line Number is not Last Line Number+1");
+                    continue;
+                }
+                else
+                {
+                    m_last_line = line_number;
+                }
+            }
+
+            m_queue.enqueue(qMakePair(line_number, command));
+        }
+    }
+
+    void SimulatedPrinter::plan()
+    {
+        while (!m_queue.isEmpty() && m_planner_count < m_planner_blocks)
+        {
+            QPair<qint64, QByteArray> entry = m_queue.dequeue();
+
+            QByteArray ok = "ok";
+            if (entry.first >= 0)
+                ok += " N" + QByteArray::number(entry.first);
+
+            // only motion occupies the planner, everything else completes on the spot
+            bool is_motion = entry.second.startsWith("G0") || entry.second.startsWith("G1") ||
+                             entry.second.startsWith("G2") || entry.second.startsWith("G3");
+            if (is_motion)
+                ++m_planner_count;
+
+            ok += " P" + QByteArray::number(m_planner_blocks - m_planner_count);
+            ok += " B" + QByteArray::number(m_queue_lines - m_queue.size());
+
+            if (entry.second.startsWith("M105"))
+                ok += " T:200.0 /200.0 B:60.0 /60.0";
+
+            reply(ok + "\n");
+
+            // freed queue space lets more input in
+            parse();
+        }
+    }
+
+    void SimulatedPrinter::execute()
+    {
+        double seconds = m_clock.restart() / 1000.0;
+
+        if (m_planner_count > 0)
+        {
+            m_execution_budget += seconds * m_lines_per_second;
+            int blocks = qMin(m_planner_count, int(m_execution_budget));
+            m_planner_count -= blocks;
+            m_execution_budget -= blocks;
+            m_executed += blocks;
+
+            if (m_planner_count == 0 && m_queue.isEmpty())
+            {
+                ++m_underruns;
+                m_execution_budget = 0.0;
+            }
+
+            plan();
+        }
+        else
+        {
+            // an idle machine does not bank time
+            m_execution_budget = 0.0;
+        }
+
+        if (++m_ticks_since_report >= kTicksPerReport)
+        {
+            m_ticks_since_report = 0;
+            emit statistics(m_executed, m_underruns);
+        }
+    }
+
+    void SimulatedPrinter::reply(const QByteArray& bytes)
+    {
+        if (m_client != nullptr)
+        {
+            m_client->write(bytes);
+            return;
+        }
+
+        #ifdef Q_OS_UNIX
+        if (m_pty_master >= 0)
+        {
+            m_pty_pending.append(bytes);
+            flushPty();
+        }
+        #endif
+    }
+
+    void SimulatedPrinter::flushPty()
+    {
+        #ifdef Q_OS_UNIX
+        while (m_pty_master >= 0 && !m_pty_pending.isEmpty())
+        {
+            ssize_t count = ::write(m_pty_master, m_pty_pending.constData(), size_t(m_pty_pending.size()));
+            if (count > 0)
+                m_pty_pending.remove(0, int(count));
+            else if (count < 0 && errno == EINTR)
+                continue;
+            else
+                break;
+        }
+
+        // wait for the host to drain the terminal rather than spinning
+        if (m_pty_write_notifier != nullptr)
+            m_pty_write_notifier->setEnabled(!m_pty_pending.isEmpty());
+        #endif
+    }
+
+    void SimulatedPrinter::requestResend(const QByteArray& reason)
+    {
+        // everything after the bad line is stale; the host will resend it
+        m_input.clear();
+
+        reply("Error:" + reason + ", Last Line: " + QByteArray::number(m_last_line) + "\n" +
+              "Resend: " + QByteArray::number(m_last_line + 1) + "\n" +
+              "ok\n");
+    }
+}
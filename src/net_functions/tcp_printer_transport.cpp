@@ -0,0 +1,60 @@
+#include "net_functions/tcp_printer_transport.h"
+
+namespace ORNL
+{
+    TcpPrinterTransport::TcpPrinterTransport(const QString& host, int port, QObject* parent)
+        : PrinterTransport(parent), m_host(host), m_port(port), m_socket(new QTcpSocket(this))
+    {
+        connect(m_socket, &QTcpSocket::connected, this, [this]()
+        {
+            // g-code lines are small and latency bound, do not let Nagle hold them back
+            m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            emit opened();
+        });
+
+        connect(m_socket, &QTcpSocket::readyRead, this, [this]()
+        {
+            receive(m_socket->readAll());
+        });
+
+        connect(m_socket, &QTcpSocket::disconnected, this, &TcpPrinterTransport::closed);
+
+        connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), this, [this](QAbstractSocket::SocketError)
+        {
+            emit error(m_socket->errorString());
+        });
+    }
+
+    bool TcpPrinterTransport::open()
+    {
+        if (m_host.isEmpty() || m_port <= 0)
+        {
+            emit error("TCP printer address must be of the form tcp://host:port");
+            return false;
+        }
+
+        resetReceiveBuffer();
+        m_socket->connectToHost(m_host, m_port);
+        return true;
+    }
+
+    void TcpPrinterTransport::close()
+    {
+        m_socket->disconnectFromHost();
+    }
+
+    bool TcpPrinterTransport::isOpen() const
+    {
+        return m_socket->state() == QAbstractSocket::ConnectedState;
+    }
+
+    qint64 TcpPrinterTransport::write(const QByteArray& data)
+    {
+        return m_socket->write(data);
+    }
+
+    QString TcpPrinterTransport::description() const
+    {
+        return QString("%1:%2").arg(m_host).arg(m_port);
+    }
+}
@@ -1,4 +1,9 @@
 #include "optimizers/layer_order_optimizer.h"
+
+// C++
+#include <queue>
+
+// Local
 #include "utilities/mathutils.h"
 
 namespace ORNL
@@ -51,93 +56,66 @@ namespace ORNL
             QQuaternion quaternion = MathUtils::CreateQuaternion(slicing_plane_pitch, slicing_plane_yaw, slicing_plane_roll);
             slicing_plane = quaternion.rotatedVector(slicing_plane);
 
-            bool steps_left = true;
-            int num_global_steps = 0;
+            Distance layer_grouping_tolerance = global_sb->setting<Distance>(Constants::ExperimentalSettings::PrinterConfig::kLayerGroupingTolerance);
 
-            // Make a map to track the step/layer number each part is currently on
-            // Start each part at zero
-            QMap<QUuid, int> current_layer;
-            for (auto& part : build_parts)
-                current_layer.insert(part->getId(), 0);
+            // k-way merge of the per-part layer streams. Each part contributes at most one entry to the heap: the
+            // layer it is currently on. Entries are keyed by (distance along slicing direction, part order) so that
+            // ties resolve to the same part the old linear scan would have picked.
+            std::priority_queue<LayerCandidate, std::vector<LayerCandidate>, std::greater<LayerCandidate>> heap;
+            for (int part_index = 0, part_count = build_parts.size(); part_index < part_count; ++part_index)
+            {
+                if (build_parts[part_index]->countStepPairs() > 0)
+                    heap.push(makeCandidate(build_parts[part_index], part_index, 0, slicing_plane));
+            }
 
-            while (steps_left)
+            int num_global_steps = 0;
+            QVector<LayerCandidate> deferred;
+            QVector<LayerCandidate> grouped;
+            while (!heap.empty())
             {
+                // the lowest remaining layer defines the plane of this global layer
+                const LayerCandidate lowest = heap.top();
+                heap.pop();
+                grouped.append(lowest);
+
+                // layers on the same plane can be printed at the same time and go on the same global layer. The plane
+                // test bounds the height difference by the tolerance, so only entries within that band need checking.
+                while (!heap.empty() && heap.top().distance - lowest.distance <= layer_grouping_tolerance())
+                {
+                    LayerCandidate candidate = heap.top();
+                    heap.pop();
+
+                    if (candidate.plane.isEqual(lowest.plane, layer_grouping_tolerance()))
+                        grouped.append(candidate);
+                    else
+                        deferred.append(candidate);
+                }
 
-                // Check the current step of all the parts, find the minimum plane
-                QUuid part_with_min_plane = QUuid(); // null quuid initially
-                Plane min_plane;
-                Distance min_dist;
+                for (const LayerCandidate& candidate : deferred)
+                    heap.push(candidate);
+                deferred.clear();
 
-                // Check all the parts for the next "lowest" layer to print
-                //! 内层循环遍历所有的部分，为每个部分找到一个“当前最低”图层
-                for (auto& part : build_parts)
+                // keep step pairs in part order, matching the per-part scan this replaced
+                std::sort(grouped.begin(), grouped.end(), [](const LayerCandidate& lhs, const LayerCandidate& rhs)
                 {
-                    QUuid part_id = part->getId();
-
-                    // Skip the part if all its layers have been assigned to a global layer
-                    if (current_layer[part_id] >= part->countStepPairs())
-                        continue;
-
-                    // Get the current layer for this part
-                    QSharedPointer<Step> current_step = part->getStepPair(current_layer[part_id]).printing_layer;
-
-                    // calculate the distance from
-                    Plane layer_plane = current_step->getSlicingPlane();
-                    Distance layer_height = current_step->getSb()->setting<Distance>(Constants::ProfileSettings::Layer::kLayerHeight);
-                    layer_plane.shiftAlongNormal(layer_height() / 2.0);
-
-                    //! 表示切片平面与原点的距离
-                    Distance layer_dist = MathUtils::linePlaneIntersection(Point(0,0,0), slicing_plane, layer_plane).distance();
-
-                    // If this is the first plane in this loop, or its lower than the current min, set this layer as the min
-                    if (part_with_min_plane.isNull() || layer_dist < min_dist)
-                    {
-                        part_with_min_plane = part_id;
-                        min_plane = layer_plane;
-                        min_dist = layer_dist;
-                    }
-                }
+                    return lhs.part_index < rhs.part_index;
+                });
 
-                // check all the parts (again) for layers with the same plane as the lowest layer. Layers with same plane can
-                // be printed at the same time, and go on the same global layer
                 QSharedPointer<GlobalLayer> new_global_layer = QSharedPointer<GlobalLayer>::create(num_global_steps);
-                for (auto& part : build_parts)
+                for (const LayerCandidate& candidate : grouped)
                 {
-                    QUuid part_id = part->getId();
-
-                    //skip the part if all its layers have been assigned to a global layer
-                    if (current_layer[part_id] >= part->countStepPairs())
-                        continue;
-
-                    // get the current layer for this part
-                    QSharedPointer<Step> current_step =  part->getStepPair(current_layer[part_id]).printing_layer;
-
-                    Distance layer_height = current_step->getSb()->setting<Distance>(Constants::ProfileSettings::Layer::kLayerHeight);
-                    //! 用于允许在一定范围内的图层合并，避免因微小差异而创建额外的全局图层。
-                    Distance layer_grouping_tolerance = global_sb->setting<Distance>(Constants::ExperimentalSettings::PrinterConfig::kLayerGroupingTolerance);
-                    Plane layer_plane = current_step->getSlicingPlane();
-                    layer_plane.shiftAlongNormal(layer_height() / 2.0);
-
-                    // if this part's current layer is equal to the min plane, add it to the global layer
-                    if (layer_plane.isEqual(min_plane, layer_grouping_tolerance()))
-                    {
-                        new_global_layer->addStepPair(part_id, part->getStepPair(current_layer[part_id]));
-                        ++current_layer[part_id];
-                    }
+                    QSharedPointer<Part> part = build_parts[candidate.part_index];
+                    new_global_layer->addStepPair(part->getId(), part->getStepPair(candidate.layer_index));
+
+                    int next_layer = candidate.layer_index + 1;
+                    if (next_layer < part->countStepPairs())
+                        heap.push(makeCandidate(part, candidate.part_index, next_layer, slicing_plane));
                 }
+                grouped.clear();
 
-                // add the new global layer to the list
-                //!global_layers 重点关注
                 global_layers.push_back(new_global_layer);
                 ++num_global_steps;
-
-                // update steps_left
-                steps_left = false;
-                //! 如果所有部分的当前图层索引都已经达到了总图层数（countStepPairs）(下面的 或 判断逻辑)
-                for (auto& part : build_parts)
-                    steps_left = steps_left || (current_layer[part->getId()] < part->countStepPairs());
-
-            } // end while(steps left)
+            }
         }
         else if(order_method == LayerOrdering::kByLayerNumber)
         {
@@ -213,47 +191,48 @@ namespace ORNL
     }
 
 
-    void LayerOrderOptimizer::logGlobalLayers(const QList<QSharedPointer<GlobalLayer>>& global_layers)
+    LayerOrderOptimizer::LayerCandidate LayerOrderOptimizer::makeCandidate(const QSharedPointer<Part>& part, int part_index, int layer_index, const QVector3D& slicing_plane)
     {
-    QFile logFile("global_layers_log.txt"); // 指定日志文件路径
-    if (logFile.open(QIODevice::Append | QIODevice::Text)) // 追加模式
+        QSharedPointer<Step> step = part->getStepPair(layer_index).printing_layer;
+
+        LayerCandidate candidate;
+        candidate.part_index = part_index;
+        candidate.layer_index = layer_index;
+
+        // compare layers at their mid-height
+        Distance layer_height = step->getSb()->setting<Distance>(Constants::ProfileSettings::Layer::kLayerHeight);
+        candidate.plane = step->getSlicingPlane();
+        candidate.plane.shiftAlongNormal(layer_height() / 2.0);
+
+        candidate.distance = MathUtils::linePlaneIntersection(Point(0, 0, 0), slicing_plane, candidate.plane).distance()();
+
+        return candidate;
+    }
+
+    void LayerOrderOptimizer::logGlobalLayers(const QList<QSharedPointer<GlobalLayer>>& global_layers, const QString& file_path)
     {
-        QTextStream logStream(&logFile);
+        // overwrite rather than append so repeated slices do not grow the file without bound
+        QFile log_file(file_path);
+        if (!log_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+            return;
 
-        logStream << "Logging global_layers content:\n";
+        QTextStream log_stream(&log_file);
+
+        log_stream << "Logging global_layers content:\n";
         for (int i = 0; i < global_layers.size(); ++i)
         {
-            logStream << "Global Layer " << i << ":\n";
-            const auto& layer = global_layers[i];
+            log_stream << "Global Layer " << i << ":\n";
 
-            //! // 使用 getStepPairs 获取 step pairs，并迭代输出内容
-            const auto& step_pairs = layer->getStepPairs();
+            const auto& step_pairs = global_layers[i]->getStepPairs();
             for (auto it = step_pairs.constBegin(); it != step_pairs.constEnd(); ++it)
             {
-                QUuid part_id = it.key();
-                const QSharedPointer<Part::StepPair> &step_pair_ptr = it.value();
-
-                // 确保 step_pair_ptr 非空
-                if (step_pair_ptr)
-                {
-                logStream << "  Part ID: " << part_id.toString() << "\n";
-/*                    if (step_pair_ptr->printing_layer)
-                        logStream << "  Printing Layer: " << step_pair_ptr->printing_layer << "\n"; */ // 示例输出
-
-                }
+                if (it.value())
+                    log_stream << "  Part ID: " << it.key().toString() << "\n";
                 else
-                {
-                    logStream << "  StepPair is null for Part ID: " << part_id.toString() << "\n";
-                }
-
+                    log_stream << "  StepPair is null for Part ID: " << it.key().toString() << "\n";
             }
-
-                // 添加更多信息，如层高度、层位置等
-
         }
-        logStream << "End of global_layers log\n\n";
-    }
-    logFile.close();
+        log_stream << "End of global_layers log\n";
     }
 
     //! \note this function is unused and not updated in refactor. Should probably be moved to exist on the global layer
@@ -10,6 +10,7 @@
 #include "geometry/segments/line.h"
 #include "utilities/mathutils.h"
 #include "geometry/polygon_list.h"
+#include "geometry/contour_hierarchy.h"
 #include "optimizers/point_order_optimizer.h"
 
 namespace ORNL
@@ -524,6 +525,9 @@ namespace ORNL
         QVector<QSharedPointer<TopologicalNode>> all_nodes;
         all_nodes.reserve(m_paths.size());
 
+        QVector<ClipperLib2::Path> contours;
+        contours.reserve(m_paths.size());
+
         for(int i = 0, end = m_paths.size(); i < end; ++i)
         {
            Polygon poly;
@@ -531,51 +535,17 @@ namespace ORNL
            for(QSharedPointer<SegmentBase> seg : m_paths[i].getSegments())
                poly.push_back(Point(seg->start()));
 
+           contours.push_back(poly());
            all_nodes.push_back(QSharedPointer<TopologicalNode>::create(TopologicalNode(i, poly)));
         }
 
         //assume first path is outer contour
-        QSharedPointer<TopologicalNode> root;
-        root = all_nodes[0];
-        all_nodes.removeFirst();
-
-        for(QSharedPointer<TopologicalNode> node : all_nodes)
-            insert(root, node);
+        ContourHierarchy hierarchy(contours);
+        for(int i = 0, end = all_nodes.size(); i < end; ++i)
+            for(int child : hierarchy.children(i))
+                all_nodes[i]->m_children.push_back(all_nodes[child]);
 
-        return root;
-    }
-
-    //插入拓扑节点，维护层级关系
-    void PathOrderOptimizer::insert(QSharedPointer<TopologicalNode> root, QSharedPointer<TopologicalNode> current)
-    {
-        if(root->m_children.size() == 0)
-        {
-            root->m_children.push_back(current);
-            return;
-        }
-        bool insideAny = false;
-        for(QSharedPointer<TopologicalNode> child : root->m_children)
-        {
-            if(child->m_poly.inside(current->m_poly[0]))
-            {
-                insert(child, current);
-                insideAny = true;
-                break;
-            }
-        }
-
-        if(!insideAny)
-        {
-            for(int j = root->m_children.size() - 1; j >= 0; --j)
-            {
-                if(current->m_poly.inside(root->m_children[j]->m_poly[0]))
-                {
-                    current->m_children.push_back(root->m_children[j]);
-                    root->m_children.removeAt(j);
-                }
-            }
-            root->m_children.push_back(current);
-        }
+        return all_nodes[0];
     }
 
     //按层级顺序遍历拓扑节点
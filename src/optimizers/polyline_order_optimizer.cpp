@@ -7,6 +7,7 @@
 //Local
 #include "utilities/mathutils.h"
 #include "geometry/polygon_list.h"
+#include "geometry/contour_hierarchy.h"
 #include "optimizers/point_order_optimizer.h"
 
 namespace ORNL
@@ -420,50 +421,25 @@ namespace ORNL
         QVector<QSharedPointer<TopologicalNode>> all_nodes;
         all_nodes.reserve(m_polylines.size());
 
-        for(int i = 0, end = m_polylines.size(); i < end; ++i)
-           all_nodes.push_back(QSharedPointer<TopologicalNode>::create(TopologicalNode(i, m_polylines[i])));
-
-        //assume first Polyline is outer contour
-        QSharedPointer<TopologicalNode> root;
-        root = all_nodes[0];
-        all_nodes.removeFirst();
-
-        for(QSharedPointer<TopologicalNode> node : all_nodes)
-            insert(root, node);
-
-        return root;
-    }
+        //assume first Polyline is outer contour, only closed Polylines enclose others
+        QVector<ClipperLib2::Path> contours;
+        QVector<bool> closed;
+        contours.reserve(m_polylines.size());
+        closed.reserve(m_polylines.size());
 
-    void PolylineOrderOptimizer::insert(QSharedPointer<TopologicalNode> root, QSharedPointer<TopologicalNode> current)
-    {
-        if(root->m_children.size() == 0)
-        {
-            root->m_children.push_back(current);
-            return;
-        }
-        bool insideAny = false;
-        for(QSharedPointer<TopologicalNode> child : root->m_children)
+        for(int i = 0, end = m_polylines.size(); i < end; ++i)
         {
-            if(child->m_poly.inside(current->m_poly[0]))
-            {
-                insert(child, current);
-                insideAny = true;
-                break;
-            }
+           all_nodes.push_back(QSharedPointer<TopologicalNode>::create(TopologicalNode(i, m_polylines[i])));
+           contours.push_back(m_polylines[i]());
+           closed.push_back(!m_polylines[i].isEmpty() && m_polylines[i].first() == m_polylines[i].last());
         }
 
-        if(!insideAny)
-        {
-            for(int j = root->m_children.size() - 1; j >= 0; --j)
-            {
-                if(current->m_poly.inside(root->m_children[j]->m_poly[0]))
-                {
-                    current->m_children.push_back(root->m_children[j]);
-                    root->m_children.removeAt(j);
-                }
-            }
-            root->m_children.push_back(current);
-        }
+        ContourHierarchy hierarchy(contours, closed);
+        for(int i = 0, end = all_nodes.size(); i < end; ++i)
+            for(int child : hierarchy.children(i))
+                all_nodes[i]->m_children.push_back(all_nodes[child]);
+
+        return all_nodes[0];
     }
 
     void PolylineOrderOptimizer::levelOrder(QSharedPointer<TopologicalNode> root)
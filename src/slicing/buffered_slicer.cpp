@@ -1,5 +1,7 @@
 #include "slicing/buffered_slicer.h"
 
+#include <limits>
+
 #include "slicing/slicing_utilities.h"
 #include "cross_section/cross_section.h"
 #include "step/layer/island/polymer_island.h"
@@ -17,8 +19,6 @@ namespace ORNL
     {
         m_mesh = mesh;
         m_settings = settings;
-        m_settings_parts = settings_parts;
-        m_emboss_parts = emboss_parts;
         m_settings_ranges = ranges;
         m_use_cgal_cross_section = use_cgal_cross_section;
 
@@ -30,6 +30,34 @@ namespace ORNL
 
         std::tie(m_slicing_plane, m_mesh_min, m_mesh_max) = SlicingUtilities::GetDefaultSlicingAxis(m_settings, m_mesh, m_skeleton);
 
+        // Region parts are checked against the slicing axis once, rather than on every slice
+        for(const QSharedPointer<Part>& settings_part : settings_parts)
+            m_settings_parts.push_back(makeRegionPart(settings_part, settings_part->getSb(), settings_part->getSb()));
+
+        if(m_settings->setting<bool>(Constants::PrinterSettings::Embossing::kEnableEmbossing))
+        {
+            // Emboss settings only depend on the part settings, so they are shared by every slice
+            QSharedPointer<SettingsBase> region_settings = QSharedPointer<SettingsBase>::create(*m_settings);
+
+            region_settings->setSetting(Constants::PrinterSettings::Embossing::kEnableEmbossing,
+                                        m_settings->setting<float>(Constants::PrinterSettings::Embossing::kEnableEmbossing));
+            region_settings->setSetting(Constants::PrinterSettings::Embossing::kESPNominalValue,
+                                        m_settings->setting<float>(Constants::PrinterSettings::Embossing::kESPNominalValue));
+            region_settings->setSetting(Constants::PrinterSettings::Embossing::kESPEmbossingValue,
+                                        m_settings->setting<float>(Constants::PrinterSettings::Embossing::kESPEmbossingValue));
+
+            bool enable_embossing_speed = m_settings->setting<bool>(Constants::PrinterSettings::Embossing::kEnableESPSpeed);
+            if (enable_embossing_speed) {
+                region_settings->setSetting(Constants::ProfileSettings::Perimeter::kSpeed,
+                                            m_settings->setting<Velocity>(Constants::PrinterSettings::Embossing::kESPSpeed));
+                region_settings->setSetting(Constants::ProfileSettings::Inset::kSpeed,
+                                            m_settings->setting<Velocity>(Constants::PrinterSettings::Embossing::kESPSpeed));
+            }
+
+            for(const QSharedPointer<Part>& emboss_part : emboss_parts)
+                m_emboss_parts.push_back(makeRegionPart(emboss_part, m_settings, region_settings));
+        }
+
         //if(m_mesh_min.z() != 0)
         //    m_additional_shift.z(m_mesh_min.z());
 
@@ -244,54 +272,138 @@ namespace ORNL
         return slice_meta;
     }
 
-    void BufferedSlicer::computeSettingsPolygons(QVector<SettingsPolygon> &settings_polygons)
+    BufferedSlicer::RegionPart BufferedSlicer::makeRegionPart(const QSharedPointer<Part>& part, const QSharedPointer<SettingsBase>& section_settings,
+                                                              const QSharedPointer<SettingsBase>& region_settings)
     {
-        // Create settings polygons
-        for(const auto& settings_part : m_settings_parts)
+        RegionPart region_part;
+        region_part.part = part;
+        region_part.section_settings = section_settings;
+        region_part.region_settings = region_settings;
+
+        QSharedPointer<MeshBase> mesh = part->rootMesh();
+        Point min = mesh->min();
+        Point max = mesh->max();
+        for(int i = 0; i < 8; ++i)
+            region_part.corners.push_back(Point((i & 1) ? max.x() : min.x(), (i & 2) ? max.y() : min.y(), (i & 4) ? max.z() : min.z()));
+
+        QVector<MeshVertex> vertices = mesh->vertices();
+        QVector<MeshFace> faces = mesh->faces();
+        if(vertices.isEmpty() || faces.isEmpty())
+            return region_part;
+
+        // A prism has every face either flat on one of its caps or parallel to its axis
+        QVector3D axis = m_slicing_plane.normal().normalized();
+        float low = std::numeric_limits<float>::max();
+        float high = std::numeric_limits<float>::lowest();
+        for(const MeshVertex& vertex : vertices)
         {
-            // Add a settings polys for each island.
-            Point tmp_point;
-            QVector3D tmp_vec;
+            float height = QVector3D::dotProduct(axis, vertex.location);
+            low = std::min(low, height);
+            high = std::max(high, height);
+        }
+
+        const float tolerance = micron();
+        for(const MeshFace& face : faces)
+        {
+            if(face.ignore)
+                continue;
 
-            PolygonList geometry = CrossSection::doCrossSection(settings_part->rootMesh(),
-                                                                m_slicing_plane, tmp_point, tmp_vec,
-                                                                settings_part->getSb());
+            QVector3D p0 = vertices[face.vertex_index[0]].location;
+            QVector3D p1 = vertices[face.vertex_index[1]].location;
+            QVector3D p2 = vertices[face.vertex_index[2]].location;
 
-            auto settings = settings_part->getSb();
-            settings_polygons.push_back(SettingsPolygon(geometry, settings));
+            bool on_low = true, on_high = true;
+            for(const QVector3D& p : { p0, p1, p2 })
+            {
+                float height = QVector3D::dotProduct(axis, p);
+                on_low = on_low && std::abs(height - low) <= tolerance;
+                on_high = on_high && std::abs(height - high) <= tolerance;
+            }
+            if(on_low || on_high)
+                continue;
+
+            QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0).normalized();
+            if(std::abs(QVector3D::dotProduct(normal, axis)) > 1e-4)
+                return region_part;
         }
+
+        region_part.is_prism = true;
+        region_part.prism_axis = axis;
+        region_part.prism_low = low;
+        region_part.prism_high = high;
+        return region_part;
     }
 
-    void BufferedSlicer::computeEmbossParts(QVector<SettingsPolygon> &emboss_polygons)
+    bool BufferedSlicer::sectionRegionPart(RegionPart& region_part, PolygonList& geometry)
     {
-        for (const auto& emboss_part : m_emboss_parts)
+        // Skip planes that have every corner of the bounding box on the same side
+        bool above = false, below = false;
+        for(const Point& corner : region_part.corners)
         {
-            QSharedPointer<SettingsBase> region_settings = QSharedPointer<SettingsBase>::create(*m_settings);
+            double evaluation = m_slicing_plane.evaluatePoint(corner);
+            above = above || evaluation >= 0;
+            below = below || evaluation <= 0;
+        }
+        if(!above || !below)
+            return false;
 
-            region_settings->setSetting(Constants::PrinterSettings::Embossing::kEnableEmbossing,
-                                        m_settings->setting<float>(Constants::PrinterSettings::Embossing::kEnableEmbossing));
-            region_settings->setSetting(Constants::PrinterSettings::Embossing::kESPNominalValue,
-                                        m_settings->setting<float>(Constants::PrinterSettings::Embossing::kESPNominalValue));
-            region_settings->setSetting(Constants::PrinterSettings::Embossing::kESPEmbossingValue,
-                                        m_settings->setting<float>(Constants::PrinterSettings::Embossing::kESPEmbossingValue));
+        QSharedPointer<MeshBase> mesh = region_part.part->rootMesh();
 
-            bool enable_embossing_speed = m_settings->setting<bool>(Constants::PrinterSettings::Embossing::kEnableESPSpeed);
-            if (enable_embossing_speed) {
-                region_settings->setSetting(Constants::ProfileSettings::Perimeter::kSpeed,
-                                            m_settings->setting<Velocity>(Constants::PrinterSettings::Embossing::kESPSpeed));
-                region_settings->setSetting(Constants::ProfileSettings::Inset::kSpeed,
-                                            m_settings->setting<Velocity>(Constants::PrinterSettings::Embossing::kESPSpeed));
+        // Inside a prism every plane along its axis cuts the same section, as long as the plane midpoint the
+        // section is flattened about stays put
+        bool inside_prism = false;
+        Point shift;
+        if(region_part.is_prism && (m_slicing_plane.normal().normalized() - region_part.prism_axis).length() < 1e-5)
+        {
+            const float tolerance = micron();
+            float height = QVector3D::dotProduct(region_part.prism_axis, m_slicing_plane.point().toQVector3D());
+            if(height > region_part.prism_low + tolerance && height < region_part.prism_high - tolerance)
+            {
+                inside_prism = true;
+                shift = CrossSection::findSlicingPlaneMidPoint(mesh, m_slicing_plane);
+                if(region_part.has_section && std::abs(shift.x() - region_part.section_shift.x()) <= tolerance &&
+                        std::abs(shift.y() - region_part.section_shift.y()) <= tolerance)
+                {
+                    geometry = region_part.section;
+                    return true;
+                }
             }
+        }
 
-            // Add a settings polys for each island.
-            Point tmp_point;
-            QVector3D tmp_vec;
+        Point tmp_point;
+        QVector3D tmp_vec;
+        geometry = CrossSection::doCrossSection(mesh, m_slicing_plane, tmp_point, tmp_vec, region_part.section_settings);
 
-            PolygonList geometry = CrossSection::doCrossSection(emboss_part->rootMesh(),
-                                                                m_slicing_plane, tmp_point, tmp_vec,
-                                                                m_settings);
+        if(inside_prism)
+        {
+            region_part.has_section = true;
+            region_part.section = geometry;
+            region_part.section_shift = shift;
+        }
+
+        return true;
+    }
 
-            emboss_polygons.push_back(SettingsPolygon(geometry, region_settings));
+    void BufferedSlicer::computeSettingsPolygons(QVector<SettingsPolygon> &settings_polygons)
+    {
+        // Create settings polygons
+        for(RegionPart& settings_part : m_settings_parts)
+        {
+            // Add a settings polys for each island.
+            PolygonList geometry;
+            if(sectionRegionPart(settings_part, geometry))
+                settings_polygons.push_back(SettingsPolygon(geometry, settings_part.region_settings));
+        }
+    }
+
+    void BufferedSlicer::computeEmbossParts(QVector<SettingsPolygon> &emboss_polygons)
+    {
+        for(RegionPart& emboss_part : m_emboss_parts)
+        {
+            // Add a settings polys for each island.
+            PolygonList geometry;
+            if(sectionRegionPart(emboss_part, geometry))
+                emboss_polygons.push_back(SettingsPolygon(geometry, emboss_part.region_settings));
         }
     }
 }
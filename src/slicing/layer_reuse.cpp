@@ -0,0 +1,132 @@
+// Main Module
+#include "slicing/layer_reuse.h"
+
+// Qt
+#include <QCryptographicHash>
+#include <QHash>
+
+// Local
+#include "step/layer/layer.h"
+#include "step/layer/island/island_base.h"
+#include "step/layer/regions/region_base.h"
+
+namespace ORNL
+{
+    namespace LayerReuse
+    {
+        namespace
+        {
+            //! \brief Whether a layer can take the islands of another. Islands other than build and support
+            //!        islands, and settings regions, are always computed.
+            bool canReuse(const QSharedPointer<Layer>& layer)
+            {
+                QSharedPointer<SettingsBase> sb = layer->getSb();
+                if (!sb->setting<bool>(Constants::ProfileSettings::Optimizations::kLayerReuse) ||
+                    sb->setting<bool>(Constants::ExperimentalSettings::SinglePath::kEnableSinglePath) ||
+                    static_cast<SlicerType>(sb->setting<int>(Constants::ExperimentalSettings::PrinterConfig::kSlicerType)) == SlicerType::kConformalSlice)
+                    return false;
+
+                for (const QSharedPointer<IslandBase>& island : layer->getIslands())
+                {
+                    if (island->getType() != IslandType::kPolymer && island->getType() != IslandType::kSupport)
+                        return false;
+
+                    if (!island->getSettingsPolygons().isEmpty())
+                        return false;
+                }
+
+                return !layer->getIslands().isEmpty();
+            }
+
+            //! \brief Hash of everything the islands of a layer compute from: the layer settings, which carry
+            //!        the per layer pattern angles, and for each island its type, settings, outline and the
+            //!        inputs of its regions.
+            QByteArray computeKey(const QSharedPointer<Layer>& layer)
+            {
+                QCryptographicHash hash(QCryptographicHash::Sha1);
+                QSharedPointer<SettingsBase> layer_sb = layer->getSb();
+                hash.addData(QByteArray::fromStdString(layer_sb->json().dump()));
+
+                for (const QSharedPointer<IslandBase>& island : layer->getIslands())
+                {
+                    int type = static_cast<int>(island->getType());
+                    hash.addData(reinterpret_cast<const char*>(&type), sizeof(type));
+
+                    // islands mostly share the settings of their layer
+                    if (island->getSb() != layer_sb)
+                        hash.addData(QByteArray::fromStdString(island->getSb()->json().dump()));
+
+                    island->getGeometry().addTo(hash);
+
+                    QList<QSharedPointer<RegionBase>> regions = island->getRegions();
+                    int region_count = regions.size();
+                    hash.addData(reinterpret_cast<const char*>(&region_count), sizeof(region_count));
+                    for (const QSharedPointer<RegionBase>& region : regions)
+                        region->addComputeInputs(hash);
+                }
+
+                return hash.result();
+            }
+        }
+
+        QVector<Repeat> findRepeats(const QVector<QSharedPointer<Part>>& parts)
+        {
+            QVector<Repeat> repeats;
+            for (const QSharedPointer<Part>& part : parts)
+            {
+                QVector<QSharedPointer<Layer>> layers;
+                for (int i = 0, end = part->countStepPairs(); i < end; ++i)
+                {
+                    QSharedPointer<Layer> layer = part->getStepPair(i).printing_layer;
+                    if (layer != nullptr && layer->isDirty() && canReuse(layer))
+                        layers.push_back(layer);
+                }
+
+                QVector<QByteArray> keys(layers.size());
+                const QSharedPointer<Layer>* layer_data = layers.constData();
+                QByteArray* key_data = keys.data();
+
+                //! Layers are only read, so every key can be taken at once
+                #pragma omp parallel for schedule(dynamic)
+                for (int i = 0; i < layers.size(); ++i)
+                    key_data[i] = computeKey(layer_data[i]);
+
+                // the first layer with a key is computed, later ones take its islands
+                QHash<QByteArray, QSharedPointer<Layer>> sources;
+                for (int i = 0, end = layers.size(); i < end; ++i)
+                {
+                    auto source = sources.constFind(keys[i]);
+                    if (source == sources.constEnd())
+                    {
+                        sources.insert(keys[i], layers[i]);
+                        continue;
+                    }
+
+                    layers[i]->setDirtyBit(false);
+                    repeats.push_back(Repeat{source.value(), layers[i]});
+                }
+            }
+
+            return repeats;
+        }
+
+        void placeRepeats(const QVector<Repeat>& repeats)
+        {
+            // bring every source into its frame first, so the loop below only reads them
+            for (const Repeat& repeat : repeats)
+                repeat.source->applyFrame();
+
+            const Repeat* repeat_data = repeats.constData();
+
+            //! Sources are only read, so every repeat can be placed at once
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < repeats.size(); ++i)
+            {
+                repeat_data[i].copy->placeIslandsOf(repeat_data[i].source, QQuaternion(), Point(0, 0, 0));
+
+                // placed islands still need to be connected like freshly computed ones
+                repeat_data[i].copy->setDirtyBit(true);
+            }
+        }
+    }
+}
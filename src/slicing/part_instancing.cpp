@@ -0,0 +1,243 @@
+// Main Module
+#include "slicing/part_instancing.h"
+
+// Qt
+#include <QCryptographicHash>
+#include <QtMath>
+
+// Local
+#include "geometry/mesh/closed_mesh.h"
+#include "step/layer/layer.h"
+
+namespace ORNL
+{
+    namespace PartInstancing
+    {
+        namespace
+        {
+            //! \brief Whether a part sliced with these settings can have its layers copied. Copies are optimized
+            //!        where their source was computed, so nothing may depend on where the part sits on the plate
+            //!        or on the paths of other islands.
+            bool canInstance(const QSharedPointer<SettingsBase>& sb)
+            {
+                if (sb->setting<bool>(Constants::ExperimentalSettings::SinglePath::kEnableSinglePath) ||
+                    sb->setting<bool>(Constants::ProfileSettings::LaserScanner::kLaserScanner) ||
+                    sb->setting<bool>(Constants::ExperimentalSettings::WireFeed::kWireFeedEnable) ||
+                    sb->setting<bool>(Constants::ProfileSettings::Infill::kBasedOnPrinter))
+                    return false;
+
+                // layers are only kept at the same height for horizontal slicing
+                if (static_cast<Axis>(sb->setting<int>(Constants::ExperimentalSettings::SlicingAngle::kSlicingAxis)) != Axis::kZ ||
+                    !qFuzzyIsNull(sb->setting<Angle>(Constants::ExperimentalSettings::SlicingAngle::kStackingDirectionPitch)()) ||
+                    !qFuzzyIsNull(sb->setting<Angle>(Constants::ExperimentalSettings::SlicingAngle::kStackingDirectionYaw)()) ||
+                    !qFuzzyIsNull(sb->setting<Angle>(Constants::ExperimentalSettings::SlicingAngle::kStackingDirectionRoll)()) ||
+                    sb->setting<bool>(Constants::ExperimentalSettings::SlicingAngle::kEnableAutoRotate) ||
+                    sb->setting<bool>(Constants::ExperimentalSettings::SlicingAngle::kEnableMultiBranch))
+                    return false;
+
+                // custom points are given on the plate
+                if (static_cast<PathOrderOptimization>(sb->setting<int>(Constants::ProfileSettings::Optimizations::kPathOrder)) == PathOrderOptimization::kCustomPoint ||
+                    static_cast<PointOrderOptimization>(sb->setting<int>(Constants::ProfileSettings::Optimizations::kPointOrder)) == PointOrderOptimization::kCustomPoint)
+                    return false;
+
+                // these read or change the paths of the regions printed before
+                if (sb->setting<bool>(Constants::ProfileSettings::SpecialModes::kEnableSpiralize) ||
+                    sb->setting<bool>(Constants::PrinterSettings::MachineSetup::kSupportsE1) ||
+                    sb->setting<bool>(Constants::PrinterSettings::MachineSetup::kSupportsE2) ||
+                    sb->setting<bool>(Constants::MaterialSettings::MultiMaterial::kEnable))
+                    return false;
+
+                return true;
+            }
+
+            //! \brief Hash of everything that has to match for two parts to slice the same: mesh content,
+            //!        settings and ranges. Placement is left out and checked separately.
+            QByteArray contentKey(const QSharedPointer<Part>& part)
+            {
+                QCryptographicHash hash(QCryptographicHash::Sha1);
+                for (const QSharedPointer<MeshBase>& mesh : part->meshes())
+                {
+                    QVector<MeshVertex> vertices = mesh->originalVertices();
+                    QVector<MeshFace> faces = mesh->originalFaces();
+
+                    QByteArray header;
+                    header.append(dynamic_cast<ClosedMesh*>(mesh.get()) != nullptr ? 'c' : 'o');
+                    header.append(QByteArray::number(vertices.size())).append(',').append(QByteArray::number(faces.size())).append(';');
+                    hash.addData(header);
+
+                    for (const MeshVertex& vertex : vertices)
+                    {
+                        float location[3] = { vertex.location.x(), vertex.location.y(), vertex.location.z() };
+                        hash.addData(reinterpret_cast<const char*>(location), sizeof(location));
+                    }
+
+                    for (const MeshFace& face : faces)
+                        hash.addData(reinterpret_cast<const char*>(face.vertex_index), sizeof(face.vertex_index));
+                }
+
+                hash.addData(QByteArray::fromStdString(part->getSb()->json().dump()));
+                hash.addData(QByteArray::fromStdString(part->rangesJson().dump()));
+                return hash.result();
+            }
+
+            //! \brief Finds how a copy is placed from its source and checks it against every vertex
+            //! \return false if the copy is not a turn about z and a move across the plate of the source
+            bool findPlacement(const QSharedPointer<Part>& source, const QSharedPointer<Part>& copy, bool allow_rotation, Instance& instance)
+            {
+                QVector<QSharedPointer<MeshBase>> source_meshes = source->meshes();
+                QVector<QSharedPointer<MeshBase>> copy_meshes = copy->meshes();
+                if (source_meshes.isEmpty() || source_meshes.size() != copy_meshes.size())
+                    return false;
+
+                bool invertible = false;
+                QMatrix4x4 source_inverse = source_meshes.first()->transformation().inverted(&invertible);
+                if (!invertible)
+                    return false;
+
+                QMatrix4x4 relative = copy_meshes.first()->transformation() * source_inverse;
+                double degrees = qRadiansToDegrees(qAtan2(relative(1, 0), relative(0, 0)));
+                if (!allow_rotation && !qFuzzyIsNull(degrees))
+                    return false;
+
+                instance.source = source;
+                instance.copy = copy;
+                instance.rotation = allow_rotation ? QQuaternion::fromAxisAndAngle(0, 0, 1, degrees) : QQuaternion();
+                instance.shift = Point(relative(0, 3), relative(1, 3), 0);
+
+                // the matrices only give a guess, the vertices decide
+                const Distance tolerance = micron;
+                QVector3D shift = instance.shift.toQVector3D();
+                for (int m = 0, end = source_meshes.size(); m < end; ++m)
+                {
+                    QVector<MeshVertex> source_vertices = source_meshes[m]->vertices();
+                    QVector<MeshVertex> copy_vertices = copy_meshes[m]->vertices();
+                    if (source_vertices.size() != copy_vertices.size())
+                        return false;
+
+                    for (int i = 0, count = source_vertices.size(); i < count; ++i)
+                    {
+                        QVector3D placed = instance.rotation.rotatedVector(source_vertices[i].location) + shift;
+                        if ((placed - copy_vertices[i].location).length() > tolerance())
+                            return false;
+                    }
+                }
+
+                return true;
+            }
+        }
+
+        QVector<Instance> findInstances(const Preprocessor::Parts& parts, const QSharedPointer<SettingsBase>& global_sb)
+        {
+            QVector<Instance> instances;
+
+            PartInstancingMode mode = static_cast<PartInstancingMode>(global_sb->setting<int>(Constants::ProfileSettings::Optimizations::kPartInstancing));
+            if (mode == PartInstancingMode::kOff)
+                return instances;
+
+            // these cut or change parts by where they are on the plate
+            if (!parts.settings_parts.isEmpty() || !parts.clipping_parts.isEmpty() || !parts.emboss_parts.isEmpty())
+                return instances;
+
+            if (global_sb->setting<int>(Constants::ExperimentalSettings::MultiNozzle::kNozzleCount) > 1)
+                return instances;
+
+            QVector<QSharedPointer<Part>> sources;
+            QVector<QByteArray> source_keys;
+            for (const QSharedPointer<Part>& part : parts.build_parts)
+            {
+                auto part_sb = QSharedPointer<SettingsBase>::create(*global_sb);
+                part_sb->populate(part->getSb());
+                if (!canInstance(part_sb))
+                    continue;
+
+                // a range may turn any of those on for some layers only
+                bool ranges_allow = true;
+                for (const QSharedPointer<SettingsRange>& range : part->ranges())
+                {
+                    if (range->getSb()->json().is_null())
+                        continue;
+
+                    auto range_sb = QSharedPointer<SettingsBase>::create(*part_sb);
+                    range_sb->populate(range->getSb());
+                    ranges_allow = ranges_allow && canInstance(range_sb);
+                }
+
+                if (!ranges_allow)
+                    continue;
+
+                QByteArray key = contentKey(part);
+                bool placed = false;
+                for (int i = 0, end = sources.size(); i < end && !placed; ++i)
+                {
+                    Instance instance;
+                    if (source_keys[i] == key && findPlacement(sources[i], part, mode == PartInstancingMode::kTranslatedAndRotated, instance))
+                    {
+                        instances.push_back(instance);
+                        placed = true;
+                    }
+                }
+
+                if (!placed)
+                {
+                    sources.push_back(part);
+                    source_keys.push_back(key);
+                }
+            }
+
+            return instances;
+        }
+
+        void linkSteps(const QVector<Instance>& instances)
+        {
+            for (const Instance& instance : instances)
+            {
+                instance.copy->clearSteps();
+                for (int i = 0, end = instance.source->countStepPairs(); i < end; ++i)
+                {
+                    // shares the source islands until placeCopies, and is left clean so it is not computed
+                    QSharedPointer<Layer> layer = QSharedPointer<Layer>::create(*instance.source->getStepPair(i).printing_layer);
+                    layer->setDirtyBit(false);
+
+                    // the outline and orientation belong to the copy from the start
+                    layer->setGeometry(layer->getGeometry().transform(instance.rotation, instance.shift), QVector3D());
+                    layer->setOrientation(layer->getSlicingPlane(),
+                                          Point(instance.rotation.rotatedVector(layer->getShift().toQVector3D())) + instance.shift);
+                    instance.copy->appendStep(layer);
+                }
+            }
+        }
+
+        void placeCopies(const QVector<Instance>& instances)
+        {
+            QVector<QSharedPointer<Layer>> copies;
+            QVector<QSharedPointer<Layer>> sources;
+            QVector<const Instance*> placements;
+            for (const Instance& instance : instances)
+            {
+                for (int i = 0, end = qMin(instance.copy->countStepPairs(), instance.source->countStepPairs()); i < end; ++i)
+                {
+                    copies.push_back(instance.copy->getStepPair(i).printing_layer);
+                    sources.push_back(instance.source->getStepPair(i).printing_layer);
+                    placements.push_back(&instance);
+
+                    // brought into its frame here, so the loop below only reads it
+                    sources.last()->applyFrame();
+                }
+            }
+
+            const QSharedPointer<Layer>* copy_data = copies.constData();
+            const QSharedPointer<Layer>* source_data = sources.constData();
+            const Instance* const* placement_data = placements.constData();
+
+            //! Sources are only read, so every copy can be placed at once
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < copies.size(); ++i)
+            {
+                copy_data[i]->placeIslandsOf(source_data[i], placement_data[i]->rotation, placement_data[i]->shift);
+
+                // placed islands still need to be connected like freshly computed ones
+                copy_data[i]->setDirtyBit(true);
+            }
+        }
+    }
+}
@@ -35,6 +35,14 @@ namespace ORNL
         int parts_done = 0;
         for(const QSharedPointer<Part>& part : m_parts.build_parts)
         {
+            if(m_skipped_parts.contains(part->getId()))
+            {
+                ++parts_done;
+                if(m_status_update != nullptr)
+                    m_status_update((double)parts_done / (double)total_num_parts * 100);
+                continue;
+            }
+
             // Setup settings
             auto part_sb = QSharedPointer<SettingsBase>::create(*global_sb); // Copy global
             part_sb->populate(part->getSb()); // Fill with part overrides
@@ -331,4 +339,9 @@ namespace ORNL
     {
         return m_parts;
     }
+
+    void Preprocessor::skipParts(const QSet<QUuid>& part_ids)
+    {
+        m_skipped_parts = part_ids;
+    }
 }
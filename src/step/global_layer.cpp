@@ -3,6 +3,7 @@
 #include "step/layer/scan_layer.h"
 #include <optimizers/island_order_optimizer.h>
 #include "geometry/path_modifier.h"
+#include "geometry/segments/travel.h"
 #include "step/layer/regions/skirt.h"
 #include "utilities/mathutils.h"
 
@@ -215,7 +216,7 @@ namespace ORNL {
                     int index = island_optimizer.computeNextIndex();
                     QSharedPointer<IslandBase> isl = wire_feed_islands[index];
                     wire_feed_islands.removeAt(index);
-                    isl->optimize(m_layer_number, start[tool], previous_regions[tool]);
+                    isl->optimizePlaced(m_layer_number, start[tool], previous_regions[tool]);
                     m_island_order[tool].push_back(isl);
                     island_optimizer.setStartPoint(start[tool]);
                 }
@@ -228,7 +229,7 @@ namespace ORNL {
             if(skirt_islands.size() > 0)
             {
                 m_island_order[tool].push_back(skirt_islands[0]);
-                m_island_order[tool].last()->optimize(m_layer_number, start[tool], previous_regions[tool]);
+                m_island_order[tool].last()->optimizePlaced(m_layer_number, start[tool], previous_regions[tool]);
             }
 
             QList<QList<QSharedPointer<IslandBase>>> ordered_islands_to_process;
@@ -280,7 +281,7 @@ namespace ORNL {
                     QSharedPointer<IslandBase> currentIsland = islandSet[index];
                     if(!visited_islands.contains(currentIsland))
                     {
-                        currentIsland->optimize(m_layer_number, start[tool], previous_regions[tool]);
+                        currentIsland->optimizePlaced(m_layer_number, start[tool], previous_regions[tool]);
                         m_island_order[tool].push_back(currentIsland);
                         visited_islands.push_back(currentIsland);
                     }
@@ -292,7 +293,7 @@ namespace ORNL {
                         {
                             int index = island_optimizer.computeNextIndex();
                             QSharedPointer<IslandBase> currentIsland = childrenSet[index];
-                            currentIsland->optimize(m_layer_number, start[tool], previous_regions[tool]);
+                            currentIsland->optimizePlaced(m_layer_number, start[tool], previous_regions[tool]);
                             m_island_order[tool].push_back(currentIsland);
                             childrenSet.removeAt(index);
                         }
@@ -313,7 +314,7 @@ namespace ORNL {
                     int index = island_optimizer.computeNextIndex();
                     QSharedPointer<IslandBase> isl = thermal_scan_islands[index];
                     thermal_scan_islands.removeAt(index);
-                    isl->optimize(m_layer_number, start[tool], previous_regions[tool]);
+                    isl->optimizePlaced(m_layer_number, start[tool], previous_regions[tool]);
                     m_island_order[tool].push_back(isl);
                 }
             }
@@ -328,6 +329,97 @@ namespace ORNL {
         } // end of for each tool/nozzle
     }
 
+    bool GlobalLayer::canReconnectPaths(QSharedPointer<SettingsBase> global_sb)
+    {
+        // scan layers are ordered and connected across parts
+        if (containsScanLayers())
+            return false;
+
+        if (static_cast<IslandOrderOptimization>(global_sb->setting<int>(Constants::ProfileSettings::Optimizations::kIslandOrder)) == IslandOrderOptimization::kRandom)
+            return false;
+
+        auto self_contained = [](const QSharedPointer<SettingsBase>& sb)
+        {
+            // these read the regions of the layer below, or change them
+            if (sb->setting<bool>(Constants::ProfileSettings::SpecialModes::kEnableSpiralize) ||
+                sb->setting<bool>(Constants::PrinterSettings::MachineSetup::kSupportsE1) ||
+                sb->setting<bool>(Constants::PrinterSettings::MachineSetup::kSupportsE2))
+                return false;
+
+            if (sb->setting<bool>(Constants::MaterialSettings::MultiMaterial::kEnable) &&
+                sb->setting<Distance>(Constants::MaterialSettings::MultiMaterial::kTransitionDistance) > 0 &&
+                !sb->setting<bool>(Constants::ExperimentalSettings::MultiNozzle::kEnableMultiNozzleMultiMaterial))
+                return false;
+
+            // these give a different result every time, or flip the geometry every time
+            if (static_cast<PathOrderOptimization>(sb->setting<int>(Constants::ProfileSettings::Optimizations::kPathOrder)) == PathOrderOptimization::kRandom ||
+                static_cast<PointOrderOptimization>(sb->setting<int>(Constants::ProfileSettings::Optimizations::kPointOrder)) == PointOrderOptimization::kRandom ||
+                sb->setting<bool>(Constants::ProfileSettings::Optimizations::kLocalRandomnessEnable))
+                return false;
+
+            if (static_cast<PrintDirection>(sb->setting<int>(Constants::ProfileSettings::Ordering::kPerimeterReverseDirection)) != PrintDirection::kReverse_off ||
+                static_cast<PrintDirection>(sb->setting<int>(Constants::ProfileSettings::Ordering::kInsetReverseDirection)) != PrintDirection::kReverse_off)
+                return false;
+
+            return true;
+        };
+
+        if (!self_contained(global_sb))
+            return false;
+
+        for (const QSharedPointer<IslandBase>& island : getIslands())
+        {
+            if (!self_contained(island->getSb()))
+                return false;
+
+            // resetPaths can only restore regions that start out without paths
+            for (const QSharedPointer<RegionBase>& region : island->getRegions())
+            {
+                if (!self_contained(region->getSb()) || !region->getPaths().isEmpty())
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    void GlobalLayer::resetPaths()
+    {
+        for (const QSharedPointer<IslandBase>& island : getIslands())
+        {
+            for (const QSharedPointer<RegionBase>& region : island->getRegions())
+                region->getPaths().clear();
+        }
+
+        m_island_order.clear();
+    }
+
+    bool GlobalLayer::moveFirstTravel(int tool, const Point& from, const Point& to)
+    {
+        if (tool >= m_island_order.size())
+            return false;
+
+        // the first region with paths is the one that started from the given point
+        for (const QSharedPointer<IslandBase>& island : m_island_order[tool])
+        {
+            for (const QSharedPointer<RegionBase>& region : island->getRegions())
+            {
+                QVector<Path>& paths = region->getPaths();
+                if (paths.isEmpty() || paths.front().size() == 0)
+                    continue;
+
+                QSharedPointer<SegmentBase> first = paths.front().front();
+                if (first.dynamicCast<TravelSegment>().isNull() || first->start() != from)
+                    return false;
+
+                first->setStart(to);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     QList<QMap<QSharedPointer<IslandBase>, QList<QSharedPointer<IslandBase>>>> GlobalLayer::createSequence(QList<QSharedPointer<IslandBase>> parent, QList<QList<QSharedPointer<IslandBase>>> children)
     {
         QList<QMap<QSharedPointer<IslandBase>, QList<QSharedPointer<IslandBase>>>> result;
@@ -389,8 +481,18 @@ namespace ORNL {
         return layer_islands;
     }
 
+    void GlobalLayer::applyFrames()
+    {
+        for (const QSharedPointer<Part::StepPair>& step_pair : m_step_pairs)
+        {
+            if (step_pair->printing_layer != nullptr)
+                step_pair->printing_layer->applyFrame();
+        }
+    }
+
     QString GlobalLayer::writeGCode(QSharedPointer<WriterBase> writer)
     {
+        applyFrames();
         QString gcode;
 
         for (int tool = 0, end = m_island_order.size(); tool < end; ++tool)
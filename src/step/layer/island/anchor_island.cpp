@@ -11,6 +11,13 @@ namespace ORNL {
         m_island_type = IslandType::kPolymer;
     }
 
+    QSharedPointer<IslandBase> AnchorIsland::clone() const
+    {
+        QSharedPointer<AnchorIsland> island = QSharedPointer<AnchorIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void AnchorIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
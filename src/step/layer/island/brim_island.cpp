@@ -11,6 +11,13 @@ namespace ORNL {
         m_island_type = IslandType::kBrim;
     }
 
+    QSharedPointer<IslandBase> BrimIsland::clone() const
+    {
+        QSharedPointer<BrimIsland> island = QSharedPointer<BrimIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void BrimIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
@@ -339,6 +339,38 @@ namespace ORNL {
         }
     }
 
+    void IslandBase::place(const QQuaternion& rotation, const Point& shift)
+    {
+        m_geometry = m_geometry.transform(rotation, shift);
+        m_placement_rotation = rotation;
+        m_placement_shift = shift;
+        m_placed = true;
+    }
+
+    void IslandBase::optimizePlaced(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
+    {
+        if (!m_placed)
+        {
+            optimize(layerNumber, currentLocation, previousRegions);
+            return;
+        }
+
+        // only this island's paths are made here, paths that came before stay where they are
+        QQuaternion inverse = m_placement_rotation.inverted();
+        currentLocation = Point(inverse.rotatedVector((currentLocation - m_placement_shift).toQVector3D()));
+
+        optimize(layerNumber, currentLocation, previousRegions);
+
+        transform(m_placement_rotation, m_placement_shift);
+        currentLocation = Point(m_placement_rotation.rotatedVector(currentLocation.toQVector3D())) + m_placement_shift;
+    }
+
+    void IslandBase::detachRegions()
+    {
+        for (QSharedPointer<RegionBase>& region : m_regions)
+            region = region->clone();
+    }
+
     void IslandBase::applyMapping(QSharedPointer<Parameterization> parameterization, QVector3D normal_offset)
     {
         for(QSharedPointer<RegionBase> region : m_regions)
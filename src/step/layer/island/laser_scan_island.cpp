@@ -11,6 +11,13 @@ namespace ORNL {
         m_island_type = IslandType::kLaserScan;
     }
 
+    QSharedPointer<IslandBase> LaserScanIsland::clone() const
+    {
+        QSharedPointer<LaserScanIsland> island = QSharedPointer<LaserScanIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void LaserScanIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
@@ -52,6 +52,13 @@ namespace ORNL {
         m_island_type = IslandType::kPolymer;
     }
 
+    QSharedPointer<IslandBase> PolymerIsland::clone() const
+    {
+        QSharedPointer<PolymerIsland> island = QSharedPointer<PolymerIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void PolymerIsland::optimize(int layerNumber, Point &currentLocation,
                                  QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
@@ -48,6 +48,13 @@ namespace ORNL {
         m_island_type = IslandType::kPowderSector;
     }
 
+    QSharedPointer<IslandBase> PowderSectorIsland::clone() const
+    {
+        QSharedPointer<PowderSectorIsland> island = QSharedPointer<PowderSectorIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void PowderSectorIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         //NOP
@@ -11,6 +11,13 @@ namespace ORNL {
         m_island_type = IslandType::kRaft;
     }
 
+    QSharedPointer<IslandBase> RaftIsland::clone() const
+    {
+        QSharedPointer<RaftIsland> island = QSharedPointer<RaftIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void RaftIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
@@ -8,6 +8,13 @@ namespace ORNL {
         m_island_type = IslandType::kSkirt;
     }
 
+    QSharedPointer<IslandBase> SkirtIsland::clone() const
+    {
+        QSharedPointer<SkirtIsland> island = QSharedPointer<SkirtIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void SkirtIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
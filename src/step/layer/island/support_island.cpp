@@ -12,6 +12,13 @@ namespace ORNL {
         m_island_type = IslandType::kSupport;
     }
 
+    QSharedPointer<IslandBase> SupportIsland::clone() const
+    {
+        QSharedPointer<SupportIsland> island = QSharedPointer<SupportIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void SupportIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
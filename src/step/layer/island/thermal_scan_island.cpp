@@ -11,6 +11,13 @@ namespace ORNL {
         m_island_type = IslandType::kThermalScan;
     }
 
+    QSharedPointer<IslandBase> ThermalScanIsland::clone() const
+    {
+        QSharedPointer<ThermalScanIsland> island = QSharedPointer<ThermalScanIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void ThermalScanIsland::optimize(int layerNumber, Point& currentLocation, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
         bool unused = true;
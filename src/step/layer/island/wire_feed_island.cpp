@@ -15,6 +15,13 @@ namespace ORNL {
         m_island_type = IslandType::kWireFeed;
     }
 
+    QSharedPointer<IslandBase> WireFeedIsland::clone() const
+    {
+        QSharedPointer<WireFeedIsland> island = QSharedPointer<WireFeedIsland>::create(*this);
+        island->detachRegions();
+        return island;
+    }
+
     void WireFeedIsland::optimize(int layerNumber, Point &currentLocation,
                                   QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
@@ -1,6 +1,15 @@
 // Main Module
 #include "step/layer/layer.h"
 
+// Qt
+#include <QBitArray>
+#include <QHash>
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 // Local
 #include "step/layer/island/polymer_island.h"
 
@@ -11,11 +20,94 @@
 #include "utilities/mathutils.h"
 
 namespace ORNL {
+    namespace
+    {
+        //! \brief Translation invariant summary of a polygon outline, used to rule
+        //! out duplicate islands before running an exact XOR
+        struct PolygonSignature
+        {
+            //! \brief unsigned area and perimeter
+            double area = 0.0;
+            double perimeter = 0.0;
+
+            //! \brief area centroid, or the vertex average for degenerate outlines
+            double centroid_x = 0.0;
+            double centroid_y = 0.0;
+
+            //! \brief distance from the centroid to the farthest vertex
+            double radius = 0.0;
+        };
+
+        PolygonSignature signatureOf(const Polygon& polygon)
+        {
+            PolygonSignature signature;
+            const int count = polygon.size();
+            if (count == 0)
+                return signature;
+
+            double twice_area = 0.0, cx = 0.0, cy = 0.0, sum_x = 0.0, sum_y = 0.0;
+            for (int i = 0, j = count - 1; i < count; j = i++)
+            {
+                const double x0 = polygon[j].x(), y0 = polygon[j].y();
+                const double x1 = polygon[i].x(), y1 = polygon[i].y();
+                const double cross = x0 * y1 - x1 * y0;
+                twice_area += cross;
+                cx += (x0 + x1) * cross;
+                cy += (y0 + y1) * cross;
+                sum_x += x1;
+                sum_y += y1;
+                signature.perimeter += std::hypot(x1 - x0, y1 - y0);
+            }
+
+            signature.area = std::abs(twice_area) / 2.0;
+            if (twice_area != 0.0)
+            {
+                signature.centroid_x = cx / (3.0 * twice_area);
+                signature.centroid_y = cy / (3.0 * twice_area);
+            }
+            else
+            {
+                signature.centroid_x = sum_x / count;
+                signature.centroid_y = sum_y / count;
+            }
+
+            for (const Point& point : polygon)
+                signature.radius = std::max(signature.radius, std::hypot(point.x() - signature.centroid_x, point.y() - signature.centroid_y));
+
+            return signature;
+        }
+
+        //! \brief Largest symmetric difference area two polygons may have and still be
+        //! duplicates, plus slack for the rounding to integer points the XOR does
+        double duplicateTolerance(const PolygonSignature& lhs, const PolygonSignature& rhs, double sameness)
+        {
+            return std::abs(1.0 - sameness) * lhs.area + 2.0 * (lhs.perimeter + rhs.perimeter);
+        }
+
+        //! \brief Whether lhs shifted by offset can be a duplicate of rhs. This only
+        //! rejects pairs the XOR test would reject too:
+        //! - the areas differ by at most the symmetric difference d
+        //! - the centroids are at most d * (lhs.radius + rhs.radius) / (rhs.area - d) apart
+        bool mayDuplicate(const PolygonSignature& lhs, const PolygonSignature& rhs, const Point& offset, double sameness)
+        {
+            const double tolerance = duplicateTolerance(lhs, rhs, sameness);
+            if (std::abs(lhs.area - rhs.area) > tolerance)
+                return false;
+
+            if (rhs.area <= tolerance)
+                return true;
+
+            const double shift = std::hypot(lhs.centroid_x + offset.x() - rhs.centroid_x, lhs.centroid_y + offset.y() - rhs.centroid_y) - 2.0;
+            return shift * (rhs.area - tolerance) <= tolerance * (lhs.radius + rhs.radius);
+        }
+    }
+
     Layer::Layer(uint layer_nr, const QSharedPointer<SettingsBase>& sb) : Step(sb), m_layer_nr(layer_nr) {
         m_type = StepType::kLayer;
     }
 
     QString Layer::writeGCode(QSharedPointer<WriterBase> writer) {
+        applyFrame();
         QString gcode;
 
         bool shouldOutputGcode = false;
@@ -47,6 +139,7 @@ namespace ORNL {
     }
 
     void Layer::compute() {
+        applyFrame();
         for (QSharedPointer<IslandBase> island : m_islands) {
             island->compute(m_layer_nr, m_sync);
 
@@ -61,6 +154,7 @@ namespace ORNL {
 
     void Layer::connectPaths(Point& start, int& start_index, QVector<QSharedPointer<RegionBase>>& previousRegions)
     {
+        applyFrame();
         m_island_order.clear();
 
         // Optimize the layer.
@@ -262,18 +356,93 @@ namespace ORNL {
         }
 
         double sameness = getSb()->setting<double>(Constants::ExperimentalSettings::MultiNozzle::kDuplicatePathSimilarity) / 100.0;
-        QVector<int> islands_to_remove = QVector<int>();
-        QVector<int> islands_to_keep = QVector<int>();
 
-        // loop through all pairs of islands, check for identical geometry separated by nozzle offset distance
-        // if duplicate geometry is found, remove it and turn on multiple nozzles for first island
         auto islands = getIslands();
         int num_islands = islands.size();
+        QBitArray islands_to_remove(num_islands);
+        QBitArray islands_to_keep(num_islands);
+
+        // summarize every polygon once, the pair tests below only compare summaries
+        QVector<QVector<PolygonSignature>> signatures(num_islands);
+        double max_radius = 0.0, max_perimeter = 0.0;
         for (int i = 0; i < num_islands; ++i)
         {
-            for (int j = 0; j < num_islands; ++j)
+            for (const Polygon& polygon : islands[i]->getGeometry())
+                signatures[i].append(signatureOf(polygon));
+            if (!signatures[i].isEmpty())
             {
-                if (i==j || islands_to_remove.contains(i) || islands_to_keep.contains(j))
+                max_radius = std::max(max_radius, signatures[i].first().radius);
+                max_perimeter = std::max(max_perimeter, signatures[i].first().perimeter);
+            }
+        }
+
+        // how far the first polygon of a duplicate of island i can be from where a
+        // nozzle offset puts it, taking the loosest tolerance any island allows.
+        // Infinite when the tolerance is too loose to tell, those islands check everything.
+        QVector<double> search_radius(num_islands, std::numeric_limits<double>::infinity());
+        double cell_size = 0.0;
+        for (int i = 0; i < num_islands; ++i)
+        {
+            if (signatures[i].isEmpty())
+                continue;
+
+            const PolygonSignature& first = signatures[i].first();
+            const double tolerance = std::abs(1.0 - sameness) * first.area + 2.0 * (first.perimeter + max_perimeter);
+            if (first.area > 2.0 * tolerance)
+            {
+                search_radius[i] = tolerance * (first.radius + max_radius) / (first.area - 2.0 * tolerance) + 2.0;
+                cell_size = std::max(cell_size, search_radius[i]);
+            }
+        }
+        cell_size = std::max(cell_size, 1.0);
+
+        // islands bucketed by the centroid of their first polygon
+        auto cellOf = [cell_size](double value) { return int(std::floor(value / cell_size)); };
+        QHash<QPair<int, int>, QVector<int>> buckets;
+        for (int j = 0; j < num_islands; ++j)
+        {
+            if (!signatures[j].isEmpty())
+                buckets[qMakePair(cellOf(signatures[j].first().centroid_x), cellOf(signatures[j].first().centroid_y))].append(j);
+        }
+
+        // loop through all pairs of islands, check for identical geometry separated by nozzle offset distance
+        // if duplicate geometry is found, remove it and turn on multiple nozzles for first island
+        for (int i = 0; i < num_islands; ++i)
+        {
+            if (islands_to_remove.testBit(i))
+                continue;
+
+            // only islands whose first polygon lands near island i moved by some nozzle offset can match
+            QVector<int> candidates;
+            if (std::isinf(search_radius[i]))
+            {
+                candidates.reserve(num_islands);
+                for (int j = 0; j < num_islands; ++j)
+                    candidates.append(j);
+            }
+            else
+            {
+                const PolygonSignature& first = signatures[i].first();
+                for (int nozzle = 1; nozzle < num_nozzles; ++nozzle)
+                {
+                    const double x = first.centroid_x + nozzle_offsets[nozzle].x();
+                    const double y = first.centroid_y + nozzle_offsets[nozzle].y();
+                    for (int cx = cellOf(x - search_radius[i]), cx_end = cellOf(x + search_radius[i]); cx <= cx_end; ++cx)
+                        for (int cy = cellOf(y - search_radius[i]), cy_end = cellOf(y + search_radius[i]); cy <= cy_end; ++cy)
+                            candidates += buckets.value(qMakePair(cx, cy));
+                }
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            }
+
+            for (int j : candidates)
+            {
+                if (i==j || islands_to_remove.testBit(i) || islands_to_keep.testBit(j))
+                    continue;
+
+                // island geometry can have multiple polygons
+                // islands must have same number of polygons to be the same
+                if (signatures[i].size() != signatures[j].size())
                     continue;
 
                 // if i-th island + offset == j-th island, remove j-th island and keep i-th island
@@ -283,62 +452,66 @@ namespace ORNL {
                 // make comparison for all extruder offsets
                 for ( int nozzle = 1; nozzle < num_nozzles; ++nozzle) //start at one bc all paths are already assigned nozzle 0
                 {
-                    // island geometry can have multiple polygons
-                    // islands must have same number of polygons to be the same
-                    if( geometry_i.size() == geometry_j.size())
+                    // skip the exact test when the summaries already rule the offset out
+                    bool may_match = true;
+                    for (int p = 0; p < signatures[i].size() && may_match; ++p)
+                        may_match = mayDuplicate(signatures[i][p], signatures[j][p], nozzle_offsets[nozzle], sameness);
+                    if (!may_match)
+                        continue;
+
+                    // assume all the polygons match until you find one that doesn't
+                    bool all_polygons_match = true;
+
+                    //loop through all the polygons to see if they match
+                    for(int p = 0; p < geometry_i.size() && all_polygons_match; ++p)
                     {
-                        // assume all the polygons match until you find one that doesn't
-                        bool all_polygons_match = true;
-
-                        //loop through all the polygons to see if they match
-                        for(int p = 0; p < geometry_i.size() && all_polygons_match; ++p)
-                        {
-                            // two polygons match if they're separated by a fixed offset
-                            // and that offset is some nozzles offset
-                            Polygon polygon_i = geometry_i[p];
-                            Polygon polygon_j = geometry_j[p];
+                        // two polygons match if they're separated by a fixed offset
+                        // and that offset is some nozzles offset
+                        Polygon polygon_i = geometry_i[p];
+                        Polygon polygon_j = geometry_j[p];
 
-                            //shift first polygon so that it should overlap the second
-                            Polygon shifted_poly_i = polygon_i.translate(nozzle_offsets[nozzle].toQVector3D());
+                        //shift first polygon so that it should overlap the second
+                        Polygon shifted_poly_i = polygon_i.translate(nozzle_offsets[nozzle].toQVector3D());
 
-                            // get the area of polygons that don't overlap
-                            PolygonList xor_result = shifted_poly_i ^ polygon_j;
-                            Area no_overlap_area = 0.0;
-                            for (Polygon poly : xor_result)
-                                no_overlap_area += poly.area();
+                        // get the area of polygons that don't overlap
+                        PolygonList xor_result = shifted_poly_i ^ polygon_j;
+                        Area no_overlap_area = 0.0;
+                        for (const Polygon& poly : xor_result)
+                            no_overlap_area += poly.area();
 
 
-                            // if non-overlapping area is too big, the polygons are not the same
-                            if (no_overlap_area() > std::abs((1.0-sameness) * polygon_i.area()()))
-                                all_polygons_match = false;
+                        // if non-overlapping area is too big, the polygons are not the same
+                        if (no_overlap_area() > std::abs((1.0-sameness) * polygon_i.area()()))
+                            all_polygons_match = false;
 
-                        }
+                    }
 
-                        if (all_polygons_match)
-                        {
-                            // tell first island to print with mulitple extruders
-                            islands_to_keep.append(i);
-                            islands[i]->addNozzle(nozzle);
+                    if (all_polygons_match)
+                    {
+                        // tell first island to print with mulitple extruders
+                        islands_to_keep.setBit(i);
+                        islands[i]->addNozzle(nozzle);
 
-                            // delete the pathing of the second island
-                            islands_to_remove.append(j);
+                        // delete the pathing of the second island
+                        islands_to_remove.setBit(j);
 
-                            break; //don't need to check any more nozzles
-                        }
+                        break; //don't need to check any more nozzles
                     }
                 }
             }
         }
 
         // remove the duplicate islands
-        for (int i : islands_to_remove)
+        for (int i = 0; i < num_islands; ++i)
         {
-            m_islands.remove((int) islands[i]->getType(), islands[i]);
+            if (islands_to_remove.testBit(i))
+                m_islands.remove((int) islands[i]->getType(), islands[i]);
         }
     }
 
     void Layer::calculateModifiers(Point& currentLocation)
     {
+        applyFrame();
         //check for spiral lift for end of layer
         if(this->getSb()->setting<bool>(Constants::MaterialSettings::SpiralLift::kLayerEnable))
         {
@@ -361,6 +534,7 @@ namespace ORNL {
     }
 
     void Layer::setSb(const QSharedPointer<SettingsBase>& sb) {
+        applyFrame();
         this->Step::setSb(sb);
 
         // For every island, set the the settings base.
@@ -396,6 +570,7 @@ namespace ORNL {
 
     Point Layer::getEndLocation()
     {
+        applyFrame();
         for(int island_index = m_island_order.size() - 1; island_index >= 0; --island_index)
         {
             auto regions = m_island_order[island_index]->getRegions();
@@ -415,6 +590,7 @@ namespace ORNL {
 
     void Layer::applyMapping()
     {
+        applyFrame();
         for(QSharedPointer<IslandBase> island : m_islands)
         {
             island->applyMapping(m_parameterization, m_normal_offset);
@@ -445,19 +621,15 @@ namespace ORNL {
 
             //rotate and then shift every island in the layer
             QQuaternion rotation = MathUtils::CreateQuaternion(QVector3D(0, 0, 1), m_slicing_plane.normal());
-
-            for (QSharedPointer<IslandBase> island : getIslands())
-            {
-                island->transform(rotation.inverted(), half_shift * -1);
-            }
+            composeFrame(rotation.inverted(), half_shift * -1);
 
             //unapply current origin shift
             Point m_origin_shift = Point(.0, .0, .0) - m_shift_amount;
             m_origin_shift.z(.0);
-            for (QSharedPointer<IslandBase> island : getIslands())
-            {
-                island->transform(QQuaternion(), m_origin_shift * -1);
-            }
+            composeFrame(QQuaternion(), m_origin_shift * -1);
+
+            //the paths are edited next, so move them now, together with anything reorient left queued
+            applyFrame();
         }
     }
 
@@ -466,10 +638,7 @@ namespace ORNL {
         //unapply current origin shift
         Point m_origin_shift = Point(.0, .0, .0) - m_shift_amount;
         m_origin_shift.z(.0);
-        for (QSharedPointer<IslandBase> island : getIslands())
-        {
-            island->transform(QQuaternion(), m_origin_shift);
-        }
+        composeFrame(QQuaternion(), m_origin_shift);
 
         //raise the layer by half the layer height, because cross-sections are taken at the center of a layer
         //but the path for the extruder should be at a full layer height
@@ -490,24 +659,39 @@ namespace ORNL {
         m_half_shift.y(m_half_shift.y() - m_sb->setting<double>(Constants::PrinterSettings::Dimensions::kYOffset));
 
         //rotate and then shift every island in the layer
+        //the frame is applied once, when the paths are next read
         QQuaternion rotation = MathUtils::CreateQuaternion(QVector3D(0, 0, 1), m_slicing_plane.normal());
-
-        for (QSharedPointer<IslandBase> island : getIslands())
-        {
-            island->transform(rotation, m_half_shift);
-        }
+        composeFrame(rotation, m_half_shift);
     }
 
     void Layer::compensateForRafts()
     {
-        for (QSharedPointer<IslandBase> island : getIslands())
+        composeFrame(QQuaternion(), m_raft_shift);
+    }
+
+    void Layer::placeIslandsOf(const QSharedPointer<Layer>& source, const QQuaternion& rotation, const Point& shift)
+    {
+        applyFrame();
+        source->applyFrame();
+
+        //values() lists the newest island of a type first, so they are added back to front to keep their order
+        m_islands.clear();
+        for (int type : source->m_islands.uniqueKeys())
         {
-            island->transform(QQuaternion(), m_raft_shift);
+            QList<QSharedPointer<IslandBase>> islands = source->m_islands.values(type);
+            for (int i = islands.size() - 1; i >= 0; --i)
+            {
+                QSharedPointer<IslandBase> island = islands[i]->clone();
+                island->place(rotation, shift);
+                m_islands.insert(type, island);
+            }
         }
+        m_island_order.clear();
     }
 
     float Layer::getMinZ()
     {
+        applyFrame();
         float min_z = std::numeric_limits<float>::max();
         for (QSharedPointer<IslandBase> island : m_islands)
         {
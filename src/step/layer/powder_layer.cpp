@@ -10,6 +10,7 @@ namespace ORNL {
     }
 
     QString PowderLayer::writeGCode(QSharedPointer<WriterBase> writer) {
+        applyFrame();
         QString gcode;
 
         for(int i = 0, end = m_island_order.size(); i < end; ++i)
@@ -41,6 +42,7 @@ namespace ORNL {
     }
 
     void PowderLayer::compute() {
+        applyFrame();
         for (QSharedPointer<IslandBase> island : m_islands) {
             island->compute(m_layer_nr, m_sync);
 
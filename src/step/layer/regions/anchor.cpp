@@ -8,6 +8,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Anchor::clone() const
+    {
+        QSharedPointer<Anchor> region = QSharedPointer<Anchor>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Anchor::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kAnchor);
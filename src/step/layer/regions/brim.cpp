@@ -9,6 +9,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Brim::clone() const
+    {
+        QSharedPointer<Brim> region = QSharedPointer<Brim>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Brim::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kBrim);
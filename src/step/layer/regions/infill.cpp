@@ -15,6 +15,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Infill::clone() const
+    {
+        QSharedPointer<Infill> region = QSharedPointer<Infill>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Infill::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kInfill);
@@ -11,6 +11,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> InfillSector::clone() const
+    {
+        QSharedPointer<InfillSector> region = QSharedPointer<InfillSector>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString InfillSector::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
 
@@ -19,6 +19,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Inset::clone() const
+    {
+        QSharedPointer<Inset> region = QSharedPointer<Inset>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Inset::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kInset);
@@ -107,6 +114,8 @@ namespace ORNL {
 
         m_paths.clear();
 
+        SettingsRegionSplitter splitter(m_sb, m_settings_polygons);
+
         if(static_cast<PrintDirection>(m_sb->setting<int>(Constants::ProfileSettings::Ordering::kInsetReverseDirection)) != PrintDirection::kReverse_off)
             for(Polyline& line : m_computed_geometry)
                 line = line.reverse();
@@ -116,7 +125,7 @@ namespace ORNL {
         while(poo.getCurrentPolylineCount() > 0)
         {
             Polyline result = poo.linkNextPolyline();
-            Path newPath = createPath(result);
+            Path newPath = createPath(result, splitter);
 
             if(newPath.size() > 0)
             {
@@ -133,7 +142,7 @@ namespace ORNL {
         }
     }
 
-    Path Inset::createPath(Polyline line)
+    Path Inset::createPath(Polyline line, const SettingsRegionSplitter& splitter)
     {
         Path new_path;
 
@@ -147,87 +156,23 @@ namespace ORNL {
 
         bool embossing_enable = m_sb->setting<bool>(Constants::PrinterSettings::Embossing::kEnableEmbossing);
 
-        for (int j = 0, end_cond = line.size(); j < end_cond; ++j)
+        int end_cond = line.size();
+        for (const SettingsRegionSplitter::Span& span : splitter.split(line, end_cond))
         {
-            Point start = line[j];
-            Point end = line[(j + 1) % end_cond];
-
-            bool is_settings_region = false;
-
-            QVector<Point> intersections;
-            for(auto settings_poly : m_settings_polygons)
-            {
-                QSharedPointer<SettingsBase> updatedBase = QSharedPointer<SettingsBase>::create(*m_sb);
-                updatedBase->populate(settings_poly.getSettings());
-                bool contains_start = settings_poly.inside(start);
-                bool contains_end   = settings_poly.inside(end);
-
-                if (contains_start) start.setSettings(updatedBase);
-                else start.setSettings(m_sb);
-
-                if (contains_end) end.setSettings(updatedBase);
-                else end.setSettings(m_sb);
-
-                if (contains_start) is_settings_region = true;
-                else if (contains_end) is_settings_region = false;
-
-                // Find if/ where this line intersects with a settings polygon
-                QVector<Point> poly_intersect = settings_poly.clipLine(start, end);
-
-                for (Point& point : poly_intersect)
-                    point.setSettings(updatedBase);
-
-                intersections.append(poly_intersect);
-            }
-
-            // Divide lines into subsections
-            if(intersections.size() > 0)
-            {
-                // Sort points in order to start
-                std::sort(intersections.begin(), intersections.end(), [start](auto lhs, auto rhs){
-                    return start.distance(lhs) < start.distance(rhs);
-                });
-
-                for(Point& point : intersections)
-                {
-                    // If no settings change, skip this point
-                    if(point.getSettings()->json() == m_sb->json())
-                        continue;
-
-
-                    QSharedPointer<LineSegment> segment = QSharedPointer<LineSegment>::create(start, point);
-
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Inset::kBeadWidth) : default_width);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,       is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight) : default_height);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,        is_settings_region ? start.getSettings()->setting< Velocity >(Constants::ProfileSettings::Inset::kSpeed) : default_speed);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            is_settings_region ? start.getSettings()->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kInset) : default_acceleration);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    is_settings_region ? start.getSettings()->setting< AngularVelocity >(Constants::ProfileSettings::Inset::kExtruderSpeed) : default_extruder_speed);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kMaterialNumber,   material_number);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kRegionType,       RegionType::kInset);
-
-                    if (embossing_enable) {
-                        segment->getSb()->setSetting(Constants::SegmentSettings::kESP, is_settings_region ? start.getSettings()->setting< float >(Constants::PrinterSettings::Embossing::kESPEmbossingValue) : default_esp_value);
-                        if (is_settings_region) segment->getSb()->setSetting(Constants::SegmentSettings::kPathModifiers, PathModifiers::kEmbossing);
-                    }
-
-                    new_path.append(segment);
-                    is_settings_region = !is_settings_region;
-                    start = point;
-                }
-            }
-
-            // Add final segment
-            QSharedPointer<LineSegment> segment = QSharedPointer<LineSegment>::create(start, end);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Inset::kBeadWidth) : default_width);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,       is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight) : default_height);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,        is_settings_region ? start.getSettings()->setting< Velocity >(Constants::ProfileSettings::Inset::kSpeed) : default_speed);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            is_settings_region ? start.getSettings()->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kInset) : default_acceleration);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    is_settings_region ? start.getSettings()->setting< AngularVelocity >(Constants::ProfileSettings::Inset::kExtruderSpeed) : default_extruder_speed);
+            bool is_settings_region = span.id != 0;
+            const QSharedPointer<SettingsBase>& span_sb = splitter.settings(span.id);
+
+            QSharedPointer<LineSegment> segment = QSharedPointer<LineSegment>::create(span.start, span.end);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            is_settings_region ? span_sb->setting< Distance >(Constants::ProfileSettings::Inset::kBeadWidth) : default_width);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,       is_settings_region ? span_sb->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight) : default_height);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,        is_settings_region ? span_sb->setting< Velocity >(Constants::ProfileSettings::Inset::kSpeed) : default_speed);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            is_settings_region ? span_sb->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kInset) : default_acceleration);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    is_settings_region ? span_sb->setting< AngularVelocity >(Constants::ProfileSettings::Inset::kExtruderSpeed) : default_extruder_speed);
             segment->getSb()->setSetting(Constants::SegmentSettings::kMaterialNumber,   material_number);
             segment->getSb()->setSetting(Constants::SegmentSettings::kRegionType,       RegionType::kInset);
 
             if (embossing_enable) {
-                segment->getSb()->setSetting(Constants::SegmentSettings::kESP, is_settings_region ? start.getSettings()->setting< float >(Constants::PrinterSettings::Embossing::kESPEmbossingValue) : default_esp_value);
+                segment->getSb()->setSetting(Constants::SegmentSettings::kESP, is_settings_region ? span_sb->setting< float >(Constants::PrinterSettings::Embossing::kESPEmbossingValue) : default_esp_value);
                 if (is_settings_region) segment->getSb()->setSetting(Constants::SegmentSettings::kPathModifiers, PathModifiers::kEmbossing);
             }
 
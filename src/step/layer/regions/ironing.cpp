@@ -13,6 +13,22 @@ namespace ORNL {
         : RegionBase(sb, index, settings_polygons, gridInfo) {
     }
 
+    QSharedPointer<RegionBase> Ironing::clone() const
+    {
+        QSharedPointer<Ironing> region = QSharedPointer<Ironing>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
+    void Ironing::addComputeInputs(QCryptographicHash& hash) const
+    {
+        RegionBase::addComputeInputs(hash);
+        int count = m_upper_geometry.size();
+        hash.addData(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (const PolygonList& poly_list : m_upper_geometry)
+            poly_list.addTo(hash);
+    }
+
     QString Ironing::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         if(m_paths.count() > 0){
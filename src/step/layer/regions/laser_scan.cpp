@@ -7,6 +7,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> LaserScan::clone() const
+    {
+        QSharedPointer<LaserScan> region = QSharedPointer<LaserScan>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString LaserScan::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         for (Path path : m_paths) {
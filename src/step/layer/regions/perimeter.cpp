@@ -22,6 +22,13 @@ namespace ORNL {
         : RegionBase(sb, index, settings_polygons, gridInfo, uncut_geometry) {
     }
 
+    QSharedPointer<RegionBase> Perimeter::clone() const
+    {
+        QSharedPointer<Perimeter> region = QSharedPointer<Perimeter>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Perimeter::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kPerimeter);
@@ -227,6 +234,8 @@ namespace ORNL {
 
         m_paths.clear();
 
+        SettingsRegionSplitter splitter(m_sb, m_settings_polygons);
+
         if(m_sb->setting<bool>(Constants::ProfileSettings::SpecialModes::kEnableSpiralize))
         {
             if(m_computed_geometry.size() > 0)
@@ -234,7 +243,7 @@ namespace ORNL {
                 poo.setGeometryToEvaluate(m_computed_geometry, RegionType::kPerimeter, static_cast<PathOrderOptimization>(m_sb->setting<int>(Constants::ProfileSettings::Optimizations::kPathOrder)));
 
                 Polyline result = poo.linkSpiralPolyline2D(m_was_last_region_spiral, m_sb->setting<Distance>(Constants::ProfileSettings::Layer::Layer::kLayerHeight));
-                Path newPath = createPath(result);
+                Path newPath = createPath(result, splitter);
                 if(!m_was_last_region_spiral)
                     PathModifierGenerator::GenerateTravel(newPath, current_location, m_sb->setting<Velocity>(Constants::ProfileSettings::Travel::kSpeed));
 
@@ -253,7 +262,7 @@ namespace ORNL {
             while(poo.getCurrentPolylineCount() > 0)
             {
                 Polyline result = poo.linkNextPolyline();
-                Path newPath = createPath(result);
+                Path newPath = createPath(result, splitter);
 
                 if(newPath.size() > 0)
                 {
@@ -361,7 +370,7 @@ namespace ORNL {
         }
     }
 
-    Path Perimeter::createPath(Polyline line)
+    Path Perimeter::createPath(Polyline line, const SettingsRegionSplitter& splitter)
     {
         const Point origin(m_sb->setting<double>(Constants::PrinterSettings::Dimensions::kXOffset), m_sb->setting<double>(Constants::PrinterSettings::Dimensions::kYOffset));
 
@@ -385,91 +394,22 @@ namespace ORNL {
         if(isSpiralized)
             --end_cond;
 
-        for (int j = 0; j < end_cond; ++j)
+        for (const SettingsRegionSplitter::Span& span : splitter.split(line, end_cond))
         {
-            Point start = line[j];
-            Point end;
-            if(isSpiralized)
-                end = line[j + 1];
-            else
-                end = line[(j + 1) % end_cond];
-
-            bool is_settings_region = false;
-
-            QVector<Point> intersections;
-            for(auto settings_poly : m_settings_polygons)
-            {
-                QSharedPointer<SettingsBase> updatedBase = QSharedPointer<SettingsBase>::create(*m_sb);
-                updatedBase->populate(settings_poly.getSettings());
-                bool contains_start = settings_poly.inside(start);
-                bool contains_end   = settings_poly.inside(end);
-
-                if (contains_start) start.setSettings(updatedBase);
-                else start.setSettings(m_sb);
-
-                if (contains_end) end.setSettings(updatedBase);
-                else end.setSettings(m_sb);
-
-                if (contains_start) is_settings_region = true;
-                else if (contains_end) is_settings_region = false;
-
-                // Find if/ where this line intersects with a settings polygon
-                QVector<Point> poly_intersect = settings_poly.clipLine(start, end);
-
-                for (Point& point : poly_intersect)
-                    point.setSettings(updatedBase);
-
-                intersections.append(poly_intersect);
-            }
-
-            // Divide lines into subsections
-            if(intersections.size() > 0)
-            {
-                // Sort points in order to start
-                std::sort(intersections.begin(), intersections.end(), [start](auto lhs, auto rhs){
-                    return start.distance(lhs) < start.distance(rhs);
-                });
-
-                for(Point& point : intersections)
-                {
-                    // If no settings change, skip this point
-                    if(point.getSettings()->json() == m_sb->json())
-                        continue;
-
-
-                    QSharedPointer<LineSegment> segment = QSharedPointer<LineSegment>::create(start, point);
-
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Perimeter::kBeadWidth) : default_width);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,       is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight) : default_height);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,        is_settings_region ? start.getSettings()->setting< Velocity >(Constants::ProfileSettings::Perimeter::kSpeed) : default_speed);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            is_settings_region ? start.getSettings()->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kPerimeter) : default_acceleration);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    is_settings_region ? start.getSettings()->setting< AngularVelocity >(Constants::ProfileSettings::Perimeter::kExtruderSpeed) : default_extruder_speed);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kMaterialNumber,   material_number);
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kRegionType,       RegionType::kPerimeter);
-
-                    if (embossing_enable) {
-                        segment->getSb()->setSetting(Constants::SegmentSettings::kESP, is_settings_region ? start.getSettings()->setting< float >(Constants::PrinterSettings::Embossing::kESPEmbossingValue) : default_esp_value);
-                        if (is_settings_region) segment->getSb()->setSetting(Constants::SegmentSettings::kPathModifiers, PathModifiers::kEmbossing);
-                    }
-
-                    new_path.append(segment);
-                    is_settings_region = !is_settings_region;
-                    start = point;
-                }
-            }
-
-            // Add final segment
-            QSharedPointer<LineSegment> segment = QSharedPointer<LineSegment>::create(start, end);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Perimeter::kBeadWidth) : default_width);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,       is_settings_region ? start.getSettings()->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight) : default_height);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,        is_settings_region ? start.getSettings()->setting< Velocity >(Constants::ProfileSettings::Perimeter::kSpeed) : default_speed);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            is_settings_region ? start.getSettings()->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kPerimeter) : default_acceleration);
-            segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    is_settings_region ? start.getSettings()->setting< AngularVelocity >(Constants::ProfileSettings::Perimeter::kExtruderSpeed) : default_extruder_speed);
+            bool is_settings_region = span.id != 0;
+            const QSharedPointer<SettingsBase>& span_sb = splitter.settings(span.id);
+
+            QSharedPointer<LineSegment> segment = QSharedPointer<LineSegment>::create(span.start, span.end);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            is_settings_region ? span_sb->setting< Distance >(Constants::ProfileSettings::Perimeter::kBeadWidth) : default_width);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,       is_settings_region ? span_sb->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight) : default_height);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,        is_settings_region ? span_sb->setting< Velocity >(Constants::ProfileSettings::Perimeter::kSpeed) : default_speed);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            is_settings_region ? span_sb->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kPerimeter) : default_acceleration);
+            segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    is_settings_region ? span_sb->setting< AngularVelocity >(Constants::ProfileSettings::Perimeter::kExtruderSpeed) : default_extruder_speed);
             segment->getSb()->setSetting(Constants::SegmentSettings::kMaterialNumber,   material_number);
             segment->getSb()->setSetting(Constants::SegmentSettings::kRegionType,       RegionType::kPerimeter);
 
             if (embossing_enable) {
-                segment->getSb()->setSetting(Constants::SegmentSettings::kESP, is_settings_region ? start.getSettings()->setting< float >(Constants::PrinterSettings::Embossing::kESPEmbossingValue) : default_esp_value);
+                segment->getSb()->setSetting(Constants::SegmentSettings::kESP, is_settings_region ? span_sb->setting< float >(Constants::PrinterSettings::Embossing::kESPEmbossingValue) : default_esp_value);
                 if (is_settings_region) segment->getSb()->setSetting(Constants::SegmentSettings::kPathModifiers, PathModifiers::kEmbossing);
             }
 
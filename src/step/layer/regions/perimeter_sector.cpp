@@ -11,6 +11,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> PerimeterSector::clone() const
+    {
+        QSharedPointer<PerimeterSector> region = QSharedPointer<PerimeterSector>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString PerimeterSector::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
 
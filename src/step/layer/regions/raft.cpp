@@ -9,6 +9,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Raft::clone() const
+    {
+        QSharedPointer<Raft> region = QSharedPointer<Raft>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Raft::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kRaft);
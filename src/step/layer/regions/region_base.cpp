@@ -23,6 +23,20 @@ namespace ORNL {
         m_paths.append(path);
     }
 
+    void RegionBase::detachPaths()
+    {
+        for (Path& path : m_paths)
+        {
+            for (QSharedPointer<SegmentBase>& segment : path.getSegments())
+                segment = segment->clone();
+        }
+    }
+
+    void RegionBase::addComputeInputs(QCryptographicHash& hash) const
+    {
+        m_uncut_geometry.addTo(hash);
+    }
+
     QSharedPointer<SettingsBase> RegionBase::getSb() const {
         return m_sb;
     }
@@ -169,11 +183,15 @@ namespace ORNL {
                     Distance next_segment_distance = current_segments[j]->end().distance(current_segments[j]->start());
                     if(next_segment_distance > transition_distance)
                     {
+                        //The split point lies on the segment in every coordinate, so it is right whether or not
+                        //the layer these paths belong to still has its frame queued (see Step::composeFrame)
                         float percentage = ((next_segment_distance - transition_distance) / next_segment_distance)();
                         Point end = Point((1.0 - percentage) * current_segments[j]->start().x() + percentage *
                                           current_segments[j]->end().x(),
                                           (1.0 - percentage) * current_segments[j]->start().y() + percentage *
-                                          current_segments[j]->end().y());
+                                          current_segments[j]->end().y(),
+                                          (1.0 - percentage) * current_segments[j]->start().z() + percentage *
+                                          current_segments[j]->end().z());
 
                         Point old_end = current_segments[j]->end();
                         current_segments[j]->setEnd(end);
@@ -55,6 +55,13 @@ namespace ORNL {
         m_wire_region = isWireFed;
     }
 
+    QSharedPointer<RegionBase> Skeleton::clone() const
+    {
+        QSharedPointer<Skeleton> region = QSharedPointer<Skeleton>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Skeleton::writeGCode(QSharedPointer<WriterBase> writer)
     {
         QString gcode;
@@ -12,6 +12,28 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Skin::clone() const
+    {
+        QSharedPointer<Skin> region = QSharedPointer<Skin>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
+    void Skin::addComputeInputs(QCryptographicHash& hash) const
+    {
+        RegionBase::addComputeInputs(hash);
+        for (const QVector<PolygonList>* geometry : { &m_upper_geometry, &m_lower_geometry, &m_gradual_geometry })
+        {
+            int count = geometry->size();
+            hash.addData(reinterpret_cast<const char*>(&count), sizeof(count));
+            for (const PolygonList& poly_list : *geometry)
+                poly_list.addTo(hash);
+        }
+
+        char includes[3] = { m_upper_geometry_includes_top, m_lower_geometry_includes_bottom, m_gradual_geometry_includes_top };
+        hash.addData(includes, sizeof(includes));
+    }
+
     QString Skin::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kSkin);
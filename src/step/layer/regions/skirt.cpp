@@ -8,6 +8,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Skirt::clone() const
+    {
+        QSharedPointer<Skirt> region = QSharedPointer<Skirt>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Skirt::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kSkirt);
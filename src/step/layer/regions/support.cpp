@@ -3,12 +3,20 @@
 #include "geometry/segments/line.h"
 #include "optimizers/polyline_order_optimizer.h"
 #include "geometry/path_modifier.h"
+#include "geometry/pattern_generator.h"
 
 namespace ORNL {
     Support::Support(const QSharedPointer<SettingsBase>& sb, const QVector<SettingsPolygon>& settings_polygons) : RegionBase(sb, settings_polygons) {
         // NOP
     }
 
+    QSharedPointer<RegionBase> Support::clone() const
+    {
+        QSharedPointer<Support> region = QSharedPointer<Support>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString Support::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kSupport);
@@ -67,39 +75,8 @@ namespace ORNL {
         //! Create a non-path border for the infill pattern
         PolygonList border_polygons = m_geometry.offset(-bead_width);
 
-        PolygonList rotated_polygon = border_polygons.rotate(rotation);
-
-        //! Get the bounding box for the polygons. outline_minimum is the minimum
-        Point outline_minimum = rotated_polygon.min();
-        Point outline_maximum = rotated_polygon.max();
-
-        //! The result we get after intersecting the polygons with the grid lines
-        QVector<Polyline> cutlines;
-
-        //! The space left over after all the max number of cutlines are generated
-        Distance freeSpace = (outline_maximum.toDistance3D().x - outline_minimum.toDistance3D().x) % line_spacing;
-
-        //! start at the bounding box's minimum x value and go all the way to the bounding box's maximum x value.
-        //! As we go along, every "line_spacing" distance we intersect the polygons with the grid lines
-        for (Distance x = outline_minimum.toDistance3D().x + (freeSpace / 2); x < outline_maximum.toDistance3D().x; x += line_spacing)
-        {
-            //! Create the grid lines
-            Polyline cutline;
-            cutline << Point(x(), outline_minimum.y());
-            cutline << Point(x(), outline_maximum.y());
-
-            //! Intersect the polygons and the gridlines and store them
-            //! \note This calls ClipperLib
-            cutlines += rotated_polygon & cutline;
-        }
-
-        //! Unrotate polygons
-        for(int i = 0; i < cutlines.size(); i++)
-        {
-            cutlines[i] = cutlines[i].rotate(-rotation);
-            if(i % 2 == 0)
-                cutlines[i] = cutlines[i].reverse();
-        }
+        //! Same parallel lines as line infill, clipped in one pass
+        QVector<Polyline> cutlines = PatternGenerator::GenerateLines(border_polygons, line_spacing, rotation);
 
         m_computed_infill_geometry.append(cutlines);
     }
@@ -9,6 +9,13 @@ namespace ORNL {
         // NOP
     }
 
+    QSharedPointer<RegionBase> ThermalScan::clone() const
+    {
+        QSharedPointer<ThermalScan> region = QSharedPointer<ThermalScan>::create(*this);
+        region->detachPaths();
+        return region;
+    }
+
     QString ThermalScan::writeGCode(QSharedPointer<WriterBase> writer) {
         QString gcode;
         gcode += writer->writeBeforeRegion(RegionType::kThermalScan);
@@ -4,7 +4,7 @@
 #include "step/step.h"
 
 namespace ORNL {
-    Step::Step(const QSharedPointer<SettingsBase>& sb) : m_sb(sb), m_dirty_bit(true) {
+    Step::Step(const QSharedPointer<SettingsBase>& sb) : m_sb(sb), m_dirty_bit(true), m_frame_pending(false) {
         // NOP
     }
 
@@ -61,11 +61,13 @@ namespace ORNL {
     }
 
     void Step::addIsland(IslandType type, QSharedPointer<IslandBase> island) {
+        applyFrame();
         m_islands.insert(static_cast<int>(type), island);
     }
 
     void Step::updateIslands(IslandType type, QVector<QSharedPointer<IslandBase> > islands)
     {
+        applyFrame();
         m_islands.remove(static_cast<int>(type));
         for(QSharedPointer<IslandBase> isl : islands)
             m_islands.insert(static_cast<int>(type), isl);
@@ -101,6 +103,7 @@ namespace ORNL {
     }
 
     QList<QSharedPointer<IslandBase>> Step::getIslands(IslandType type) {
+        applyFrame();
 
         if(type == IslandType::kAll)
             return m_islands.values();
@@ -118,4 +121,29 @@ namespace ORNL {
     {
         return m_raft_shift;
     }
+
+    void Step::composeFrame(const QQuaternion& rotation, const Point& shift)
+    {
+        // rotating and shifting after the current frame is the same as one rotation and shift:
+        // R2 (R1 p + t1) + t2 = (R2 R1) p + (R2 t1 + t2)
+        m_frame_shift = Point(rotation.rotatedVector(m_frame_shift.toQVector3D())) + shift;
+        m_frame_rotation = rotation * m_frame_rotation;
+        m_frame_pending = true;
+    }
+
+    void Step::applyFrame()
+    {
+        if (!m_frame_pending)
+            return;
+
+        // clear first, island transforms may read islands back through this step
+        QQuaternion rotation = m_frame_rotation;
+        Point shift = m_frame_shift;
+        m_frame_rotation = QQuaternion();
+        m_frame_shift = Point(0, 0, 0);
+        m_frame_pending = false;
+
+        for (QSharedPointer<IslandBase> island : m_islands)
+            island->transform(rotation, shift);
+    }
 }
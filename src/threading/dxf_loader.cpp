@@ -33,14 +33,14 @@ namespace ORNL
             //Try-catch is necessary to prevent a crash when the GCode refresh button is clicked after an erroneous modification
             try {
             //read in entire file and separate into lines
-            QString text;
             QFile inputFile(m_filename);
             if (inputFile.open(QIODevice::ReadOnly | QIODevice::Text))
             {
                 QTextStream in(&inputFile);
-                text = in.readAll();
-                m_original_lines = text.split("\n");
-                m_lines = text.toUpper().split("\n");
+                m_original_lines = in.readAll().split("\n");
+                m_lines.clear();
+                for(const QString& line : m_original_lines)
+                    m_lines.append(line.toUpper());
                 inputFile.close();
             }
             else
@@ -80,7 +80,6 @@ namespace ORNL
                 forwardInfoToMainWindow("Done.\nTotal Length: " % QString::number(total_length) % " in");
 
                 emit updateDialog(StatusUpdateStepType::kVisualization, 100);
-                emit dxfLoadedText(text, QHash<QString, QTextCharFormat>(), QList<int>(), QSet<int>());
             }
             else
             {
@@ -88,7 +87,6 @@ namespace ORNL
                 emit forwardInfoToMainWindow("Done.");
                 emit updateDialog(StatusUpdateStepType::kVisualization, 100);
                 emit dxfLoadedVisualization(QVector<QVector<QSharedPointer<SegmentBase>>>());
-                emit dxfLoadedText(text, QHash<QString, QTextCharFormat>(), QList<int>(), QSet<int>());
             }
 
             QString openingDelim = m_selected_meta.m_comment_starting_delimiter;
@@ -113,6 +111,11 @@ namespace ORNL
                     ret = QFile::rename(tempFile.fileName(), m_filename);
                 }
             }
+
+            //the text view maps the finished file
+            GcodeTextIndex textIndex;
+            textIndex.load(m_filename);
+            emit dxfLoadedText(textIndex, QList<int>());
             }
             catch (ExceptionBase& exception)
             {
@@ -206,15 +206,18 @@ namespace ORNL
         if(!m_filename.isEmpty() && (!disableVisualization || m_adjust_file)) {
             //Try-catch is necessary to prevent a crash when the GCode refresh button is clicked after an erroneous modification
             try {
-            //read in entire file and separate into lines
-            QString text;
+            //read in entire file and separate into lines, the parser works on and edits these lines
             QFile inputFile(m_filename);
             if (inputFile.open(QIODevice::ReadOnly | QIODevice::Text))
             {
                 QTextStream in(&inputFile);
-                text = in.readAll();
-                m_original_lines = text.split("\n");
-                m_lines = text.toUpper().split("\n");
+                m_original_lines.clear();
+                m_lines.clear();
+                while(!in.atEnd())
+                {
+                    m_original_lines.append(in.readLine());
+                    m_lines.append(m_original_lines.last().toUpper());
+                }
                 inputFile.close();
             }
             else
@@ -231,6 +234,12 @@ namespace ORNL
             }
 
             QString weightInfo = "No statistics calculated";
+
+            //the text view maps the finished file, colors and layer lines are gathered until then
+            GcodeTextIndex textIndex;
+            QList<int> layerStartLines;
+            int headerLines = 0;
+
             //parse header looking for syntax
             setParser(m_original_lines, m_lines);
             if(!disableVisualization)
@@ -244,8 +253,7 @@ namespace ORNL
                 QList<QList<GcodeCommand>> m_motion_commands = m_parser->parseLines(layerSkip);
                 if(m_parser->getWasModified())
                 {
-                    text = m_original_lines.join("\n");
-                    m_lines = text.toUpper().split("\n");
+                    m_lines = m_original_lines.join("\n").toUpper().split("\n");
                 }
 
                 QList<QList<Time>> layer_times = m_parser->getLayerTimes();
@@ -343,34 +351,42 @@ namespace ORNL
                 m_table_offset = 0.0f;
                 m_prev_table_offset = 0.0f;
 
-                //reserve more memory than the hash will need to guarantee no reallocation
-                QHash<QString, QTextCharFormat> fontColors;
-                fontColors.reserve(m_lines.size());
+                //line colors are kept as one palette index per line, comments map to colors through a small cache
+                QHash<QString, QColor> commentColors;
 
                 QVector<QVector<QSharedPointer<SegmentBase>>> layers;
+                QVector<QByteArray> layerKeys;
+                layerKeys.reserve(m_motion_commands.size());
 
                 int currentLayer = 0, totalLayer = m_motion_commands.size();
                 for(QList<GcodeCommand> layerCommands : m_motion_commands)
                 {
                     QVector<QSharedPointer<SegmentBase>> layer;
 
+                    //the view keeps the geometry of layers whose key matches the last load
+                    QCryptographicHash layerHash(QCryptographicHash::Sha1);
+                    addLayerStartInputs(layerHash);
+
                     for(GcodeCommand command : layerCommands)
                     {
                         QColor lineColor(PM->getVisualizationColor(VisualizationColors::kUnknown));
-                        if(fontColors.contains(command.getComment()))
-                        {
-                            lineColor = fontColors[command.getComment()].foreground().color();
-                        }
-                        else if(!command.getComment().isEmpty())
+                        if(!command.getComment().isEmpty())
                         {
-                            lineColor = determineFontColor(command.getComment());
-                            QTextCharFormat format;
-                            format.setForeground(lineColor);
-                            fontColors.insert(m_original_lines[command.getLineNumber()], format);
+                            auto cached = commentColors.constFind(command.getComment());
+                            if(cached != commentColors.constEnd())
+                                lineColor = cached.value();
+                            else
+                            {
+                                lineColor = determineFontColor(command.getComment());
+                                commentColors.insert(command.getComment(), lineColor);
+                            }
+                            textIndex.setLineColor(command.getLineNumber(), lineColor);
                         }
 
                         QVector<QSharedPointer<SegmentBase>> generated_segments;
 
+                        addCommandInputs(layerHash, command, lineColor, m_selected_meta.hasTravels);
+
                         if(m_selected_meta.hasTravels)
                             generated_segments = generateVisualSegment(command.getLineNumber() + 1, currentLayer, lineColor, command.getCommandID(), command.getParameters(), command.getExtrudersOn(), command.getExtruderOffsets(), command.getExtrudersSpeed(), true, command.getComment());
                         else
@@ -379,6 +395,7 @@ namespace ORNL
                         layer.append(generated_segments);
                     }
                     layers.push_back(layer);
+                    layerKeys.push_back(layerHash.result());
                     ++currentLayer;
 
                     emit updateDialog(StatusUpdateStepType::kVisualization, (double)currentLayer / (double)totalLayer * 100);
@@ -387,11 +404,12 @@ namespace ORNL
                 }
 
                 //emit vector for visualization
+                emit gcodeLoadedLayerKeys(layerKeys);
                 emit gcodeLoadedVisualization(layers);
-                //very likely to have allocated too much memory, free extra
-                fontColors.squeeze();
-                //send text and font colors for display, and line numbers for easy editor navigation
-                emit gcodeLoadedText(text, fontColors, m_parser->getLayerStartLines(), m_parser->getLayerSkipLines());
+                //lines skipped by visualization reduction are not colored
+                for(int line : m_parser->getLayerSkipLines())
+                    textIndex.clearLineColor(line);
+                layerStartLines = m_parser->getLayerStartLines();
             }
             else
             {
@@ -399,7 +417,6 @@ namespace ORNL
                 emit forwardInfoToMainWindow("GCode file: " % m_filename % "\n");
                 emit updateDialog(StatusUpdateStepType::kVisualization, 100);
                 emit gcodeLoadedVisualization(QVector<QVector<QSharedPointer<SegmentBase>>>());
-                emit gcodeLoadedText(text, QHash<QString, QTextCharFormat>(), QList<int>(), QSet<int>());
             }
 
             QString openingDelim = m_selected_meta.m_comment_starting_delimiter;
@@ -431,11 +448,22 @@ namespace ORNL
                     QString tempStr = tempFile.fileName();
 
                     ret = QFile::rename(tempFile.fileName(), m_filename);
+
+                    //the header block is not part of the program the parser numbered
+                    headerLines = additionalHeaderBlock.count('\n');
                 }
 
                 if(PM->getKatanaSendOutput())
                     savePartsModelObjFile();
             }
+
+            //the parsed lines are released before the file is mapped for the text view
+            m_original_lines.clear();
+            m_lines.clear();
+
+            //send text and font colors for display, and line numbers for easy editor navigation
+            textIndex.load(m_filename, headerLines);
+            emit gcodeLoadedText(textIndex, layerStartLines);
             }
             catch (ExceptionBase& exception)
             {
@@ -673,6 +701,60 @@ namespace ORNL
         return PM->getVisualizationColor(VisualizationColors::kUnknown);
     }
 
+    void GCodeLoader::addLayerStartInputs(QCryptographicHash& hash)
+    {
+        float state[9] = { m_start_pos.x(), m_start_pos.y(), m_start_pos.z(), m_table_offset, m_prev_table_offset,
+                           m_segment_width, m_x_offset, m_y_offset, m_z_offset };
+        hash.addData(reinterpret_cast<const char*>(state), sizeof(state));
+
+        QVector<QColor> colors = m_modifier_colors;
+        colors.push_back(PM->getVisualizationColor(VisualizationColors::kTravel));
+        colors.push_back(PM->getVisualizationColor(VisualizationColors::kSupport));
+        for(const QColor& color : colors)
+        {
+            QRgb rgba = color.rgba();
+            hash.addData(reinterpret_cast<const char*>(&rgba), sizeof(rgba));
+        }
+    }
+
+    void GCodeLoader::addCommandInputs(QCryptographicHash& hash, GcodeCommand& command, const QColor& color, bool is_travel)
+    {
+        int header[2] = { command.getCommandID(), is_travel };
+        hash.addData(reinterpret_cast<const char*>(header), sizeof(header));
+
+        QRgb rgba = color.rgba();
+        hash.addData(reinterpret_cast<const char*>(&rgba), sizeof(rgba));
+
+        //optional parameters are only used when travels are not drawn
+        QList<const QMap<char, double>*> parameterSets = { &command.getParameters() };
+        if(!is_travel)
+            parameterSets.push_back(&command.getOptionalParameters());
+
+        for(const QMap<char, double>* parameters : parameterSets)
+        {
+            hash.addData(QByteArray::number(parameters->size()));
+            for(auto parameter = parameters->constBegin(); parameter != parameters->constEnd(); ++parameter)
+            {
+                hash.addData(&parameter.key(), sizeof(char));
+                hash.addData(reinterpret_cast<const char*>(&parameter.value()), sizeof(double));
+            }
+        }
+
+        QVector<bool> extrudersOn = command.getExtrudersOn();
+        QVector<Point>& extruderOffsets = command.getExtruderOffsets();
+        for(int i = 0, end = extrudersOn.size(); i < end; ++i)
+        {
+            float extruder[4] = { float(extrudersOn[i]), 0.0f, 0.0f, 0.0f };
+            if(i < extruderOffsets.size())
+            {
+                extruder[1] = extruderOffsets[i].x();
+                extruder[2] = extruderOffsets[i].y();
+                extruder[3] = extruderOffsets[i].z();
+            }
+            hash.addData(reinterpret_cast<const char*>(extruder), sizeof(extruder));
+        }
+    }
+
     QVector<QSharedPointer<SegmentBase> > GCodeLoader::generateVisualSegment(int line_num, int layer_num, const QColor& color, int command_id,
                                             const QMap<char, double>& parameters, QVector<bool> extruders_on, QVector<Point> extruder_offsets,
                                             double extruders_speed, bool is_travel, QString comment, const QMap<char, double>& optional_parameters)
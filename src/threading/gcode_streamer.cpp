@@ -0,0 +1,467 @@
+#include "threading/gcode_streamer.h"
+
+namespace ORNL
+{
+    //! \brief number of sent lines kept for resend requests, must exceed the largest window
+    static constexpr int kHistorySize = 4096;
+
+    //! \brief how long to wait for the printer to announce itself before sending anyway
+    static constexpr int kReadyGracePeriodMs = 2000;
+
+    //! \brief interval between statistics reports
+    static constexpr int kStatisticsIntervalMs = 500;
+
+    GCodeStreamer::GCodeStreamer() : QObject(), m_history(kHistorySize), m_statistics_timer(new QTimer(this))
+    {
+        m_statistics_timer->setInterval(kStatisticsIntervalMs);
+        connect(m_statistics_timer, &QTimer::timeout, this, &GCodeStreamer::reportStatistics);
+
+        this->moveToThread(&m_internal_thread);
+        m_internal_thread.start();
+    }
+
+    GCodeStreamer::~GCodeStreamer()
+    {
+        m_internal_thread.quit();
+        m_internal_thread.wait();
+    }
+
+    void GCodeStreamer::openConnection(const QString& url)
+    {
+        closeConnection();
+
+        m_transport = PrinterTransport::Create(QUrl(url), this);
+        if (m_transport == nullptr)
+        {
+            emit error(QString("Unrecognized printer address: %1").arg(url));
+            return;
+        }
+
+        const int generation = ++m_connection_generation;
+
+        connect(m_transport, &PrinterTransport::opened, this, [this, generation]()
+        {
+            // printers on USB serial reset when the port opens and print a banner once booted; wait for it,
+            // but do not wait forever for firmware that says nothing
+            QTimer::singleShot(kReadyGracePeriodMs, this, [this, generation]()
+            {
+                if (generation == m_connection_generation && !m_ready)
+                    onReady();
+            });
+        });
+        connect(m_transport, &PrinterTransport::lineReceived, this, &GCodeStreamer::onLine);
+        connect(m_transport, &PrinterTransport::error, this, &GCodeStreamer::error);
+        connect(m_transport, &PrinterTransport::closed, this, [this, generation]()
+        {
+            if (generation == m_connection_generation)
+                closeConnection();
+        });
+
+        m_transport->open();
+    }
+
+    void GCodeStreamer::closeConnection()
+    {
+        ++m_connection_generation;
+
+        if (m_streaming)
+            endStream();
+
+        if (m_transport != nullptr)
+        {
+            m_transport->disconnect(this);
+            m_transport->close();
+            m_transport->deleteLater();
+            m_transport = nullptr;
+        }
+
+        m_immediate.clear();
+        m_in_flight.clear();
+        m_skip_oks = 0;
+        m_last_resend = -1;
+        m_planner_free = -1;
+        m_planner_capacity = -1;
+        m_statistics_timer->stop();
+
+        if (m_ready)
+        {
+            m_ready = false;
+            emit connectionChanged(false);
+        }
+    }
+
+    void GCodeStreamer::setWindow(int queue_lines, int rx_bytes)
+    {
+        m_queue_lines = qMax(1, queue_lines);
+        m_rx_bytes = qMax(0, rx_bytes);
+        fill();
+    }
+
+    void GCodeStreamer::streamFile(const QString& path)
+    {
+        if (!m_ready)
+        {
+            emit error("Cannot start streaming: printer is not connected");
+            return;
+        }
+
+        if (m_streaming)
+        {
+            emit error("A file is already being streamed");
+            return;
+        }
+
+        m_file.setFileName(path);
+        if (!m_file.open(QIODevice::ReadOnly))
+        {
+            emit error(QString("Could not open %1: %2").arg(path, m_file.errorString()));
+            return;
+        }
+
+        m_streaming = true;
+        m_paused = false;
+        m_file_lines = 0;
+        m_starved_count = 0;
+        m_stream_timer.start();
+        emit streamingChanged(true);
+
+        fill();
+        checkFinished();
+    }
+
+    void GCodeStreamer::pause()
+    {
+        m_paused = true;
+    }
+
+    void GCodeStreamer::resume()
+    {
+        m_paused = false;
+        fill();
+    }
+
+    void GCodeStreamer::abort()
+    {
+        if (!m_streaming)
+            return;
+
+        // lines that were numbered but never sent can simply be forgotten
+        m_next_line = m_send_cursor;
+        endStream();
+    }
+
+    void GCodeStreamer::sendCommand(const QString& command)
+    {
+        QByteArray cleaned = clean(command.toLatin1());
+        if (cleaned.isEmpty())
+            return;
+
+        m_immediate.enqueue(cleaned);
+        fill();
+    }
+
+    void GCodeStreamer::emergencyStop()
+    {
+        if (m_transport == nullptr)
+            return;
+
+        // firmware emergency parsers act on M112 as soon as it arrives, regardless of line numbering
+        m_transport->write("M112\n");
+
+        m_immediate.clear();
+        m_in_flight.clear();
+        m_next_line = m_send_cursor;
+        if (m_streaming)
+            endStream();
+    }
+
+    void GCodeStreamer::onReady()
+    {
+        m_ready = true;
+
+        // restart numbering so the stream is independent of whatever the firmware last saw
+        m_history.fill(QByteArray());
+        m_next_line = 0;
+        m_send_cursor = 0;
+        m_in_flight.clear();
+        m_skip_oks = 0;
+        m_last_resend = -1;
+        assign("M110 N0");
+
+        m_acknowledged = 0;
+        m_acknowledged_at_report = 0;
+        m_lines_per_second = 0.0;
+        m_statistics_clock.start();
+        m_statistics_timer->start();
+
+        emit connectionChanged(true);
+        fill();
+    }
+
+    void GCodeStreamer::onLine(const QByteArray& line)
+    {
+        if (!m_ready)
+        {
+            // anything from the printer means it has booted
+            emit response(QString::fromLatin1(line));
+            onReady();
+            return;
+        }
+
+        if (line.startsWith("ok"))
+        {
+            onOk(line);
+            return;
+        }
+
+        if (line.startsWith("Resend:") || line.startsWith("rs "))
+        {
+            QByteArray number = line.mid(line.indexOf(line.startsWith("rs ") ? ' ' : ':') + 1).trimmed();
+            if (number.startsWith('N'))
+                number.remove(0, 1);
+
+            bool ok = false;
+            qint64 line_number = number.toLongLong(&ok);
+            if (ok)
+                onResend(line_number);
+            else
+                emit error(QString("Malformed resend request: %1").arg(QString::fromLatin1(line)));
+            return;
+        }
+
+        // a banner in the middle of a stream means the controller reset and has lost everything in flight
+        if (line.startsWith("start") && m_streaming)
+        {
+            emit error("Printer reset during streaming, stream aborted");
+            m_next_line = m_send_cursor;
+            endStream();
+        }
+
+        emit response(QString::fromLatin1(line));
+    }
+
+    void GCodeStreamer::onOk(const QByteArray& line)
+    {
+        bool forward = false;
+
+        // advanced ok: "ok N<line> P<planner blocks free> B<command slots free>", possibly followed by other data
+        const QList<QByteArray> tokens = line.split(' ');
+        for (int i = 1, count = tokens.size(); i < count; ++i)
+        {
+            const QByteArray& token = tokens[i];
+            if (token.isEmpty())
+                continue;
+
+            bool ok = false;
+            if (token[0] == 'P')
+            {
+                int planner_free = token.mid(1).toInt(&ok);
+                if (ok)
+                {
+                    m_planner_free = planner_free;
+                    m_planner_capacity = qMax(m_planner_capacity, planner_free);
+                    continue;
+                }
+            }
+            else if (token[0] == 'N' || token[0] == 'B')
+            {
+                token.mid(1).toLongLong(&ok);
+                if (ok)
+                    continue;
+            }
+
+            forward = true;
+        }
+
+        if (forward)
+            emit response(QString::fromLatin1(line));
+
+        if (m_skip_oks > 0)
+        {
+            --m_skip_oks;
+        }
+        else if (!m_in_flight.empty())
+        {
+            m_in_flight.pop_front();
+            ++m_acknowledged;
+        }
+
+        // an empty planner with lines still waiting means the host fell behind the machine
+        if (m_streaming && !m_paused && m_planner_capacity > 0 && m_planner_free == m_planner_capacity && !m_file.atEnd())
+            ++m_starved_count;
+
+        fill();
+        checkFinished();
+    }
+
+    void GCodeStreamer::onResend(qint64 line_number)
+    {
+        // the firmware follows every resend request with an ok of its own
+        ++m_skip_oks;
+
+        // lines sent before the rewind may each be rejected with another request for the same line. Until the
+        // line has gone out again such a request asks for nothing new. Once it has, the request may just as well
+        // be a rejection of the resent copy, and firmware that drops its receive buffer sends nothing else, so
+        // rewind again; a copy the firmware already accepted is answered with a request for a later line.
+        if (line_number == m_last_resend && m_send_cursor <= line_number)
+            return;
+
+        // the line after the last one sent is asked for when a duplicate copy was rejected
+        if (line_number > m_send_cursor || line_number < qMax<qint64>(0, m_next_line - kHistorySize))
+        {
+            emit error(QString("Printer requested resend of line %1, which is not available").arg(line_number));
+            m_next_line = m_send_cursor;
+            endStream();
+            return;
+        }
+
+        while (!m_in_flight.empty() && m_in_flight.back().number >= line_number)
+            m_in_flight.pop_back();
+
+        m_send_cursor = line_number;
+        m_last_resend = line_number;
+        fill();
+    }
+
+    void GCodeStreamer::fill()
+    {
+        if (m_transport == nullptr || !m_ready)
+            return;
+
+        // collect everything that fits into one write to keep per-line overhead off the hot path
+        QByteArray batch;
+        while (true)
+        {
+            if (m_send_cursor == m_next_line)
+            {
+                QByteArray command = nextCommand();
+                if (command.isEmpty())
+                    break;
+                assign(command);
+            }
+
+            const QByteArray& framed = m_history[int(m_send_cursor % kHistorySize)];
+            if (!windowAllows(framed.size()))
+                break;
+
+            batch.append(framed);
+            m_in_flight.push_back(InFlightLine{m_send_cursor, framed.size()});
+            ++m_send_cursor;
+        }
+
+        if (!batch.isEmpty())
+            m_transport->write(batch);
+    }
+
+    bool GCodeStreamer::windowAllows(int bytes) const
+    {
+        if (int(m_in_flight.size()) < m_queue_lines)
+            return true;
+
+        if (m_rx_bytes == 0)
+            return false;
+
+        // the oldest lines sit in the command queue, the rest wait in the receive buffer
+        int buffered_bytes = bytes;
+        for (auto it = m_in_flight.begin() + m_queue_lines; it != m_in_flight.end(); ++it)
+            buffered_bytes += it->bytes;
+
+        return buffered_bytes <= m_rx_bytes;
+    }
+
+    QByteArray GCodeStreamer::nextCommand()
+    {
+        if (!m_immediate.isEmpty())
+            return m_immediate.dequeue();
+
+        if (!m_streaming || m_paused)
+            return QByteArray();
+
+        while (!m_file.atEnd())
+        {
+            QByteArray command = clean(m_file.readLine());
+            if (!command.isEmpty())
+            {
+                ++m_file_lines;
+                return command;
+            }
+        }
+
+        return QByteArray();
+    }
+
+    void GCodeStreamer::assign(const QByteArray& command)
+    {
+        QByteArray framed;
+        framed.reserve(command.size() + 16);
+        framed.append('N');
+        framed.append(QByteArray::number(m_next_line));
+        framed.append(' ');
+        framed.append(command);
+
+        // RepRap checksum: XOR of every byte before the '*'
+        unsigned char checksum = 0;
+        for (char c : framed)
+            checksum ^= static_cast<unsigned char>(c);
+
+        framed.append('*');
+        framed.append(QByteArray::number(checksum));
+        framed.append('\n');
+
+        m_history[int(m_next_line % kHistorySize)] = framed;
+        ++m_next_line;
+    }
+
+    void GCodeStreamer::checkFinished()
+    {
+        if (!m_streaming || !m_file.atEnd() || !m_immediate.isEmpty() || m_send_cursor != m_next_line || !m_in_flight.empty())
+            return;
+
+        qint64 lines = m_file_lines;
+        double seconds = m_stream_timer.elapsed() / 1000.0;
+        endStream();
+        emit finished(lines, seconds);
+    }
+
+    void GCodeStreamer::endStream()
+    {
+        m_file.close();
+        m_streaming = false;
+        m_paused = false;
+        emit streamingChanged(false);
+        reportStatistics();
+    }
+
+    void GCodeStreamer::reportStatistics()
+    {
+        double seconds = m_statistics_clock.restart() / 1000.0;
+        if (seconds > 0.0)
+        {
+            double current_rate = (m_acknowledged - m_acknowledged_at_report) / seconds;
+            m_lines_per_second = 0.5 * m_lines_per_second + 0.5 * current_rate;
+        }
+        m_acknowledged_at_report = m_acknowledged;
+
+        double occupancy = -1.0;
+        if (m_planner_capacity > 0 && m_planner_free >= 0)
+            occupancy = 1.0 - double(m_planner_free) / m_planner_capacity;
+
+        double progress = 0.0;
+        if (m_file.isOpen() && m_file.size() > 0)
+            progress = double(m_file.pos()) / m_file.size();
+
+        emit statistics(m_lines_per_second, occupancy, int(m_in_flight.size()), progress, m_starved_count);
+    }
+
+    QByteArray GCodeStreamer::clean(const QByteArray& line)
+    {
+        int end = line.indexOf(';');
+        QByteArray cleaned = (end < 0 ? line : line.left(end)).trimmed();
+
+        // whole-line parenthesized comments are used by some syntaxes
+        if (cleaned.startsWith('('))
+            return QByteArray();
+
+        return cleaned;
+    }
+}
@@ -1,6 +1,10 @@
 // Header
 #include "threading/session_loader.h"
 
+// Qt
+#include <QCryptographicHash>
+#include <QSet>
+
 // Local
 #include "managers/session_manager.h"
 #include "managers/settings/settings_manager.h"
@@ -9,6 +13,15 @@
 #include "utilities/constants.h"
 
 namespace ORNL {
+    namespace
+    {
+        //! \brief Wraps model data without copying it
+        QByteArray modelBytes(const SessionManager::model_data& model)
+        {
+            return QByteArray::fromRawData(static_cast<const char*>(model.model), int(model.size));
+        }
+    }
+
     SessionLoader::SessionLoader(QString filename, bool save) : m_filename(filename), m_save(save) {
         // NOP
     }
@@ -20,9 +33,6 @@ namespace ORNL {
 
     void SessionLoader::saveSession()
     {
-        struct zip_t* zip = zip_open(m_filename.toUtf8(), ZIP_DEFAULT_COMPRESSION_LEVEL, 'w');
-        if (zip == nullptr) return;
-
         QMap<QString, QSharedPointer<Part>> meshes;
         auto parts = CSM->parts();
         for(auto& part : parts)
@@ -33,31 +43,134 @@ namespace ORNL {
                 meshes.insert(submesh->name(), part);
         }
 
-        // Save models
+        // Collect the models of active meshes
+        QVector<QString> model_names;
+        QVector<QByteArray> contents;
         for (auto it = CSM->models().begin(); it != CSM->models().end(); it++)
         {
-            QString file_name = it.key();
-            QFileInfo file_info(file_name);
+            QFileInfo file_info(it.key());
             if(meshes.contains(file_info.baseName())) // If this mesh was in the list of active meshes
             {
-                // To and back from QString in a single line. What an adventure.
-                std::string filename = it.key().split("/").back().toStdString();
-
-                zip_entry_open(zip, (Constants::Settings::Session::Files::kModel + "/" + filename).c_str());
-                int success = zip_entry_write(zip, it.value().model, it.value().size);
-                zip_entry_close(zip);
+                model_names.append(it.key().split("/").back());
+                contents.append(modelBytes(it.value()));
+            }
+        }
 
-                if (success < 0 )
+        // G-code that is still current for these inputs is kept with them
+        QByteArray toolpath_inputs;
+        QByteArray toolpath = CSM->currentToolpath(toolpath_inputs);
+        if (!toolpath.isEmpty())
+            contents.append(toolpath);
+
+        // Models and g-code are stored once under the hash of their contents
+        QVector<QByteArray> hashes(contents.size());
+        QByteArray* hash_data = hashes.data();
+        const QByteArray* content_data = contents.constData();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < contents.size(); ++i)
+            hash_data[i] = QCryptographicHash::hash(content_data[i], QCryptographicHash::Sha1).toHex();
+
+        fifojson manifest = fifojson::object();
+        for (int i = 0; i < model_names.size(); ++i)
+            manifest[model_names[i].toStdString()] = hashes[i].toStdString();
+
+        QSet<QByteArray> referenced;
+        for (const QByteArray& hash : hashes)
+            referenced.insert(hash);
+
+        // Blobs already in the file are kept as they are, everything else is rewritten
+        QSet<QByteArray> stored;
+        std::vector<std::string> stale;
+        if (QFileInfo::exists(m_filename))
+        {
+            struct zip_t* old_zip = zip_open(m_filename.toUtf8(), 0, 'r');
+            if (old_zip != nullptr)
+            {
+                const std::string blob_dir = Constants::Settings::Session::Files::kBlob + "/";
+                for (int i = 0, end = zip_entries_total(old_zip); i < end; ++i)
                 {
-                    zip_close(zip);
-                    return;
+                    zip_entry_openbyindex(old_zip, i);
+                    std::string name = zip_entry_name(old_zip);
+                    zip_entry_close(old_zip);
+
+                    QByteArray hash = QByteArray::fromStdString(name.substr(std::min(name.size(), blob_dir.size())));
+                    if (name.compare(0, blob_dir.size(), blob_dir) == 0 && referenced.contains(hash))
+                        stored.insert(hash);
+                    else
+                        stale.push_back(name);
                 }
+                zip_close(old_zip);
+            }
+        }
+
+        bool incremental = !stored.isEmpty();
+        if (incremental && !stale.empty())
+        {
+            struct zip_t* old_zip = zip_open(m_filename.toUtf8(), 0, 'd');
+            if (old_zip == nullptr) return;
+
+            std::vector<char*> entries;
+            for (std::string& name : stale)
+                entries.push_back(&name[0]);
+            zip_entries_delete(old_zip, entries.data(), entries.size());
+            zip_close(old_zip);
+        }
+
+        // Compress new blobs in parallel. The archive stores them as they are.
+        QVector<int> changed;
+        for (int i = 0; i < contents.size(); ++i)
+        {
+            if (!stored.contains(hashes[i]))
+            {
+                stored.insert(hashes[i]);
+                changed.append(i);
+            }
+        }
+
+        QVector<QByteArray> compressed(changed.size());
+        QByteArray* compressed_data = compressed.data();
+        const int* changed_data = changed.constData();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < changed.size(); ++i)
+            compressed_data[i] = qCompress(content_data[changed_data[i]]);
+
+        struct zip_t* zip = zip_open(m_filename.toUtf8(), 0, incremental ? 'a' : 'w');
+        if (zip == nullptr) return;
+
+        // Save models
+        for (int i = 0; i < changed.size(); ++i)
+        {
+            std::string entry = Constants::Settings::Session::Files::kBlob + "/" + hashes[changed[i]].toStdString();
+
+            zip_entry_open(zip, entry.c_str());
+            int success = zip_entry_write(zip, compressed[i].constData(), compressed[i].size());
+            zip_entry_close(zip);
+
+            if (success < 0 )
+            {
+                zip_close(zip);
+                return;
             }
         }
 
         struct session_file { std::string file;  fifojson json; };
         QVector<session_file> jsons;
 
+        // Add model manifest
+        jsons.append({Constants::Settings::Session::Files::kModels, manifest});
+
+        // Add g-code and the hash of the inputs it was sliced from
+        if (!toolpath.isEmpty())
+        {
+            fifojson toolpath_json;
+            toolpath_json[Constants::Settings::Session::ToolpathFile::kVersion] = kToolpathVersion;
+            toolpath_json[Constants::Settings::Session::ToolpathFile::kInputs] = toolpath_inputs.toStdString();
+            toolpath_json[Constants::Settings::Session::ToolpathFile::kBlob] = hashes.last().toStdString();
+            jsons.append({Constants::Settings::Session::Files::kToolpath, toolpath_json});
+        }
+
         // Add part transforms
         jsons.append({Constants::Settings::Session::Files::kSession, CSM->partsJson()}); // TODO: this need updated to reflect parent/ child relationships
 
@@ -80,7 +193,7 @@ namespace ORNL {
         for (session_file curr_json : jsons) {
             zip_entry_open(zip, curr_json.file.c_str());
 
-            std::string dump = curr_json.json.dump(4);
+            std::string dump = curr_json.json.dump();
             zip_entry_write(zip, dump.c_str(), dump.length());
 
             zip_entry_close(zip);
@@ -111,7 +224,7 @@ namespace ORNL {
             char* entries[] = { &entry[0]};
             zip_entries_delete(zip, entries, 1);
 
-            std::string dump = m_new_json.dump(4);
+            std::string dump = m_new_json.dump();
             zip_entry_open(zip, Constants::Settings::Session::Files::kGlobal.c_str());
             zip_entry_write(zip, dump.c_str(), dump.length());
             zip_entry_close(zip);
@@ -123,7 +236,24 @@ namespace ORNL {
 
         if (zip == nullptr) return;
 
-        // Load every model in the project file.
+        // Load every model in the project file. Older sessions hold models directly, newer ones
+        // hold compressed blobs named by their hash and a manifest of which file uses which blob.
+        struct blob { QString hash; void* data; size_t size; };
+        QVector<blob> blobs;
+
+        const QString model_dir = QString::fromStdString(Constants::Settings::Session::Files::kModel) + "/";
+        const QString blob_dir = QString::fromStdString(Constants::Settings::Session::Files::kBlob) + "/";
+
+        // Stored g-code stays compressed until a slice of the same inputs asks for it
+        auto toolpath_json = json::parse(loadStringFromZip(zip, Constants::Settings::Session::Files::kToolpath));
+        QString toolpath_blob;
+        QByteArray toolpath_inputs, toolpath;
+        if (toolpath_json.value(Constants::Settings::Session::ToolpathFile::kVersion, 0) == kToolpathVersion)
+        {
+            toolpath_blob = QString::fromStdString(toolpath_json.value(Constants::Settings::Session::ToolpathFile::kBlob, std::string()));
+            toolpath_inputs = QByteArray::fromStdString(toolpath_json.value(Constants::Settings::Session::ToolpathFile::kInputs, std::string()));
+        }
+
         int entries = zip_entries_total(zip);
         for (int i = 0; i < entries; ++i)
         {
@@ -132,7 +262,7 @@ namespace ORNL {
 
             // There is no way to iterate over just a sub dir using this library. Just compare the file name and see if it's in
             // our model dir. The number of files is small enough that this shouldn't be a problem.
-            if (!name.startsWith("model/")) {
+            if (!name.startsWith(model_dir) && !name.startsWith(blob_dir)) {
                 zip_entry_close(zip);
                 continue;
             }
@@ -144,11 +274,54 @@ namespace ORNL {
             size_t fsize;
             zip_entry_read(zip, &data, &fsize);
 
-            CSM->models()[int_name] = {data, fsize};
+            if (name.startsWith(model_dir))
+                CSM->models()[int_name] = {data, fsize};
+            else if (int_name == toolpath_blob)
+            {
+                toolpath = QByteArray(static_cast<const char*>(data), int(fsize));
+                free(data);
+            }
+            else
+                blobs.append({int_name, data, fsize});
 
             zip_entry_close(zip);
         }
 
+        CSM->setStoredToolpath(toolpath_inputs, toolpath);
+
+        // Decompress blobs in parallel
+        QVector<QByteArray> contents(blobs.size());
+        QByteArray* content_data = contents.data();
+        const blob* blob_data = blobs.constData();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < blobs.size(); ++i)
+        {
+            content_data[i] = qUncompress(static_cast<const uchar*>(blob_data[i].data), int(blob_data[i].size));
+            free(blob_data[i].data);
+        }
+
+        QHash<QString, int> blob_index;
+        for (int i = 0; i < blobs.size(); ++i)
+            blob_index.insert(blobs[i].hash, i);
+
+        auto manifest = json::parse(loadStringFromZip(zip, Constants::Settings::Session::Files::kModels));
+        for (auto it : manifest.items())
+        {
+            QString hash = QString::fromStdString(it.value().get<std::string>());
+            if (!blob_index.contains(hash) || contents[blob_index[hash]].isEmpty())
+                continue;
+
+            // The session manager owns model data and releases it with free
+            const QByteArray& content = contents[blob_index[hash]];
+            void* data = malloc(content.size());
+            if (data == nullptr)
+                continue;
+            memcpy(data, content.constData(), content.size());
+
+            CSM->models()[QString::fromStdString(it.key())] = {data, size_t(content.size())};
+        }
+
         // Load global settings
         GSM->loadGlobalJson(fifojson::parse(loadStringFromZip(zip, Constants::Settings::Session::Files::kGlobal)));
 
@@ -173,14 +346,16 @@ namespace ORNL {
     std::string SessionLoader::loadStringFromZip(struct zip_t* zip, const std::string& key)
     {
         void* buf = nullptr;
-        size_t bufsize;
+        size_t bufsize = 0;
 
-        zip_entry_open(zip, key.c_str());
+        // Entries missing from older sessions read as empty, the caller still owns the zip
+        if (zip_entry_open(zip, key.c_str()) < 0)
+            return "{}";
         zip_entry_read(zip, &buf, &bufsize);
         zip_entry_close(zip);
         if (bufsize <= 0)
         {
-            zip_close(zip);
+            free(buf);
             return "{}";
         }
 
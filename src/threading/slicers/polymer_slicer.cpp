@@ -18,6 +18,8 @@
 #include "step/layer/regions/skin.h"
 #include "step/layer/regions/perimeter.h"
 #include "utilities/mathutils.h"
+#include "geometry/segment_grid.h"
+#include "external_files/exporters/toolpath_exporter.h"
 #include "optimizers/multi_nozzle_optimizer.h"
 #include "slicing/layer_additions.h"
 #include "optimizers/layer_order_optimizer.h"
@@ -26,13 +28,144 @@
 
 namespace ORNL {
 
+    namespace
+    {
+        //! \brief Where each nozzle is and which island it starts from, index is the nozzle
+        struct ConnectionState
+        {
+            QVector<Point> points;
+            QVector<int> start_indices;
+        };
+
+        //! \brief A layer connected ahead of time from a predicted state
+        struct LayerConnection
+        {
+            bool connected = false;
+            ConnectionState entry;
+            ConnectionState exit;
+
+            //! \brief regions the layer appended to the previous regions of each nozzle
+            QVector<QVector<QSharedPointer<RegionBase>>> visited_regions;
+        };
+
+        //! \brief Whether two states give the same pathing, points have to match exactly
+        bool identical(const ConnectionState& lhs, const ConnectionState& rhs)
+        {
+            if (lhs.start_indices != rhs.start_indices || lhs.points.size() != rhs.points.size())
+                return false;
+
+            for (int i = 0, end = lhs.points.size(); i < end; ++i)
+            {
+                Point a = lhs.points[i];
+                Point b = rhs.points[i];
+                if (a.x() != b.x() || a.y() != b.y() || a.z() != b.z() ||
+                    a.getNormals() != b.getNormals() || a.getSettings() != b.getSettings())
+                    return false;
+            }
+            return true;
+        }
+
+        //! \brief Connects a layer from the given state and records where it ends
+        void connectFrom(const QSharedPointer<GlobalLayer>& layer, const QSharedPointer<SettingsBase>& global_sb,
+                         const ConnectionState& entry, LayerConnection& connection)
+        {
+            connection.entry = entry;
+            connection.exit = entry;
+            connection.visited_regions = QVector<QVector<QSharedPointer<RegionBase>>>(entry.points.size());
+
+            layer->connectPaths(global_sb, connection.exit.points, connection.exit.start_indices, connection.visited_regions);
+            layer->calculateModifiers(global_sb, connection.exit.points);
+            connection.connected = true;
+        }
+
+        //! \brief Connects every layer that allows it in parallel. Each layer first starts from a guess, which is the
+        //!        actual start for the first layer and the custom island location or the origin for the others. Layers
+        //!        are then connected again from where the layer below ended from its guess, unless that was the guess.
+        //! \note Every layer is left unoriented and adjusted for fixed nozzles, whether it was connected or not.
+        void connectAhead(const QList<QSharedPointer<GlobalLayer>>& layers, const QSharedPointer<SettingsBase>& global_sb,
+                          const ConnectionState& start, bool fixed_multi_nozzle, QVector<LayerConnection>& connections)
+        {
+            ConnectionState guess = start;
+            if (static_cast<IslandOrderOptimization>(global_sb->setting<int>(Constants::ProfileSettings::Optimizations::kIslandOrder)) == IslandOrderOptimization::kCustomPoint)
+            {
+                Point seam(global_sb->setting<double>(Constants::ProfileSettings::Optimizations::kCustomIslandXLocation),
+                           global_sb->setting<double>(Constants::ProfileSettings::Optimizations::kCustomIslandYLocation));
+                guess.points.fill(seam);
+            }
+
+            const int layer_count = layers.size();
+            const QVector<QSharedPointer<GlobalLayer>> layer_list = layers.toVector();
+            const QSharedPointer<GlobalLayer>* layer_data = layer_list.constData();
+            LayerConnection* connection_data = connections.data();
+
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < layer_count; ++i)
+            {
+                const QSharedPointer<GlobalLayer>& layer = layer_data[i];
+                layer->unorient();
+
+                if (fixed_multi_nozzle)
+                    layer->adjustFixedMultiNozzle();
+
+                if (layer->canReconnectPaths(global_sb))
+                    connectFrom(layer, global_sb, i == 0 ? start : guess, connection_data[i]);
+            }
+
+            QVector<ConnectionState> predictions(layer_count);
+            QVector<bool> retry(layer_count, false);
+            for (int i = 1; i < layer_count; ++i)
+            {
+                if (connections[i].connected && connections[i - 1].connected && !identical(connections[i - 1].exit, connections[i].entry))
+                {
+                    predictions[i] = connections[i - 1].exit;
+                    retry[i] = true;
+                }
+            }
+            const ConnectionState* prediction_data = predictions.constData();
+            const bool* retry_data = retry.constData();
+
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 1; i < layer_count; ++i)
+            {
+                if (!retry_data[i])
+                    continue;
+
+                layer_data[i]->resetPaths();
+                connectFrom(layer_data[i], global_sb, prediction_data[i], connection_data[i]);
+            }
+        }
+
+        //! \brief Moves the travels that enter a layer connected ahead of time to where the nozzles actually are
+        //! \return false if the layer started from other islands, or a nozzle did not enter it with a travel
+        bool redirectEntry(const QSharedPointer<GlobalLayer>& layer, LayerConnection& connection, const ConnectionState& actual)
+        {
+            if (connection.entry.start_indices != actual.start_indices || connection.entry.points.size() != actual.points.size())
+                return false;
+
+            for (int tool = 0, end = actual.points.size(); tool < end; ++tool)
+            {
+                if (connection.entry.points[tool] == actual.points[tool])
+                    continue;
+
+                // a nozzle with nothing to print on the layer stays where it was
+                if (layer->getIslandOrder().value(tool).isEmpty())
+                    connection.exit.points[tool] = actual.points[tool];
+                else if (!layer->moveFirstTravel(tool, connection.entry.points[tool], actual.points[tool]))
+                    return false;
+            }
+
+            connection.entry = actual;
+            return true;
+        }
+    }
+
     PolymerSlicer::PolymerSlicer(QString gcodeLocation) : TraditionalAST(gcodeLocation) {}
 
     void PolymerSlicer::preProcess(nlohmann::json opt_data)
     {
         Preprocessor pp;
 
-        pp.addInitialProcessing([this](const Preprocessor::Parts& parts,  const QSharedPointer<SettingsBase>& global_settings){
+        pp.addInitialProcessing([this, &pp](const Preprocessor::Parts& parts,  const QSharedPointer<SettingsBase>& global_settings){
             // Alter settings
             global_settings->makeGlobalAdjustments();
 
@@ -43,6 +176,13 @@ namespace ORNL {
             if(global_settings->setting<bool>(Constants::ExperimentalSettings::SlicingAngle::kEnableMultiBranch))
                 SlicingUtilities::SegmentRoot(global_settings, CSM->parts());
 
+            // Only slice one of each set of identical parts
+            m_part_instances = PartInstancing::findInstances(parts, global_settings);
+            QSet<QUuid> copies;
+            for(const PartInstancing::Instance& instance : m_part_instances)
+                copies.insert(instance.copy->getId());
+            pp.skipParts(copies);
+
             return false; // No error, so continune slicing
         });
 
@@ -277,6 +417,13 @@ namespace ORNL {
         });
 
         pp.addFinalProcessing([this](const Preprocessor::Parts& parts,  const QSharedPointer<SettingsBase>& global_settings){
+            // Give copies the layers of the part they copy, so they take their place in the global layers.
+            // Done first: copies skip part processing and hold the last slice's steps until then.
+            PartInstancing::linkSteps(m_part_instances);
+
+            // Leave layers that repeat an earlier layer of their part out of the computation, linked copies are clean and skipped
+            m_layer_repeats = LayerReuse::findRepeats(parts.build_parts);
+
             // Compute and populate global layers
             processGlobalLayers(parts.build_parts, global_settings);
 
@@ -549,8 +696,10 @@ namespace ORNL {
         {
             // create global layers from all the part layers
             m_global_layers = LayerOrderOptimizer::populateSteps(settings, parts);
-            LayerOrderOptimizer::logGlobalLayers (m_global_layers);
 
+            #ifdef GLOBAL_LAYER_DEBUG_INFO
+            LayerOrderOptimizer::logGlobalLayers(m_global_layers);
+            #endif
         }
     }
 
@@ -828,39 +977,72 @@ namespace ORNL {
             QSharedPointer<SettingsBase> global_sb = QSharedPointer<SettingsBase>::create(*GSM->getGlobal());
             global_sb->makeGlobalAdjustments();
 
+            // repeated layers get their islands first, copies of a part may take them from there
+            LayerReuse::placeRepeats(m_layer_repeats);
+
+            // copies get their islands once the parts they copy are computed
+            PartInstancing::placeCopies(m_part_instances);
+
             // set up the start points, first region indicies, and previous region list for each tool
             // used by island and path order optimizer to generate travels
             // in these vectors, index 0 corresponds to tool 0, index 1 to tool 1, etc.
-            QVector<Point> current_points;
-            QVector<int> start_indices;
+            ConnectionState current;
             QVector<QVector<QSharedPointer<RegionBase>>> previous_regions_list;
 
             int num_nozzles = global_sb->setting<int>(Constants::ExperimentalSettings::MultiNozzle::kNozzleCount);
             for (int i = 0; i < num_nozzles; ++i)
             {
-                current_points.push_back(Point(0, 0, 0));
-                start_indices.push_back(-1);
+                current.points.push_back(Point(0, 0, 0));
+                current.start_indices.push_back(-1);
                 previous_regions_list.push_back(QVector<QSharedPointer<RegionBase>>());
             }
 
+            // if there are multiple nozzles that are NOT independent
+            bool fixed_multi_nozzle = num_nozzles > 1 && !global_sb->setting<bool>(Constants::ExperimentalSettings::MultiNozzle::kEnableIndependentNozzles);
+
+            PathConnectionMode connection_mode = static_cast<PathConnectionMode>(global_sb->setting<int>(Constants::ProfileSettings::Optimizations::kPathConnectionMode));
+            QVector<LayerConnection> connections(m_global_layers.size());
+            if (connection_mode != PathConnectionMode::kSequential)
+                connectAhead(m_global_layers, global_sb, current, fixed_multi_nozzle, connections);
+
             for (int g_layer_num = 0, max_layers = m_global_layers.size(); g_layer_num < max_layers; ++g_layer_num)
             {
-                m_global_layers[g_layer_num]->unorient();
+                QSharedPointer<GlobalLayer> layer = m_global_layers[g_layer_num];
+                LayerConnection& connection = connections[g_layer_num];
 
-                // if there are multiple nozzles that are NOT independent
-                if ( global_sb->setting<int>(Constants::ExperimentalSettings::MultiNozzle::kNozzleCount) > 1
-                     && !global_sb->setting<bool>(Constants::ExperimentalSettings::MultiNozzle::kEnableIndependentNozzles) )
+                // keep a layer connected ahead of time if it started where the layer below actually ended
+                bool keep = connection.connected && identical(connection.entry, current);
+                if (!keep && connection.connected && connection_mode == PathConnectionMode::kSpeculativeRelaxed)
+                    keep = redirectEntry(layer, connection, current);
+
+                if (keep)
                 {
-                     m_global_layers[g_layer_num]->adjustFixedMultiNozzle();
+                    current = connection.exit;
+                    for (int tool = 0; tool < num_nozzles; ++tool)
+                        previous_regions_list[tool] += connection.visited_regions[tool];
                 }
+                else
+                {
+                    if (connection.connected)
+                    {
+                        layer->resetPaths();
+                    }
+                    else if (connection_mode == PathConnectionMode::kSequential)
+                    {
+                        layer->unorient();
+
+                        if (fixed_multi_nozzle)
+                            layer->adjustFixedMultiNozzle();
+                    }
 
-                // current_points, start_indices, & previous_regions_list are updated during method execution
-                // so that each layer starts where the last layer ended
-                 m_global_layers[g_layer_num]->connectPaths(global_sb, current_points, start_indices, previous_regions_list);
+                    // current points, start indices, & previous_regions_list are updated during method execution
+                    // so that each layer starts where the last layer ended
+                    layer->connectPaths(global_sb, current.points, current.start_indices, previous_regions_list);
 
-                 m_global_layers[g_layer_num]->calculateModifiers(global_sb, current_points);
+                    layer->calculateModifiers(global_sb, current.points);
+                }
 
-                 m_global_layers[g_layer_num]->reorient();
+                layer->reorient();
 
                 // update status in UI
                 emit statusUpdate(StatusUpdateStepType::kPostProcess, (g_layer_num + 1) / max_layers * 100);
@@ -931,85 +1113,91 @@ namespace ORNL {
 
 
         //! Spiralize shells
-        //! \note Upper path of shell not added to spiral shell - distinct policy needed - should possibly act as tip wipe
-        for (QVector<Path>& paths : shells)
-        {
-            //! Spiralize shell
-            Path spiral_shell;
-            for (uint i = 0, max = paths.size() - 1; i < max; ++i)
-            {
-                //! Identify lower/upper paths and compute dz shift rate
-                Path &lower_path = paths[i], &upper_path = paths[i + 1];
-                float dz = qFabs(upper_path.front()->start().z() - lower_path.front()->start().z()) / lower_path.calculateLength()();
-
-                Point endpoint = lower_path.front()->start(), endpoint_target;
-                uint target_idx;
-
-                //! Spiralize lower path
-                float length_travelled {0};
-                for (QSharedPointer<SegmentBase> &lower_segment : lower_path)
-                {
-                    //! Used for segment normal computation
-                    Point midpoint = lower_segment->midpoint(), midpoint_target;
-
-                    length_travelled += lower_segment->length()();
-                    lower_segment->setStart(endpoint);
-                    endpoint = lower_segment->end();
+        //! \note Shells share no paths or segments, so each one can be processed on its own thread
+        QVector<Path> spiral_shells(shells.size());
+        QVector<Path>* shell_data = shells.data();
+        Path* spiral_data = spiral_shells.data();
 
-                    //! Find nearest endpoint target and midpoint target on upper path
-                    //! If nearest target is the endpoint of a segment, preference is given to startpoint of next segment
-                    float endpoint_target_dist {std::numeric_limits<float>::max()}, midpoint_target_dist {std::numeric_limits<float>::max()};
-                    for (QSharedPointer<SegmentBase> &upper_segment : upper_path)
-                    {
-                        Point target;
-                        float dist;
+        #pragma omp parallel for schedule(dynamic)
+        for (int shell_index = 0; shell_index < shells.size(); ++shell_index)
+            spiral_data[shell_index] = spiralizeShell(shell_data[shell_index]);
 
-                        //! Endpoint target
-                        std::tie(dist, target) = MathUtils::findClosestPointOnSegment(upper_segment->start(), upper_segment->end(), endpoint);
-                        if (dist < endpoint_target_dist && target != upper_segment->end())
-                        {
-                            endpoint_target = target;
-                            endpoint_target_dist = dist;
-                            target_idx = upper_path.getSegments().indexOf(upper_segment);
-                        }
+        m_spiral_paths += spiral_shells;
 
-                        //! Midpoint target
-                        std::tie(dist, target) = MathUtils::findClosestPointOnSegment(upper_segment->start(), upper_segment->end(), midpoint);
-                        if (dist < midpoint_target_dist && target != upper_segment->end())
-                        {
-                            midpoint_target = target;
-                            midpoint_target_dist = dist;
-                        }
-                    }
+        //! Ensure spiral paths are in order of accessibility (inner to outer)
+        Direction gen_dir = static_cast<Direction>(global_sb->setting<int>(Constants::ExperimentalSettings::DirectedPerimeter::kGenerationDirection));
+        if (gen_dir == Direction::kInward)
+            std::reverse(m_spiral_paths.begin(), m_spiral_paths.end());
+    }
 
-                    //! Shift segment end toward end_target
-                    QVector3D shift_vector = (endpoint_target - endpoint).toQVector3D();
-                    float shift_dist = (length_travelled * dz) * shift_vector.length() / (endpoint_target.z() - endpoint.z());
-                    lower_segment->setEnd(Point::round(endpoint + shift_vector.normalized() * shift_dist));
+    Path PolymerSlicer::spiralizeShell(QVector<Path>& paths)
+    {
+        //! \note Upper path of shell not added to spiral shell - distinct policy needed - should possibly act as tip wipe
+        Path spiral_shell;
+        for (uint i = 0, max = paths.size() - 1; i < max; ++i)
+        {
+            //! Identify lower/upper paths and compute dz shift rate
+            Path &lower_path = paths[i], &upper_path = paths[i + 1];
+            float dz = qFabs(upper_path.front()->start().z() - lower_path.front()->start().z()) / lower_path.calculateLength()();
+
+            //! Index upper path segments once so nearest target queries only visit nearby segments
+            QVector<Point> upper_starts, upper_ends;
+            upper_starts.reserve(upper_path.size());
+            upper_ends.reserve(upper_path.size());
+            for (QSharedPointer<SegmentBase> &upper_segment : upper_path)
+            {
+                upper_starts.push_back(upper_segment->start());
+                upper_ends.push_back(upper_segment->end());
+            }
+            SegmentGrid upper_index(upper_starts, upper_ends);
 
-                    //! Compute segment normal
-                    QVector3D fwd_tan = (lower_segment->end() - lower_segment->start()).toQVector3D();
-                    QVector3D vrt_tan = (midpoint_target - midpoint).toQVector3D();
-                    QVector3D norm = QVector3D::crossProduct(fwd_tan, vrt_tan).normalized();
-                    lower_segment->getSb()->setSetting(Constants::SegmentSettings::kTilt, QVector<QVector3D>{norm, norm});
+            //! If nearest target is the endpoint of a segment, preference is given to startpoint of next segment
+            SegmentGrid::Filter not_segment_end = [&upper_ends] (int index, const Point& target) { return target != upper_ends[index]; };
 
-                    spiral_shell.append(lower_segment);
-                    endpoint = lower_segment->end();
-                }
+            Point endpoint = lower_path.front()->start(), endpoint_target;
+            uint target_idx = 0;
 
-                //! Reorder upper path segments so that target segment is first and adjust path start/end points
-                std::rotate(upper_path.begin(), upper_path.begin() + target_idx, upper_path.end());
-                upper_path.front()->setStart(endpoint_target);
-                upper_path.back()->setEnd(endpoint_target);
+            //! Spiralize lower path
+            float length_travelled {0};
+            for (QSharedPointer<SegmentBase> &lower_segment : lower_path)
+            {
+                //! Used for segment normal computation
+                Point midpoint = lower_segment->midpoint(), midpoint_target;
+
+                length_travelled += lower_segment->length()();
+                lower_segment->setStart(endpoint);
+                endpoint = lower_segment->end();
+
+                //! Find nearest endpoint target and midpoint target on upper path
+                float dist;
+                int nearest_idx = upper_index.nearest(endpoint, endpoint_target, dist, not_segment_end);
+                if (nearest_idx >= 0)
+                    target_idx = nearest_idx;
+
+                upper_index.nearest(midpoint, midpoint_target, dist, not_segment_end);
+
+                //! Shift segment end toward end_target
+                QVector3D shift_vector = (endpoint_target - endpoint).toQVector3D();
+                float shift_dist = (length_travelled * dz) * shift_vector.length() / (endpoint_target.z() - endpoint.z());
+                lower_segment->setEnd(Point::round(endpoint + shift_vector.normalized() * shift_dist));
+
+                //! Compute segment normal
+                QVector3D fwd_tan = (lower_segment->end() - lower_segment->start()).toQVector3D();
+                QVector3D vrt_tan = (midpoint_target - midpoint).toQVector3D();
+                QVector3D norm = QVector3D::crossProduct(fwd_tan, vrt_tan).normalized();
+                lower_segment->getSb()->setSetting(Constants::SegmentSettings::kTilt, QVector<QVector3D>{norm, norm});
+
+                spiral_shell.append(lower_segment);
+                endpoint = lower_segment->end();
             }
 
-            m_spiral_paths += spiral_shell;
+            //! Reorder upper path segments so that target segment is first and adjust path start/end points
+            std::rotate(upper_path.begin(), upper_path.begin() + target_idx, upper_path.end());
+            upper_path.front()->setStart(endpoint_target);
+            upper_path.back()->setEnd(endpoint_target);
         }
 
-        //! Ensure spiral paths are in order of accessibility (inner to outer)
-        Direction gen_dir = static_cast<Direction>(global_sb->setting<int>(Constants::ExperimentalSettings::DirectedPerimeter::kGenerationDirection));
-        if (gen_dir == Direction::kInward)
-            std::reverse(m_spiral_paths.begin(), m_spiral_paths.end());
+        return spiral_shell;
     }
 
     void PolymerSlicer::exportSpiralVisFiles()
@@ -1063,6 +1251,20 @@ namespace ORNL {
         types_file.close();
         widths_file.close();
         normals_file.close();
+
+        QString toolpath_path = dir.absoluteFilePath("toolpath" + ToolpathFormat::kFileSuffix);
+        QFile::remove(toolpath_path);
+        if (GSM->getGlobal()->setting<bool>(Constants::ExperimentalSettings::FileOutput::kToolpathBinaryOutput))
+        {
+            //! Each spiral shell is written as its own layer
+            ToolpathExporter exporter(toolpath_path, GSM->getGlobal()->setting<bool>(Constants::ExperimentalSettings::FileOutput::kToolpathBinaryCompression));
+            if (exporter.open())
+            {
+                for (int shell_index = 0, end = m_spiral_paths.size(); shell_index < end; ++shell_index)
+                    exporter.appendPath(m_spiral_paths[shell_index], shell_index, 0);
+                exporter.close();
+            }
+        }
     }
 
     //！立方体没用，试过了
@@ -1093,6 +1295,10 @@ namespace ORNL {
 
     void PolymerSlicer::writeGCode()
     {
+        // binary toolpath output is written alongside the gcode from the same layers
+        QString toolpath_path = m_temp_gcode_dir.absoluteFilePath("toolpath" + ToolpathFormat::kFileSuffix);
+        QFile::remove(toolpath_path);
+
         if (!m_spiral_paths.isEmpty())
         {
             writeSpiralGCode();
@@ -1101,6 +1307,14 @@ namespace ORNL {
         {
             QTextStream stream(&m_temp_gcode_output_file);
 
+            QSharedPointer<ToolpathExporter> exporter;
+            if (GSM->getGlobal()->setting<bool>(Constants::ExperimentalSettings::FileOutput::kToolpathBinaryOutput))
+            {
+                exporter = QSharedPointer<ToolpathExporter>::create(toolpath_path, GSM->getGlobal()->setting<bool>(Constants::ExperimentalSettings::FileOutput::kToolpathBinaryCompression));
+                if (!exporter->open())
+                    exporter.reset();
+            }
+
             // for updating status window
             double current_layer = 0;
             double num_layers = m_global_layers.size();
@@ -1112,6 +1326,8 @@ namespace ORNL {
                 stream << m_base->writeBeforeLayer(g_layer->getMinZ(), GSM->getGlobal());
 
                 stream << g_layer->writeGCode(m_base);
+                if (!exporter.isNull())
+                    exporter->appendLayer(g_layer, int(current_layer));
                 g_layer->setDirtyBit(false);
                 stream << m_base->writeAfterLayer();
 
@@ -1120,6 +1336,9 @@ namespace ORNL {
             }
 
             stream << m_base->writeAfterPart();
+
+            if (!exporter.isNull())
+                exporter->close();
         }
     }
 }
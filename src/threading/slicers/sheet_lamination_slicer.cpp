@@ -266,6 +266,17 @@ namespace ORNL {
 
         SheetLaminationWriter* laminator = dynamic_cast<SheetLaminationWriter*>(m_base.get());
 
+        // find where you can pick up the islands with a robotic arm
+        // islands do not depend on each other, so they are searched in parallel
+        const int island_count = m_islands.size();
+        QVector<Point> poles(island_count);
+        PolygonList* islands = m_islands.data();
+        Point* island_poles = poles.data();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int j = 0; j < island_count; ++j)
+            island_poles[j] = islands[j].poleOfInaccessibility(arm_precision);
+
         for (int i = 0, size_i = m_layer_changes.length() - 1; i < size_i; i++)
         {
             QVector<Point> origins;
@@ -275,9 +286,7 @@ namespace ORNL {
                 // have each island write its own dxf
                 stream << laminator->writeIsland(m_islands[j], m_island_z_values[j]);
 
-                // find where you can pick up the islands with a robotic arm
-                // for this, we're going to add a function to PolygonList
-                origins.push_back(m_islands[j].poleOfInaccessibility(arm_precision));
+                origins.push_back(poles[j]);
                 destinations.push_back(origins.last() - Point(m_offsets[j][0], m_offsets[j][1], 0) + destination_offset);
                 destination_z_values.push_back((m_layer_list[j] * layer_height) + destination_offset_z);
             }
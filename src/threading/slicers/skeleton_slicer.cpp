@@ -17,58 +17,93 @@ namespace ORNL
 
         Preprocessor pp(true); // This pre-processor will use cgal cross-sectioning
 
-        pp.addStepBuilder([this](QSharedPointer<BufferedSlicer::SliceMeta> next_layer_meta, Preprocessor::ActivePartMeta& meta)
+        // Cross-sections are only collected here, paths are built for all layers at once afterwards
+        QVector<QVector<Polyline>> layer_polylines;
+        pp.addStepBuilder([&layer_polylines](QSharedPointer<BufferedSlicer::SliceMeta> next_layer_meta, Preprocessor::ActivePartMeta& meta)
         {
             auto polylines = next_layer_meta->opt_polylines;
 
             for(auto& polygon : next_layer_meta->geometry)
                 polylines.append(polygon.toPolyline());
 
-            Point last_pos(0,0,0);
+            layer_polylines.push_back(polylines);
 
-            SkeletonLayer layer;
-            for(auto& polyline : polylines)
+            return false; // No error, so continune slicing
+        });
+
+        pp.addStatusUpdate([this](double percentage)
+        {
+            emit statusUpdate(StatusUpdateStepType::kPreProcess, percentage);
+        });
+
+        pp.processAll();
+
+        buildLayers(layer_polylines);
+    }
+
+    void SkeletonSlicer::buildLayers(const QVector<QVector<Polyline>>& layer_polylines)
+    {
+        // Every segment carries the same attributes, so they are read once and shared
+        QSharedPointer<SettingsBase> attributes = QSharedPointer<SettingsBase>::create(*LineSegment(Point(0, 0, 0), Point(0, 0, 0)).getSb());
+        attributes->setSetting(Constants::SegmentSettings::kWidth,            GSM->getGlobal()->setting< Distance >(Constants::ProfileSettings::Perimeter::kBeadWidth));
+        attributes->setSetting(Constants::SegmentSettings::kHeight,           GSM->getGlobal()->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight));
+        attributes->setSetting(Constants::SegmentSettings::kSpeed,            GSM->getGlobal()->setting< Velocity >(Constants::ProfileSettings::Perimeter::kSpeed));
+        attributes->setSetting(Constants::SegmentSettings::kAccel,            GSM->getGlobal()->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kPerimeter));
+        attributes->setSetting(Constants::SegmentSettings::kExtruderSpeed,    GSM->getGlobal()->setting< AngularVelocity >(Constants::ProfileSettings::Perimeter::kExtruderSpeed));
+        attributes->setSetting(Constants::SegmentSettings::kMaterialNumber,   GSM->getGlobal()->setting< int >(Constants::MaterialSettings::MultiMaterial::kPerimterNum));
+        attributes->setSetting(Constants::SegmentSettings::kRegionType,       RegionType::kPerimeter);
+
+        // Each layer starts where the previous one ended, which only depends on the cross-sections
+        const int layer_count = layer_polylines.size();
+        QVector<Point> layer_starts(layer_count);
+        for(int i = 0; i < layer_count; ++i)
+        {
+            layer_starts[i] = m_last_pos;
+            for(const Polyline& polyline : layer_polylines[i])
+            {
+                if(!polyline.isEmpty())
+                    m_last_pos = polyline.last();
+            }
+        }
+
+        m_skeleton_layers.resize(layer_count);
+        SkeletonLayer* layers = m_skeleton_layers.data();
+        const QVector<Polyline>* polylines = layer_polylines.constData();
+        const Point* starts = layer_starts.constData();
+
+        #pragma omp parallel for schedule(dynamic)
+        for(int i = 0; i < layer_count; ++i)
+        {
+            Point last_pos = starts[i];
+
+            SkeletonLayer& layer = layers[i];
+            layer.reserve(polylines[i].size());
+            for(const Polyline& polyline : polylines[i])
             {
                 Path new_path;
 
                 bool first = true;
 
-                for(auto point : polyline)
+                for(const Point& point : polyline)
                 {
                     QSharedPointer<SegmentBase> segment;
 
                     if(first)
-                        segment = QSharedPointer<TravelSegment>::create(m_last_pos, point);
+                        segment = QSharedPointer<TravelSegment>::create(last_pos, point);
                     else
-                        segment = QSharedPointer<LineSegment>::create(m_last_pos, point);
+                        segment = QSharedPointer<LineSegment>::create(last_pos, point);
 
                     first = false;
 
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kWidth,            GSM->getGlobal()->setting< Distance >(Constants::ProfileSettings::Perimeter::kBeadWidth));
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kHeight,           GSM->getGlobal()->setting< Distance >(Constants::ProfileSettings::Layer::kLayerHeight));
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kSpeed,            GSM->getGlobal()->setting< Velocity >(Constants::ProfileSettings::Perimeter::kSpeed));
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kAccel,            GSM->getGlobal()->setting< Acceleration >(Constants::PrinterSettings::Acceleration::kPerimeter));
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kExtruderSpeed,    GSM->getGlobal()->setting< AngularVelocity >(Constants::ProfileSettings::Perimeter::kExtruderSpeed));
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kMaterialNumber,   GSM->getGlobal()->setting< int >(Constants::MaterialSettings::MultiMaterial::kPerimterNum));
-                    segment->getSb()->setSetting(Constants::SegmentSettings::kRegionType,       RegionType::kPerimeter);
+                    segment->setSb(attributes);
 
                     new_path.append(segment);
-                    m_last_pos = point;
+                    last_pos = point;
                 }
 
                 layer.push_back(new_path);
             }
-            m_skeleton_layers.push_back(layer);
-
-            return false; // No error, so continune slicing
-        });
-
-        pp.addStatusUpdate([this](double percentage)
-        {
-            emit statusUpdate(StatusUpdateStepType::kPreProcess, percentage);
-        });
-
-        pp.processAll();
+        }
     }
 
     void SkeletonSlicer::postProcess(nlohmann::json opt_data)
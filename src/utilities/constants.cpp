@@ -749,6 +749,9 @@ namespace ORNL
     const QString Constants::ProfileSettings::Optimizations::kEnableSecondCustomLocation = "enable_second_custom_point_location";
     const QString Constants::ProfileSettings::Optimizations::kCustomPointSecondXLocation = "custom_second_point_order_x_location";
     const QString Constants::ProfileSettings::Optimizations::kCustomPointSecondYLocation = "custom_second_point_order_y_location";
+    const QString Constants::ProfileSettings::Optimizations::kPathConnectionMode = "path_connection_mode";
+    const QString Constants::ProfileSettings::Optimizations::kPartInstancing = "part_instancing";
+    const QString Constants::ProfileSettings::Optimizations::kLayerReuse = "layer_reuse";
 
     //Ordering
     const QString Constants::ProfileSettings::Ordering::kRegionOrder = "region_order";
@@ -905,6 +908,8 @@ namespace ORNL
     const QString Constants::ExperimentalSettings::FileOutput::kSandiaOutput = "sandia_file_output";
     const QString Constants::ExperimentalSettings::FileOutput::kMarlinOutput = "marlin_file_output";
     const QString Constants::ExperimentalSettings::FileOutput::kMarlinTravels = "marlin_include_travels";
+    const QString Constants::ExperimentalSettings::FileOutput::kToolpathBinaryOutput = "toolpath_binary_output";
+    const QString Constants::ExperimentalSettings::FileOutput::kToolpathBinaryCompression = "toolpath_binary_compression";
 
     //Rotation Origin
     const QString Constants::ExperimentalSettings::RotationOrigin::kXOffset = "rotation_origin_offset_x";
@@ -949,6 +954,12 @@ namespace ORNL
     const std::string Constants::Settings::Session::Files::kLocal = "local.s2c";
     const std::string Constants::Settings::Session::Files::kPref = "pref.s2c";
     const std::string Constants::Settings::Session::Files::kModel = "model";
+    const std::string Constants::Settings::Session::Files::kBlob = "blob";
+    const std::string Constants::Settings::Session::Files::kModels = "models.s2c";
+    const std::string Constants::Settings::Session::Files::kToolpath = "toolpath.s2c";
+    const std::string Constants::Settings::Session::ToolpathFile::kVersion = "version";
+    const std::string Constants::Settings::Session::ToolpathFile::kInputs = "inputs";
+    const std::string Constants::Settings::Session::ToolpathFile::kBlob = "blob";
     const std::string Constants::Settings::Session::Range::kLow = "low";
     const std::string Constants::Settings::Session::Range::kHigh = "high";
     const std::string Constants::Settings::Session::Range::kName = "name";
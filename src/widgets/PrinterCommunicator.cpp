@@ -1,25 +1,117 @@
 #include "widgets/PrinterCommunicator.h"
-#include <QDebug>
+
+#include <QUrl>
+#include <QUrlQuery>
 
 namespace ORNL{
 
 PrinterCommunicator::PrinterCommunicator(QObject *parent)
-    : QObject(parent){}
+    : QObject(parent), m_streamer(new GCodeStreamer())
+{
+    connect(m_streamer, &GCodeStreamer::response, this, &PrinterCommunicator::printerResponse);
+    connect(m_streamer, &GCodeStreamer::connectionChanged, this, &PrinterCommunicator::connectionChanged);
+    connect(m_streamer, &GCodeStreamer::streamingChanged, this, &PrinterCommunicator::streamingChanged);
+    connect(m_streamer, &GCodeStreamer::statistics, this, &PrinterCommunicator::statistics);
+    connect(m_streamer, &GCodeStreamer::finished, this, &PrinterCommunicator::finished);
+    connect(m_streamer, &GCodeStreamer::error, this, &PrinterCommunicator::error);
+}
+
+PrinterCommunicator::~PrinterCommunicator()
+{
+    // release sockets on the threads that own them before the threads stop
+    QMetaObject::invokeMethod(m_streamer, "closeConnection", Qt::BlockingQueuedConnection);
+    delete m_streamer;
 
+    if (m_simulator != nullptr)
+    {
+        QMetaObject::invokeMethod(m_simulator, "stop", Qt::BlockingQueuedConnection);
+        delete m_simulator;
+    }
+}
 
 void PrinterCommunicator::sendCommand(const QString &command)
 {
-    qDebug() << "Sending command to printer:" << command;
+    QMetaObject::invokeMethod(m_streamer, "sendCommand", Qt::QueuedConnection, Q_ARG(QString, command));
+}
+
+void PrinterCommunicator::connectToPrinter(const QString &address)
+{
+    disconnectFromPrinter();
+
+    QUrl url(address.trimmed());
+    if (url.scheme().toLower() != "sim")
+    {
+        QMetaObject::invokeMethod(m_streamer, "openConnection", Qt::QueuedConnection, Q_ARG(QString, url.toString()));
+        return;
+    }
+
+    QUrlQuery query(url);
+    auto number = [&query](const QString& key, double fallback)
+    {
+        bool ok = false;
+        double value = query.queryItemValue(key).toDouble(&ok);
+        return ok ? value : fallback;
+    };
+
+    QString transport = query.hasQueryItem("transport") ? query.queryItemValue("transport") : QString("tcp");
+
+    m_simulator = new SimulatedPrinter();
+    connect(m_simulator, &SimulatedPrinter::error, this, &PrinterCommunicator::error);
+    connect(m_simulator, &SimulatedPrinter::listening, this, [this](const QString& endpoint)
+    {
+        emit printerResponse(QString("Simulated printer listening on %1").arg(endpoint));
+        QMetaObject::invokeMethod(m_streamer, "openConnection", Qt::QueuedConnection, Q_ARG(QString, endpoint));
+    });
+
+    QMetaObject::invokeMethod(m_simulator, "start", Qt::QueuedConnection,
+                              Q_ARG(QString, transport),
+                              Q_ARG(double, number("rate", 2000.0)),
+                              Q_ARG(int, int(number("planner", 16))),
+                              Q_ARG(int, int(number("queue", 4))),
+                              Q_ARG(double, number("errors", 0.0)));
+}
+
+void PrinterCommunicator::disconnectFromPrinter()
+{
+    QMetaObject::invokeMethod(m_streamer, "closeConnection", Qt::QueuedConnection);
+
+    if (m_simulator != nullptr)
+    {
+        // release the endpoint on its own thread, the destructor then stops that thread
+        QMetaObject::invokeMethod(m_simulator, "stop", Qt::BlockingQueuedConnection);
+        delete m_simulator;
+        m_simulator = nullptr;
+    }
+}
+
+void PrinterCommunicator::streamFile(const QString &path)
+{
+    QMetaObject::invokeMethod(m_streamer, "streamFile", Qt::QueuedConnection, Q_ARG(QString, path));
+}
+
+void PrinterCommunicator::pauseStream()
+{
+    QMetaObject::invokeMethod(m_streamer, "pause", Qt::QueuedConnection);
+}
+
+void PrinterCommunicator::resumeStream()
+{
+    QMetaObject::invokeMethod(m_streamer, "resume", Qt::QueuedConnection);
+}
 
-    // 调用一个模拟的函数来处理与打印机的通信
-    mockPrinterCommunication(command);
+void PrinterCommunicator::stopStream()
+{
+    QMetaObject::invokeMethod(m_streamer, "abort", Qt::QueuedConnection);
+}
+
+void PrinterCommunicator::emergencyStop()
+{
+    QMetaObject::invokeMethod(m_streamer, "emergencyStop", Qt::QueuedConnection);
 }
 
-void PrinterCommunicator::mockPrinterCommunication(const QString &command)
+void PrinterCommunicator::setWindow(int queue_lines, int rx_bytes)
 {
-    // 模拟打印机的响应，可以替换为实际的串口通信或网络通信逻辑
-    QString response = QString("Printer executed command: %1").arg(command);
-    emit printerResponse(response);
+    QMetaObject::invokeMethod(m_streamer, "setWindow", Qt::QueuedConnection, Q_ARG(int, queue_lines), Q_ARG(int, rx_bytes));
 }
 
 
@@ -1,5 +1,7 @@
 #include "widgets/PrinterControlWidget.h"
 #include <QDebug>
+#include <QFileDialog>
+#include <QRegularExpression>
 
 namespace ORNL {
 
@@ -24,6 +26,11 @@ PrinterControlWidget::PrinterControlWidget(QWidget *parent)
     m_loadButton->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
 
 
+    m_addressInput = new QLineEdit("sim://localhost?rate=2000", this);
+    m_addressInput->setPlaceholderText("tcp://host:port, serial://COM3?baud=250000, pty:///dev/pts/4 or sim://localhost?rate=2000");
+
+    m_streamStatusLabel = new QLabel("Not connected", this);
+
     m_xInput = new QLineEdit(this);
     m_xInput->setPlaceholderText("Enter X value");
 
@@ -59,6 +66,9 @@ PrinterControlWidget::PrinterControlWidget(QWidget *parent)
     connect(m_homeButton, &QPushButton::clicked, this, &PrinterControlWidget::homePrinter);
     connect(m_startPrintButton, &QPushButton::clicked, this, &PrinterControlWidget::startPrint);
     connect(m_stopPrintButton, &QPushButton::clicked, this, &PrinterControlWidget::stopPrint);
+    connect(m_enableButton, &QPushButton::clicked, this, &PrinterControlWidget::enablePrinter);
+    connect(m_disableButton, &QPushButton::clicked, this, &PrinterControlWidget::disablePrinter);
+    connect(m_loadButton, &QPushButton::clicked, this, &PrinterControlWidget::loadPath);
 
 
     // 连接定时器的timeout信号到更新温度的槽函数
@@ -67,6 +77,22 @@ PrinterControlWidget::PrinterControlWidget(QWidget *parent)
     // 连接与打印机通信的信号和槽
     connect(this, &PrinterControlWidget::sendCommandToPrinter, m_communicator, &PrinterCommunicator::sendCommand);
     connect(m_communicator, &PrinterCommunicator::printerResponse, this, &PrinterControlWidget::onPrinterResponse);
+    connect(m_communicator, &PrinterCommunicator::statistics, this, &PrinterControlWidget::onStatistics);
+    connect(m_communicator, &PrinterCommunicator::error, this, [this](const QString &msg)
+    {
+        m_logDisplay->append("Error: " + msg);
+    });
+    connect(m_communicator, &PrinterCommunicator::connectionChanged, this, [this](bool connected)
+    {
+        m_connected = connected;
+        m_streamStatusLabel->setText(connected ? "Connected" : "Not connected");
+        m_logDisplay->append(connected ? "Printer connected" : "Printer disconnected");
+    });
+    connect(m_communicator, &PrinterCommunicator::finished, this, [this](qint64 lines, double seconds)
+    {
+        m_logDisplay->append(QString("Print streamed: %1 lines in %2 s (%3 lines/s)")
+                             .arg(lines).arg(seconds, 0, 'f', 1).arg(seconds > 0.0 ? lines / seconds : 0.0, 0, 'f', 0));
+    });
 }
 
 PrinterControlWidget::~PrinterControlWidget() = default;
@@ -79,6 +105,7 @@ void PrinterControlWidget::setupLayout(){
     QHBoxLayout *moveLayout = new QHBoxLayout;
     QHBoxLayout *statusLayout = new QHBoxLayout;
 
+    controlLayout->addWidget(m_addressInput);
     controlLayout->addWidget(m_enableButton);
     controlLayout->addWidget(m_disableButton);
     controlLayout->addWidget(m_loadButton);
@@ -108,6 +135,7 @@ void PrinterControlWidget::setupLayout(){
     mainLayout->addLayout(controlLayout);
     mainLayout->addLayout(moveLayout);
     mainLayout->addLayout(statusLayout);
+    mainLayout->addWidget(m_streamStatusLabel);
 
 
     // 添加按钮
@@ -150,44 +178,77 @@ void PrinterControlWidget::homePrinter()
 
 void PrinterControlWidget::startPrint()
 {
-    // 开始打印的逻辑
-    emit sendCommandToPrinter("M140 S60");  // 示例命令，设置床温
-    m_logDisplay->append("Starting print...");
+    if (m_gcodePath.isEmpty())
+    {
+        m_logDisplay->append("Load a g-code file before starting a print");
+        return;
+    }
+
+    m_communicator->streamFile(m_gcodePath);
+    m_logDisplay->append("Starting print: " + m_gcodePath);
 }
 void PrinterControlWidget::stopPrint()
 {
-    // 停止打印的逻辑
-    emit sendCommandToPrinter("M112");  // 停止所有动作的急停命令
+    // 急停命令必须绕过正在传输的文件
+    m_communicator->emergencyStop();
     m_logDisplay->append("Stopping print...");
 }
 
-void PrinterControlWidget::onPrinterResponse(const QString &response)
+void PrinterControlWidget::enablePrinter()
 {
-    m_logDisplay->append(response);  // 显示来自打印机的响应
+    m_logDisplay->append("Connecting to " + m_addressInput->text());
+    m_communicator->connectToPrinter(m_addressInput->text());
 }
 
-double PrinterControlWidget::getHardwareTemperature()
+void PrinterControlWidget::disablePrinter()
 {
-    // 模拟从硬件读取温度数据，实际应用中替换为真实的硬件接口
-    // 假设这里返回一个随机温度值，范围为20.0到80.0
-    return 20.0 + static_cast<double>(qrand() % 6000) / 100.0;  // 20.0 - 80.0 随机值
+    m_communicator->disconnectFromPrinter();
 }
 
+void PrinterControlWidget::loadPath()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Load G-Code", QString(), "G-Code (*.gcode *.nc *.mpf *.txt);;All Files (*)");
+    if (path.isEmpty())
+        return;
 
-void PrinterControlWidget::updateTemperature()
+    m_gcodePath = path;
+    m_logDisplay->append("Loaded path: " + path);
+}
+
+void PrinterControlWidget::onStatistics(double lines_per_second, double planner_occupancy, int in_flight, double progress, int starved_count)
 {
-    // 从硬件获取当前温度
-    double currentTemperature = getHardwareTemperature();
+    QString planner = planner_occupancy < 0.0 ? QString("n/a") : QString("%1%").arg(planner_occupancy * 100.0, 0, 'f', 0);
+    m_streamStatusLabel->setText(QString("%1 lines/s | planner %2 | in flight %3 | %4% sent | starved %5")
+                                 .arg(lines_per_second, 0, 'f', 0).arg(planner).arg(in_flight)
+                                 .arg(progress * 100.0, 0, 'f', 1).arg(starved_count));
+}
+
+void PrinterControlWidget::onPrinterResponse(const QString &response)
+{
+    // 温度报告: "T:210.0 /210.0 B:60.0 /60.0 T1:..."
+    static const QRegularExpression temperature_pattern("(T\\d?|B|C):\\s*(-?\\d+\\.?\\d*)");
+    if (response.contains("T:"))
+    {
+        QList<QLabel*> labels = {m_tempLabel1, m_tempLabel2, m_tempLabel3, m_tempLabel4};
+        int label = 0;
+        QRegularExpressionMatchIterator it = temperature_pattern.globalMatch(response);
+        while (it.hasNext() && label < labels.size())
+        {
+            QRegularExpressionMatch match = it.next();
+            labels[label++]->setText(QString("%1: %2 °C").arg(match.captured(1), match.captured(2)));
+        }
+        return;
+    }
 
-    // 更新标签上的显示文本
-    m_tempLabel1->setText(QString("Temperature: %1 °C").arg(currentTemperature, 0, 'f', 2));
-    m_tempLabel2->setText(QString("Temperature: %1 °C").arg(currentTemperature, 0, 'f', 2));
-    m_tempLabel3->setText(QString("Temperature: %1 °C").arg(currentTemperature, 0, 'f', 2));
-    m_tempLabel4->setText(QString("Temperature: %1 °C").arg(currentTemperature, 0, 'f', 2));
+    m_logDisplay->append(response);  // 显示来自打印机的响应
+}
 
 
-    // 输出到调试窗口
-    qDebug() << "Updated temperature: " << currentTemperature;
+void PrinterControlWidget::updateTemperature()
+{
+    // 连接后定时查询温度，结果在 onPrinterResponse 中解析
+    if (m_connected)
+        emit sendCommandToPrinter("M105");
 }
 
 
@@ -0,0 +1,396 @@
+#include "widgets/gcode_text_view.h"
+
+#include <QtWidgets>
+#include <algorithm>
+#include <cmath>
+
+namespace ORNL
+{
+    GcodeTextView::GcodeTextView(QWidget* parent)
+        : QAbstractScrollArea(parent)
+        , m_cursor_line(0)
+        , m_press_line(0)
+        , m_last_line_clicked_on(0)
+        , m_manual_cursor_move(false)
+        , m_cursor_index(0)
+    {
+        setFocusPolicy(Qt::StrongFocus);
+        viewport()->setCursor(Qt::IBeamCursor);
+        updateScrollBars();
+    }
+
+    void GcodeTextView::setContents(const GcodeTextIndex& text)
+    {
+        m_text = text;
+        m_cursor_line = 0;
+        m_press_line = 0;
+        m_last_line_clicked_on = 0;
+        m_selected_lines.clear();
+        m_matched_lines.clear();
+        m_search_string.clear();
+        m_cursor_index = 0;
+
+        updateScrollBars();
+        verticalScrollBar()->setValue(0);
+        horizontalScrollBar()->setValue(0);
+        viewport()->update();
+    }
+
+    void GcodeTextView::clear()
+    {
+        setContents(GcodeTextIndex());
+    }
+
+    const GcodeTextIndex& GcodeTextView::contents() const
+    {
+        return m_text;
+    }
+
+    void GcodeTextView::highlightLine(QList<int> linesToAdd, QList<int> linesToRemove, bool shouldCenter)
+    {
+        for(int line_num : linesToAdd)
+        {
+            if(line_num < 0 || line_num >= m_text.lineCount())
+                continue;
+
+            m_selected_lines.insert(line_num);
+            m_cursor_line = line_num;
+            if(shouldCenter)
+                verticalScrollBar()->setValue(line_num - visibleLineCount() / 2);
+            else
+                ensureLineVisible(line_num);
+        }
+
+        for(int line_num : linesToRemove)
+            m_selected_lines.remove(line_num);
+
+        viewport()->update();
+    }
+
+    void GcodeTextView::resetHighlight()
+    {
+        m_selected_lines.clear();
+        viewport()->update();
+    }
+
+    void GcodeTextView::setLayerFirstLineNumbers(QList<int>& firstLineNumbers)
+    {
+        m_layer_first_line_numbers = firstLineNumbers;
+    }
+
+    void GcodeTextView::moveCursorToLine(int line_number)
+    {
+        if(m_text.isEmpty())
+            return;
+
+        int line = std::max(0, std::min(line_number - 1, m_text.lineCount() - 1));
+
+        //an automatic move places the line on top, a manual one only keeps it visible
+        if(!m_manual_cursor_move)
+            verticalScrollBar()->setValue(line);
+        else
+            ensureLineVisible(line);
+
+        m_cursor_line = line;
+        m_manual_cursor_move = false;
+        viewport()->update();
+    }
+
+    bool GcodeTextView::getCursorManualMove()
+    {
+        return m_manual_cursor_move;
+    }
+
+    void GcodeTextView::setCursorManualMoveFalse()
+    {
+        m_manual_cursor_move = false;
+    }
+
+    void GcodeTextView::search(QString searchString, int searchCount)
+    {
+        bool repeatedSearch = searchString.size() > 0 && m_search_string.compare(searchString) == 0;
+
+        if(repeatedSearch && searchCount > 0)
+        {
+            //move the focus to the next match, wrapping around at EOF
+            ++m_cursor_index;
+            if(m_cursor_index < m_matched_lines.size())
+            {
+                int lineNum = m_matched_lines[m_cursor_index];
+                m_manual_cursor_move = isLineVisible(lineNum);
+                moveCursorToLine(lineNum + 1);
+            }
+            else
+            {
+                m_cursor_index = 0;
+            }
+        }
+        else
+        {
+            m_cursor_index = 0;
+        }
+
+        //matches only change with the search string, repeated searches reuse them
+        if(!repeatedSearch)
+        {
+            m_search_string = searchString;
+            m_matched_lines = m_text.findLines(searchString);
+        }
+
+        //leap to the first match for a fresh search if it is not currently visible
+        if(!m_matched_lines.isEmpty() && m_cursor_index == 0 && !isLineVisible(m_matched_lines.first()))
+            moveCursorToLine(m_matched_lines.first() + 1);
+
+        viewport()->update();
+    }
+
+    void GcodeTextView::paintEvent(QPaintEvent* event)
+    {
+        QPainter painter(viewport());
+        const QFontMetrics metrics = fontMetrics();
+        const int line_height = metrics.lineSpacing();
+        const int gutter = gutterWidth();
+        const int text_x = gutter + 4 - horizontalScrollBar()->value();
+        const int width = viewport()->width();
+        const QRect area = event->rect();
+
+        painter.fillRect(area, palette().base());
+
+        const int first_line = verticalScrollBar()->value();
+        const int begin = first_line + std::max(0, area.top()) / line_height;
+        const int end = std::min(m_text.lineCount(), first_line + area.bottom() / line_height + 1);
+
+        const QVector<QColor>& colors = m_text.palette();
+        const QColor text_color = palette().text().color();
+        const int focused_line = (m_cursor_index < m_matched_lines.size()) ? m_matched_lines[m_cursor_index] : -1;
+
+        painter.setClipRect(gutter, 0, width - gutter, viewport()->height());
+        for(int line = begin; line < end; ++line)
+        {
+            const int top = (line - first_line) * line_height;
+            const QString text = m_text.line(line);
+
+            if(m_selected_lines.contains(line))
+                painter.fillRect(QRect(gutter, top, width - gutter, line_height), QColor(Qt::yellow));
+
+            //set background color so that the matches can also be visible in colored lines
+            if(std::binary_search(m_matched_lines.begin(), m_matched_lines.end(), line))
+            {
+                QColor match_color = (line == focused_line) ? QColor(255, 100, 0) : QColor(255, 240, 0);
+                for(int pos = text.indexOf(m_search_string, 0, Qt::CaseInsensitive); pos >= 0;
+                    pos = text.indexOf(m_search_string, pos + m_search_string.size(), Qt::CaseInsensitive))
+                {
+                    int x = text_x + metrics.width(text.left(pos));
+                    painter.fillRect(QRect(x, top, metrics.width(text.mid(pos, m_search_string.size())), line_height), match_color);
+                }
+            }
+
+            if(line == m_cursor_line && hasFocus())
+            {
+                painter.setPen(palette().highlight().color());
+                painter.drawRect(QRect(gutter, top, width - gutter - 1, line_height - 1));
+            }
+
+            int color_index = m_text.lineColorIndex(line);
+            painter.setPen(color_index > 0 ? colors[color_index] : text_color);
+            painter.drawText(text_x, top + metrics.ascent(), text);
+        }
+        painter.setClipping(false);
+
+        //line numbers
+        painter.fillRect(QRect(0, area.top(), gutter, area.height()), QColor(255, 255, 255, 100));
+        painter.setPen(Qt::black);
+        for(int line = begin; line < end; ++line)
+        {
+            const int top = (line - first_line) * line_height;
+            painter.drawText(0, top, gutter - 5, line_height, Qt::AlignCenter, QString::number(line + 1));
+        }
+    }
+
+    void GcodeTextView::resizeEvent(QResizeEvent* event)
+    {
+        QAbstractScrollArea::resizeEvent(event);
+        updateScrollBars();
+    }
+
+    void GcodeTextView::scrollContentsBy(int dx, int dy)
+    {
+        Q_UNUSED(dx);
+        Q_UNUSED(dy);
+        viewport()->update();
+    }
+
+    void GcodeTextView::mousePressEvent(QMouseEvent* event)
+    {
+        if(event->button() != Qt::LeftButton || m_text.isEmpty())
+            return;
+
+        m_press_line = lineAt(event->pos().y());
+        m_cursor_line = m_press_line;
+        viewport()->update();
+    }
+
+    void GcodeTextView::mouseReleaseEvent(QMouseEvent* event)
+    {
+        if(event->button() != Qt::LeftButton || m_text.isEmpty())
+            return;
+
+        m_manual_cursor_move = true;
+        int line = lineAt(event->pos().y());
+        m_cursor_line = line;
+
+        QList<int> linesToAdd, linesToRemove;
+        Qt::KeyboardModifiers modifier = QGuiApplication::queryKeyboardModifiers();
+        if(modifier == Qt::ControlModifier)
+        {
+            if(m_selected_lines.contains(line))
+                linesToRemove.push_back(line);
+            else
+                linesToAdd.push_back(line);
+
+            m_last_line_clicked_on = line;
+        }
+        else if(modifier == Qt::ShiftModifier)
+        {
+            int first = std::min(m_last_line_clicked_on, line);
+            int last = std::max(m_last_line_clicked_on, line);
+
+            for(int i = first; i < last; ++i)
+            {
+                if(!m_selected_lines.contains(i))
+                    linesToAdd.push_back(i);
+            }
+            for(int key : m_selected_lines.values())
+            {
+                if(key < first || key > last)
+                    linesToRemove.push_back(key);
+            }
+        }
+        else
+        {
+            //dragging across lines selects all of them
+            if(m_press_line != line)
+            {
+                for(int i = std::min(m_press_line, line), end = std::max(m_press_line, line); i <= end; ++i)
+                {
+                    if(!m_selected_lines.contains(i))
+                        linesToAdd.push_back(i);
+                }
+            }
+            else
+            {
+                linesToRemove = m_selected_lines.values();
+                linesToAdd.push_back(line);
+            }
+            m_last_line_clicked_on = line;
+        }
+
+        int scrollPos = verticalScrollBar()->value();
+        emit lineChange(linesToAdd, linesToRemove);
+        verticalScrollBar()->setValue(scrollPos);
+        viewport()->update();
+    }
+
+    void GcodeTextView::keyPressEvent(QKeyEvent* event)
+    {
+        if(m_text.isEmpty())
+        {
+            QAbstractScrollArea::keyPressEvent(event);
+            return;
+        }
+
+        if(event->key() == Qt::Key_Up || event->key() == Qt::Key_Down)
+        {
+            QList<int> linesToAdd, linesToRemove;
+            linesToRemove = m_selected_lines.values();
+
+            m_manual_cursor_move = true;
+            int lineId = m_cursor_line + (event->key() == Qt::Key_Up ? -1 : 1);
+            lineId = std::max(0, std::min(lineId, m_text.lineCount() - 1));
+
+            linesToAdd.push_back(lineId);
+            emit lineChange(linesToAdd, linesToRemove);
+
+            //signal lineChange moves the cursor to highlightable lines, but not to most non-highlightable lines
+            m_cursor_line = lineId;
+            ensureLineVisible(lineId);
+            viewport()->update();
+        }
+        else if(event->key() == Qt::Key_PageUp || event->key() == Qt::Key_PageDown)
+        {
+            int step = (event->key() == Qt::Key_PageUp) ? -visibleLineCount() : visibleLineCount();
+            m_cursor_line = std::max(0, std::min(m_cursor_line + step, m_text.lineCount() - 1));
+            verticalScrollBar()->setValue(verticalScrollBar()->value() + step);
+            viewport()->update();
+        }
+        else if((event->key() == Qt::Key_Home || event->key() == Qt::Key_End) && event->modifiers() & Qt::ControlModifier)
+        {
+            m_cursor_line = (event->key() == Qt::Key_Home) ? 0 : m_text.lineCount() - 1;
+            ensureLineVisible(m_cursor_line);
+            viewport()->update();
+        }
+        else if(event->matches(QKeySequence::Copy))
+        {
+            QList<int> lines = m_selected_lines.values();
+            if(lines.isEmpty())
+                lines.push_back(m_cursor_line);
+            std::sort(lines.begin(), lines.end());
+
+            QStringList text;
+            for(int line : lines)
+                text.push_back(m_text.line(line));
+            QGuiApplication::clipboard()->setText(text.join("\n"));
+        }
+        else
+        {
+            QAbstractScrollArea::keyPressEvent(event);
+        }
+    }
+
+    int GcodeTextView::lineAt(int y) const
+    {
+        int line = verticalScrollBar()->value() + std::max(0, y) / fontMetrics().lineSpacing();
+        return std::max(0, std::min(line, m_text.lineCount() - 1));
+    }
+
+    int GcodeTextView::visibleLineCount() const
+    {
+        return std::max(1, viewport()->height() / fontMetrics().lineSpacing());
+    }
+
+    int GcodeTextView::gutterWidth() const
+    {
+        return 3 + fontMetrics().width(QLatin1Char('9')) *
+               ceil(log10(std::max< int >(2, m_text.lineCount())) + 1);
+    }
+
+    void GcodeTextView::updateScrollBars()
+    {
+        const int visible = visibleLineCount();
+        verticalScrollBar()->setRange(0, std::max(0, m_text.lineCount() - visible));
+        verticalScrollBar()->setPageStep(visible);
+        verticalScrollBar()->setSingleStep(1);
+
+        //lines are only measured when painted, so estimate the widest from its length
+        const int text_width = m_text.maxLineLength() * fontMetrics().averageCharWidth() + gutterWidth() + 8;
+        horizontalScrollBar()->setRange(0, std::max(0, text_width - viewport()->width()));
+        horizontalScrollBar()->setPageStep(viewport()->width());
+        horizontalScrollBar()->setSingleStep(fontMetrics().averageCharWidth());
+    }
+
+    void GcodeTextView::ensureLineVisible(int line)
+    {
+        int first = verticalScrollBar()->value();
+        int visible = visibleLineCount();
+        if(line < first)
+            verticalScrollBar()->setValue(line);
+        else if(line >= first + visible)
+            verticalScrollBar()->setValue(line - visible + 1);
+    }
+
+    bool GcodeTextView::isLineVisible(int line) const
+    {
+        int first = verticalScrollBar()->value();
+        return line >= first && line < first + visibleLineCount();
+    }
+}  // namespace ORNL
@@ -25,6 +25,10 @@ namespace ORNL {
         m_gcode_view->addGCode(gcode);
     }
 
+    void GCodeWidget::setLayerKeys(QVector<QByteArray> keys) {
+        m_gcode_view->setLayerKeys(keys);
+    }
+
     void GCodeWidget::clear() {
         m_gcode_view->clear();
     }
@@ -6,21 +6,38 @@
 #include "managers/preferences_manager.h"
 
 namespace ORNL {
-    GcodeBar::GcodeBar(QWidget *parent) : QWidget(parent) {
+    GcodeBar::GcodeBar(QWidget *parent) : QWidget(parent), m_use_large_view(false) {
         this->setupWidget();
         m_lock_distance = 0;
     }
 
-    void GcodeBar::updateGcodeText(QString text, QHash<QString, QTextCharFormat> fontColors, QList<int> layerFirstLineNumbers, QSet<int> layerSkipLineNumbers)
+    void GcodeBar::updateGcodeText(GcodeTextIndex text, QList<int> layerFirstLineNumbers)
     {
-        //new gcode so reset any previous highlight, forward along the font colors first, then add text
-        //it is necessary to forward font colors first as the highlighter overrides font colors as text is added
-        //so it must know which colors to set before adding text
-        m_view->resetHighlight();
-        m_view->setHighlighterColors(fontColors, layerSkipLineNumbers);
-        m_view->setPlainText(text);
         m_layer_first_line_numbers = layerFirstLineNumbers;
-        m_view->setLayerFirstLineNumbers(m_layer_first_line_numbers);
+        m_use_large_view = text.lineCount() > kMaxEditableLines;
+
+        m_view->resetHighlight();
+        m_large_view->resetHighlight();
+        if(m_use_large_view)
+        {
+            //only the visible lines are materialized, the program cannot be edited
+            m_view->setHighlighterColors(GcodeTextIndex());
+            m_view->setPlainText("");
+            m_large_view->setContents(text);
+            m_large_view->setLayerFirstLineNumbers(m_layer_first_line_numbers);
+            m_view_stack->setCurrentWidget(m_large_view);
+        }
+        else
+        {
+            //new gcode so reset any previous highlight, forward along the font colors first, then add text
+            //it is necessary to forward font colors first as the highlighter overrides font colors as text is added
+            //so it must know which colors to set before adding text
+            m_large_view->clear();
+            m_view->setHighlighterColors(text);
+            m_view->setPlainText(text.text());
+            m_view->setLayerFirstLineNumbers(m_layer_first_line_numbers);
+            m_view_stack->setCurrentWidget(m_view);
+        }
         m_refresh_btn->setEnabled(false);
 
         //preserve the last search. No harm if search string is empty
@@ -31,7 +48,12 @@ namespace ORNL {
     void GcodeBar::clear()
     {
         m_view->resetHighlight();
+        m_view->setHighlighterColors(GcodeTextIndex());
         m_view->setPlainText("");
+        //releases the mapped program, so the slicer can write it again
+        m_large_view->clear();
+        m_view_stack->setCurrentWidget(m_view);
+        m_use_large_view = false;
         m_refresh_btn->setEnabled(false);
 
         updateLowerSpin(0);
@@ -225,9 +247,13 @@ namespace ORNL {
     void GcodeBar::moveToLayer(int layerNo)
     {
         //if moveToLayer() is called by either clicking a visible line or an up/down arrow, do not move the line to the top
-        if(!m_view->getCursorManualMove() && layerNo >= 0 && layerNo < m_layer_first_line_numbers.size())
+        bool manual_move = m_use_large_view ? m_large_view->getCursorManualMove() : m_view->getCursorManualMove();
+        if(!manual_move && layerNo >= 0 && layerNo < m_layer_first_line_numbers.size())
         {
-            m_view->moveCursorToLine(m_layer_first_line_numbers.at(layerNo));
+            if(m_use_large_view)
+                m_large_view->moveCursorToLine(m_layer_first_line_numbers.at(layerNo));
+            else
+                m_view->moveCursorToLine(m_layer_first_line_numbers.at(layerNo));
         }
     }
 
@@ -259,7 +285,10 @@ namespace ORNL {
 
     void GcodeBar::setLineNumber(QList<int> linesToAdd, QList<int> linesToRemove, bool shouldCenter)
     {
-        m_view->highlightLine(linesToAdd, linesToRemove, shouldCenter);
+        if(m_use_large_view)
+            m_large_view->highlightLine(linesToAdd, linesToRemove, shouldCenter);
+        else
+            m_view->highlightLine(linesToAdd, linesToRemove, shouldCenter);
     }
 
     void GcodeBar::setupWidget() {
@@ -294,6 +323,12 @@ namespace ORNL {
 
         // Main View
         m_view = new GcodeTextBoxWidget(this);
+        m_large_view = new GcodeTextView(this);
+        m_large_view->setFont(m_view->font());
+
+        m_view_stack = new QStackedWidget(this);
+        m_view_stack->addWidget(m_view);
+        m_view_stack->addWidget(m_large_view);
 
         // View Selection
         m_view_sel = new QComboBox(this);
@@ -384,7 +419,7 @@ namespace ORNL {
 
         m_layout->addWidget(m_search_separator, 1, 0, 1, 5);
 
-        m_layout->addWidget(m_view, 2, 0, 1, 5);
+        m_layout->addWidget(m_view_stack, 2, 0, 1, 5);
 
         m_layout->addWidget(m_view_sel, 3, 0, 1, 5);
 
@@ -433,6 +468,7 @@ namespace ORNL {
         connect(m_layer_play_btn, &QPushButton::clicked, this, &GcodeBar::updatePlayButton);
         connect(m_segment_play_btn, &QPushButton::clicked, this, &GcodeBar::updateSegmentPlayButton);
         connect(m_view, &GcodeTextBoxWidget::lineChange, this, &GcodeBar::forwardLineChange);
+        connect(m_large_view, &GcodeTextView::lineChange, this, &GcodeBar::forwardLineChange);
         connect(m_view, &QPlainTextEdit::modificationChanged, this, &GcodeBar::updateRefreshButton);
 
         connect(m_hide_travel, &QCheckBox::clicked,
@@ -476,7 +512,10 @@ namespace ORNL {
         m_search_only_change = true;
         QString searchString = m_search_bar->text().trimmed();
         //perform search even if search string is empty - otherwise highlights from the previous search stay
-        m_view->search(searchString, m_search_count);
+        if(m_use_large_view)
+            m_large_view->search(searchString, m_search_count);
+        else
+            m_view->search(searchString, m_search_count);
         m_search_only_change = false;
         ++m_search_count;
 
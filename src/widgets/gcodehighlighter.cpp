@@ -6,16 +6,26 @@ namespace ORNL
         : QSyntaxHighlighter(parent)
     {}
 
-    void GcodeHighlighter::setColorRules(QHash<QString, QTextCharFormat> colorHash, QSet<int> layerSkipLineNumbers)
+    void GcodeHighlighter::setColorRules(const GcodeTextIndex& lineColors)
     {
-        m_color_hash = colorHash;
-        m_layer_skip_numbers = layerSkipLineNumbers;
+        //the document holds the text, only the colors are kept
+        m_line_colors = lineColors.colorsOnly();
+
+        m_formats.clear();
+        for(const QColor& color : m_line_colors.palette())
+        {
+            QTextCharFormat format;
+            if(color.isValid())
+                format.setForeground(color);
+            m_formats.push_back(format);
+        }
     }
 
     void GcodeHighlighter::highlightBlock(const QString& text)
     {
-        if(!m_layer_skip_numbers.contains(this->currentBlock().blockNumber()))
-            setFormat(0, text.length(), m_color_hash[text]);
+        int index = m_line_colors.lineColorIndex(this->currentBlock().blockNumber());
+        if(index > 0)
+            setFormat(0, text.length(), m_formats[index]);
     }
 
 }  // namespace ORNL
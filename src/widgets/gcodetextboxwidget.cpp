@@ -27,9 +27,9 @@ namespace ORNL
         m_manual_cursor_move = false;
     }
 
-    void GcodeTextBoxWidget::setHighlighterColors(QHash<QString, QTextCharFormat> fontColors, QSet<int> layerSkipLineNumbers)
+    void GcodeTextBoxWidget::setHighlighterColors(const GcodeTextIndex& lineColors)
     {
-        m_highlighter.setColorRules(fontColors, layerSkipLineNumbers);
+        m_highlighter.setColorRules(lineColors);
     }
 
     void GcodeTextBoxWidget::lineNumbersPaintEvent(QPaintEvent* event)
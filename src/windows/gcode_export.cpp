@@ -17,6 +17,7 @@
 #include "threading/gcode_aml3d_saver.h"
 #include "threading/gcode_sandia_saver.h"
 #include "threading/gcode_marlin_saver.h"
+#include "external_files/toolpath_format.h"
 
 namespace ORNL
 {
@@ -249,6 +250,27 @@ namespace ORNL
                 }
 
 
+                QFileInfo toolpath_info(QFileInfo(m_location).absoluteDir().absoluteFilePath("toolpath" % ToolpathFormat::kFileSuffix));
+                if (toolpath_info.exists())
+                {
+                    QString output_loc = filepath % '/' % partName % ToolpathFormat::kFileSuffix;
+
+                    bool copy = true;
+                    if (QFile::exists(output_loc))
+                    {
+                        QMessageBox::StandardButton reply = QMessageBox::question(
+                                    this, "Warning", "Binary toolpath file already exists.  Do you wish to overwrite?", QMessageBox::Yes | QMessageBox::No);
+
+                        copy = reply == QMessageBox::Yes;
+                    }
+
+                    if (copy)
+                    {
+                        QFile::remove(output_loc);
+                        QFile::copy(toolpath_info.absoluteFilePath(), output_loc);
+                    }
+                }
+
                 if (CSM->spiralVisualizationFilesGenerated())
                 {
                     QFileInfo fi(m_location);
@@ -273,7 +295,7 @@ namespace ORNL
 
                         if (copy)
                         {
-                            QDirIterator file_itr(dir.absolutePath(), QStringList() << "*.dat", QDir::Files);
+                            QDirIterator file_itr(dir.absolutePath(), QStringList() << "*.dat" << "*" + ToolpathFormat::kFileSuffix, QDir::Files);
                             while (file_itr.hasNext())
                             {
                                 file_itr.next();
@@ -1236,6 +1236,7 @@ namespace ORNL {
 
         GCodeLoader* loader = new GCodeLoader(filepath, alterFile);
         connect(loader, &GCodeLoader::finished, loader, &GCodeLoader::deleteLater);
+        connect(loader, &GCodeLoader::gcodeLoadedLayerKeys, m_gcode_widget, &GCodeWidget::setLayerKeys);
         connect(loader, &GCodeLoader::gcodeLoadedVisualization, m_gcode_widget, &GCodeWidget::addGCode);
         connect(loader, &GCodeLoader::gcodeLoadedText, m_gcodebar, &GcodeBar::updateGcodeText);
 